@@ -501,6 +501,15 @@ function(pika_check_for_cxx20_paren_initialization_of_aggregates)
   )
 endfunction()
 
+# ##############################################################################
+function(pika_check_for_cxx20_std_atomic_wait)
+  pika_add_config_test(
+    PIKA_WITH_CXX20_STD_ATOMIC_WAIT
+    SOURCE cmake/tests/cxx20_std_atomic_wait.cpp
+    FILE ${ARGN} CHECK_CXXSTD 20
+  )
+endfunction()
+
 # ##############################################################################
 function(pika_check_for_cxx20_std_disable_sized_sentinel_for)
   pika_add_config_test(
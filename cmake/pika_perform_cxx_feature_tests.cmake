@@ -86,6 +86,10 @@ function(pika_perform_cxx_feature_tests)
     DEFINITIONS PIKA_HAVE_CXX20_PAREN_INITIALIZATION_OF_AGGREGATES
   )
 
+  pika_check_for_cxx20_std_atomic_wait(
+    DEFINITIONS PIKA_HAVE_CXX20_STD_ATOMIC_WAIT
+  )
+
   pika_check_for_cxx20_std_disable_sized_sentinel_for(
     DEFINITIONS PIKA_HAVE_CXX20_STD_DISABLE_SIZED_SENTINEL_FOR
   )
@@ -0,0 +1,17 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+
+int main()
+{
+    std::atomic<int> a(1);
+    a.wait(0, std::memory_order_acquire);
+    a.notify_one();
+    a.notify_all();
+
+    return 0;
+}
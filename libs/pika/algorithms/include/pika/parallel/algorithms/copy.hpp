@@ -204,6 +204,7 @@ namespace pika {
 #include <pika/assert.hpp>
 #include <pika/concepts/concepts.hpp>
 #include <pika/functional/invoke.hpp>
+#include <pika/iterator_support/counting_iterator.hpp>
 #include <pika/iterator_support/traits/is_iterator.hpp>
 #include <pika/parallel/util/detail/sender_util.hpp>
 
@@ -214,6 +215,7 @@ namespace pika {
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/distance.hpp>
 #include <pika/parallel/algorithms/detail/transfer.hpp>
+#include <pika/parallel/util/compaction_mask.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/foreach_partitioner.hpp>
 #include <pika/parallel/util/loop.hpp>
@@ -224,10 +226,6 @@ namespace pika {
 #include <pika/parallel/util/zip_iterator.hpp>
 #include <pika/type_support/unused.hpp>
 
-#if !defined(PIKA_HAVE_CXX17_SHARED_PTR_ARRAY)
-#include <boost/shared_array.hpp>
-#endif
-
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
@@ -448,7 +446,8 @@ namespace pika { namespace parallel { inline namespace v1 {
             parallel(ExPolicy&& policy, FwdIter1 first, FwdIter2 last,
                 FwdIter3 dest, Pred&& pred, Proj&& proj /* = Proj()*/)
             {
-                typedef pika::util::zip_iterator<FwdIter1, bool*> zip_iterator;
+                using zip_iterator = pika::util::zip_iterator<FwdIter1,
+                    pika::util::counting_iterator<std::size_t>>;
                 typedef util::detail::algorithm_result<ExPolicy,
                     util::in_out_result<FwdIter1, FwdIter3>>
                     result;
@@ -463,56 +462,51 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 difference_type count = detail::distance(first, last);
 
-#if defined(PIKA_HAVE_CXX17_SHARED_PTR_ARRAY)
-                std::shared_ptr<bool[]> flags(new bool[count]);
-#else
-                boost::shared_array<bool> flags(new bool[count]);
-#endif
+                util::compaction_mask mask(count);
                 std::size_t init = 0;
 
                 using pika::get;
                 using pika::util::make_zip_iterator;
                 typedef util::scan_partitioner<ExPolicy,
-                    util::in_out_result<FwdIter1, FwdIter3>, std::size_t>
+                    util::in_out_result<FwdIter1, FwdIter3>, std::size_t, void,
+                    util::scan_partitioner_single_pass_tag>
                     scan_partitioner_type;
 
-                auto f1 = [pred = PIKA_FORWARD(Pred, pred),
+                // Every partition marks the elements to copy in the mask and
+                // copies them right away once the number of elements copied
+                // by the preceding partitions is known.
+                auto f1 = [mask, pred = PIKA_FORWARD(Pred, pred),
                               proj = PIKA_FORWARD(decltype(proj), proj)](
                               zip_iterator part_begin,
                               std::size_t part_size) -> std::size_t {
-                    std::size_t curr = 0;
+                    FwdIter1 it = get<0>(part_begin.get_iterator_tuple());
 
                     // Note: replacing the invoke() with PIKA_INVOKE()
                     // below makes gcc generate errors
-
-                    // MSVC complains if proj is captured by ref below
-                    util::loop_n<std::decay_t<ExPolicy>>(part_begin, part_size,
-                        [&pred, proj, &curr](zip_iterator it) mutable -> void {
-                            bool f = pika::util::invoke(
-                                pred, pika::util::invoke(proj, get<0>(*it)));
-
-                            if ((get<1>(*it) = f))
-                                ++curr;
+                    return mask.set(*get<1>(part_begin.get_iterator_tuple()),
+                        part_size, [&]() -> bool {
+                            return pika::util::invoke(
+                                pred, pika::util::invoke(proj, *it++));
                         });
-
-                    return curr;
                 };
-                auto f3 = [dest, flags](zip_iterator part_begin,
-                              std::size_t part_size, std::size_t val) mutable {
-                    PIKA_UNUSED(flags);
-                    std::advance(dest, val);
-                    util::loop_n<std::decay_t<ExPolicy>>(part_begin, part_size,
-                        [&dest](zip_iterator it) mutable {
-                            if (get<1>(*it))
-                                *dest++ = get<0>(*it);
+                auto f3 = [dest, mask](zip_iterator part_begin,
+                              std::size_t part_size, std::size_t val) {
+                    FwdIter1 it = get<0>(part_begin.get_iterator_tuple());
+                    std::size_t pos = 0;
+
+                    FwdIter3 out = dest;
+                    std::advance(out, val);
+                    mask.for_each_set(*get<1>(part_begin.get_iterator_tuple()),
+                        part_size, [&](std::size_t i) {
+                            std::advance(it, i - pos);
+                            pos = i;
+                            *out++ = *it;
                         });
                 };
 
-                auto f4 = [first, dest, flags](std::vector<std::size_t>&& items,
+                auto f4 = [first, dest](std::vector<std::size_t>&& items,
                               std::vector<pika::future<void>>&& data) mutable
                     -> util::in_out_result<FwdIter1, FwdIter3> {
-                    PIKA_UNUSED(flags);
-
                     auto dist = items.back();
                     std::advance(first, dist);
                     std::advance(dest, dist);
@@ -527,7 +521,9 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 return scan_partitioner_type::call(
                     PIKA_FORWARD(ExPolicy, policy),
-                    make_zip_iterator(first, flags.get()), count, init,
+                    make_zip_iterator(first,
+                        pika::util::make_counting_iterator(std::size_t(0))),
+                    count, init,
                     // step 1 performs first part of scan algorithm
                     PIKA_MOVE(f1),
                     // step 2 propagates the partition results from left
@@ -0,0 +1,179 @@
+//  Copyright (c) 2014-2017 Hartmut Kaiser
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// make inspect happy: pikainspect:nominmax
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/algorithms/traits/is_value_proxy.hpp>
+#include <pika/functional/detail/tag_fallback_invoke.hpp>
+#include <pika/functional/invoke.hpp>
+#include <pika/parallel/util/result_types.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Finds the first smallest element of [it, it + count). Vectorizing
+    // execution policies provide their own implementation (see
+    // datapar/minmax.hpp).
+    template <typename ExPolicy>
+    struct sequential_min_element_t
+      : pika::functional::detail::tag_fallback<
+            sequential_min_element_t<ExPolicy>>
+    {
+    private:
+        template <typename FwdIter, typename F, typename Proj>
+        friend constexpr FwdIter tag_fallback_invoke(
+            sequential_min_element_t<ExPolicy>, FwdIter it, std::size_t count,
+            F const& f, Proj const& proj)
+        {
+            if (count == 0 || count == 1)
+                return it;
+
+            using element_type = pika::traits::proxy_value_t<
+                typename std::iterator_traits<FwdIter>::value_type>;
+
+            auto smallest = it;
+
+            element_type value = PIKA_INVOKE(proj, *smallest);
+            for (++it; --count != 0; ++it)
+            {
+                element_type curr_value = PIKA_INVOKE(proj, *it);
+                if (PIKA_INVOKE(f, curr_value, value))
+                {
+                    smallest = it;
+                    value = PIKA_MOVE(curr_value);
+                }
+            }
+
+            return smallest;
+        }
+    };
+
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+    template <typename ExPolicy>
+    inline constexpr sequential_min_element_t<ExPolicy>
+        sequential_min_element = sequential_min_element_t<ExPolicy>{};
+#else
+    template <typename ExPolicy, typename... Ts>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE auto sequential_min_element(Ts&&... ts)
+    {
+        return sequential_min_element_t<ExPolicy>{}(PIKA_FORWARD(Ts, ts)...);
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Finds the last largest element of [it, it + count)
+    template <typename ExPolicy>
+    struct sequential_max_element_t
+      : pika::functional::detail::tag_fallback<
+            sequential_max_element_t<ExPolicy>>
+    {
+    private:
+        template <typename FwdIter, typename F, typename Proj>
+        friend constexpr FwdIter tag_fallback_invoke(
+            sequential_max_element_t<ExPolicy>, FwdIter it, std::size_t count,
+            F const& f, Proj const& proj)
+        {
+            if (count == 0 || count == 1)
+                return it;
+
+            using element_type = pika::traits::proxy_value_t<
+                typename std::iterator_traits<FwdIter>::value_type>;
+
+            auto largest = it;
+
+            element_type value = PIKA_INVOKE(proj, *largest);
+            for (++it; --count != 0; ++it)
+            {
+                element_type curr_value = PIKA_INVOKE(proj, *it);
+                if (!PIKA_INVOKE(f, curr_value, value))
+                {
+                    largest = it;
+                    value = PIKA_MOVE(curr_value);
+                }
+            }
+
+            return largest;
+        }
+    };
+
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+    template <typename ExPolicy>
+    inline constexpr sequential_max_element_t<ExPolicy>
+        sequential_max_element = sequential_max_element_t<ExPolicy>{};
+#else
+    template <typename ExPolicy, typename... Ts>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE auto sequential_max_element(Ts&&... ts)
+    {
+        return sequential_max_element_t<ExPolicy>{}(PIKA_FORWARD(Ts, ts)...);
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Finds the first smallest and the last largest element of
+    // [it, it + count)
+    template <typename ExPolicy>
+    struct sequential_minmax_element_t
+      : pika::functional::detail::tag_fallback<
+            sequential_minmax_element_t<ExPolicy>>
+    {
+    private:
+        template <typename FwdIter, typename F, typename Proj>
+        friend constexpr util::min_max_result<FwdIter> tag_fallback_invoke(
+            sequential_minmax_element_t<ExPolicy>, FwdIter it,
+            std::size_t count, F const& f, Proj const& proj)
+        {
+            util::min_max_result<FwdIter> result = {it, it};
+
+            if (count == 0 || count == 1)
+                return result;
+
+            using element_type = pika::traits::proxy_value_t<
+                typename std::iterator_traits<FwdIter>::value_type>;
+
+            element_type min_value = PIKA_INVOKE(proj, *it);
+            element_type max_value = min_value;
+            for (++it; --count != 0; ++it)
+            {
+                element_type curr_value = PIKA_INVOKE(proj, *it);
+                if (PIKA_INVOKE(f, curr_value, min_value))
+                {
+                    result.min = it;
+                    min_value = curr_value;
+                }
+
+                if (!PIKA_INVOKE(f, curr_value, max_value))
+                {
+                    result.max = it;
+                    max_value = PIKA_MOVE(curr_value);
+                }
+            }
+
+            return result;
+        }
+    };
+
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+    template <typename ExPolicy>
+    inline constexpr sequential_minmax_element_t<ExPolicy>
+        sequential_minmax_element = sequential_minmax_element_t<ExPolicy>{};
+#else
+    template <typename ExPolicy, typename... Ts>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE auto sequential_minmax_element(
+        Ts&&... ts)
+    {
+        return sequential_minmax_element_t<ExPolicy>{}(
+            PIKA_FORWARD(Ts, ts)...);
+    }
+#endif
+}}}}    // namespace pika::parallel::v1::detail
@@ -0,0 +1,126 @@
+//  Copyright (c) 2007-2021 Hartmut Kaiser
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/functional/detail/tag_fallback_invoke.hpp>
+#include <pika/functional/invoke.hpp>
+#include <pika/iterator_support/zip_iterator.hpp>
+#include <pika/parallel/util/loop.hpp>
+#include <pika/parallel/util/result_types.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Finds the first position at which two sequences differ, used by
+    // mismatch and equal. Vectorizing execution policies provide their own
+    // implementation (see datapar/mismatch.hpp).
+    template <typename ExPolicy>
+    struct sequential_mismatch_t
+      : pika::functional::detail::tag_fallback<sequential_mismatch_t<ExPolicy>>
+    {
+    private:
+        // [first1, last1) and [first2, last2)
+        template <typename Iter1, typename Sent1, typename Iter2,
+            typename Sent2, typename F, typename Proj1, typename Proj2>
+        friend constexpr util::in_in_result<Iter1, Iter2> tag_fallback_invoke(
+            sequential_mismatch_t<ExPolicy>, Iter1 first1, Sent1 last1,
+            Iter2 first2, Sent2 last2, F&& f, Proj1&& proj1, Proj2&& proj2)
+        {
+            while (first1 != last1 && first2 != last2 &&
+                PIKA_INVOKE(f, PIKA_INVOKE(proj1, *first1),
+                    PIKA_INVOKE(proj2, *first2)))
+            {
+                (void) ++first1, ++first2;
+            }
+            return {first1, first2};
+        }
+
+        // [first1, last1) and the same number of elements starting at first2
+        template <typename Iter1, typename Sent1, typename Iter2, typename F,
+            typename Proj1, typename Proj2>
+        friend constexpr util::in_in_result<Iter1, Iter2> tag_fallback_invoke(
+            sequential_mismatch_t<ExPolicy>, Iter1 first1, Sent1 last1,
+            Iter2 first2, F&& f, Proj1&& proj1, Proj2&& proj2)
+        {
+            while (first1 != last1 &&
+                PIKA_INVOKE(f, PIKA_INVOKE(proj1, *first1),
+                    PIKA_INVOKE(proj2, *first2)))
+            {
+                (void) ++first1, ++first2;
+            }
+            return {first1, first2};
+        }
+
+        // cancels tok if the partition contains a mismatch
+        template <typename Iter1, typename Iter2, typename Token, typename F,
+            typename Proj1, typename Proj2>
+        friend void tag_fallback_invoke(sequential_mismatch_t<ExPolicy>,
+            pika::util::zip_iterator<Iter1, Iter2> part_begin,
+            std::size_t part_count, Token& tok, F&& f, Proj1&& proj1,
+            Proj2&& proj2)
+        {
+            using zip_iterator = pika::util::zip_iterator<Iter1, Iter2>;
+            using reference = typename zip_iterator::reference;
+
+            // Note: replacing the invoke() with PIKA_INVOKE()
+            // below makes gcc generate errors
+            util::loop_n<std::decay_t<ExPolicy>>(part_begin, part_count, tok,
+                [&f, &proj1, &proj2, &tok](zip_iterator const& curr) {
+                    reference t = *curr;
+                    if (!pika::util::invoke(f,
+                            pika::util::invoke(proj1, pika::get<0>(t)),
+                            pika::util::invoke(proj2, pika::get<1>(t))))
+                    {
+                        tok.cancel();
+                    }
+                });
+        }
+
+        // cancels tok with the index of the first mismatch in the partition
+        template <typename Iter1, typename Iter2, typename Token, typename F,
+            typename Proj1, typename Proj2>
+        friend void tag_fallback_invoke(sequential_mismatch_t<ExPolicy>,
+            std::size_t base_idx,
+            pika::util::zip_iterator<Iter1, Iter2> part_begin,
+            std::size_t part_count, Token& tok, F&& f, Proj1&& proj1,
+            Proj2&& proj2)
+        {
+            using zip_iterator = pika::util::zip_iterator<Iter1, Iter2>;
+            using reference = typename zip_iterator::reference;
+
+            util::loop_idx_n<std::decay_t<ExPolicy>>(base_idx, part_begin,
+                part_count, tok,
+                [&f, &proj1, &proj2, &tok](
+                    reference t, std::size_t i) mutable -> void {
+                    if (!pika::util::invoke(f,
+                            pika::util::invoke(proj1, pika::get<0>(t)),
+                            pika::util::invoke(proj2, pika::get<1>(t))))
+                    {
+                        tok.cancel(i);
+                    }
+                });
+        }
+    };
+
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+    template <typename ExPolicy>
+    inline constexpr sequential_mismatch_t<ExPolicy> sequential_mismatch =
+        sequential_mismatch_t<ExPolicy>{};
+#else
+    template <typename ExPolicy, typename... Ts>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE auto sequential_mismatch(Ts&&... ts)
+    {
+        return sequential_mismatch_t<ExPolicy>{}(PIKA_FORWARD(Ts, ts)...);
+    }
+#endif
+}}}}    // namespace pika::parallel::v1::detail
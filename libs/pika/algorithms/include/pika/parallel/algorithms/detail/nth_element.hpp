@@ -0,0 +1,255 @@
+//  Copyright (c) 2020 Francisco Jose Tapia
+//  Copyright (c) 2021 Akhil J Nair
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/functional/invoke.hpp>
+
+#include <pika/executors/execution_policy.hpp>
+#include <pika/parallel/algorithms/detail/pivot.hpp>
+#include <pika/parallel/algorithms/minmax.hpp>
+#include <pika/parallel/algorithms/partition.hpp>
+#include <pika/parallel/algorithms/sort.hpp>
+#include <pika/parallel/util/nbits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///
+    /// \brief : The element placed in the nth position is exactly the
+    ///          element that would occur in this position if the range
+    ///          was fully sorted. All of the elements before this new nth
+    ///          element are less than or equal to the elements after the
+    ///          new nth element.
+    ///
+    /// \param first : iterator to the first element
+    /// \param nth : iterator defining the sort partition point
+    /// \param end : iterator to the element after the last in the range
+    /// \param level : level of depth in the call from the root
+    /// \param comp : object for to Compare elements
+    /// \param proj : projection
+    ///
+    template <class RandomIt, typename Compare, typename Proj>
+    constexpr void nth_element_seq(RandomIt first, RandomIt nth, RandomIt end,
+        std::uint32_t level, Compare&& comp, Proj&& proj)
+    {
+        std::uint32_t const nmin_sort = 24;
+        auto nelem = end - first;
+
+        // Check  the special conditions
+        if (nth == first)
+        {
+            RandomIt it = detail::min_element<RandomIt>().call(
+                pika::execution::seq, first, end, PIKA_FORWARD(Compare, comp),
+                PIKA_FORWARD(Proj, proj));
+
+            if (it != first)
+            {
+#if defined(PIKA_HAVE_CXX20_STD_RANGES_ITER_SWAP)
+                std::ranges::iter_swap(it, first);
+#else
+                std::iter_swap(it, first);
+#endif
+            }
+
+            return;
+        };
+
+        if (nelem < nmin_sort)
+        {
+            detail::sort<RandomIt>().call(pika::execution::seq, first, end,
+                PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
+            return;
+        }
+        if (level == 0)
+        {
+            std::make_heap(first, end, comp);
+            std::sort_heap(first, nth, comp);
+            return;
+        };
+
+        // Filter the range and check which part contains the nth element
+        RandomIt c_last = filter(first, end, comp);
+
+        if (c_last == nth)
+            return;
+
+        if (nth < c_last)
+            nth_element_seq(first, nth, c_last, level - 1,
+                PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
+        else
+            nth_element_seq(c_last + 1, nth, end, level - 1,
+                PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
+
+        return;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Ranges not longer than this are handed to nth_element_seq.
+    inline constexpr std::size_t nth_element_sequential_limit = 65536;
+
+    // The pivots are taken from a sorted sample of the range. They are
+    // placed nth_element_sample_margin sample positions below and above the
+    // position corresponding to nth, which is about three times the standard
+    // deviation of the rank of the nth element within the sample.
+    inline constexpr std::size_t nth_element_sample_size = 4096;
+    inline constexpr std::size_t nth_element_sample_margin = 96;
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///
+    /// \brief : Same as nth_element_seq, but narrows large ranges down in
+    ///          parallel first. Each round sorts a sample of the range and
+    ///          partitions the range in parallel around two pivots taken
+    ///          from the sample close to nth, which leaves only the elements
+    ///          between the pivots (a few percent of the range) to be
+    ///          looked at in the next round. Rounds which don't halve the
+    ///          range (e.g. because of duplicates) are followed by one
+    ///          partitioning around the single pivot at nth, which ends the
+    ///          selection if nth holds a value equivalent to the pivot.
+    ///
+    /// \param policy : execution policy used for the partitioning
+    /// \param first : iterator to the first element
+    /// \param nth : iterator defining the sort partition point
+    /// \param last : iterator to the element after the last in the range
+    /// \param comp : object for to Compare the projected elements
+    /// \param proj : projection
+    ///
+    template <typename ExPolicy, typename RandomIt, typename Compare,
+        typename Proj>
+    void parallel_nth_element(ExPolicy&& policy, RandomIt first, RandomIt nth,
+        RandomIt last, Compare&& comp, Proj&& proj)
+    {
+        using key_type = std::decay_t<decltype(PIKA_INVOKE(proj, *first))>;
+
+        PIKA_ASSERT(first <= nth && nth < last);
+
+        std::vector<key_type> sample;
+        sample.reserve(nth_element_sample_size);
+
+        std::size_t prev_count = (std::numeric_limits<std::size_t>::max)();
+        while (std::size_t(last - first) > nth_element_sequential_limit)
+        {
+            std::size_t const count = last - first;
+            std::size_t const rank = nth - first;
+
+            bool const single_pivot = count > prev_count / 2;
+            prev_count = count;
+
+            // take one element of each stride, the position within the
+            // stride is scrambled to not pick up periodic patterns
+            std::size_t const stride = count / nth_element_sample_size;
+            sample.clear();
+            for (std::size_t i = 0; i != nth_element_sample_size; ++i)
+            {
+                std::size_t const offset = (i * 2654435761u) % stride;
+                sample.push_back(
+                    PIKA_INVOKE(proj, *(first + (i * stride + offset))));
+            }
+            std::sort(sample.begin(), sample.end(),
+                [&comp](key_type const& lhs, key_type const& rhs) {
+                    return PIKA_INVOKE(comp, lhs, rhs);
+                });
+
+            std::size_t const pos = rank * nth_element_sample_size / count;
+            std::size_t const margin =
+                single_pivot ? 0 : nth_element_sample_margin;
+
+            bool const has_lo = pos >= margin;
+            bool const has_hi = pos + margin < nth_element_sample_size;
+            key_type const& lo = sample[has_lo ? pos - margin : 0];
+            key_type const& hi =
+                sample[has_hi ? pos + margin : nth_element_sample_size - 1];
+
+            // moves the elements less than lo to the front
+            auto partition_lo = [&](RandomIt begin, RandomIt end) {
+                if (!has_lo)
+                    return begin;
+                return detail::partition<RandomIt>().call(
+                    policy(pika::execution::non_task), begin, end,
+                    [&comp, &lo](auto const& key) {
+                        return PIKA_INVOKE(comp, key, lo);
+                    },
+                    proj);
+            };
+
+            // moves the elements not greater than hi to the front
+            auto partition_hi = [&](RandomIt begin, RandomIt end) {
+                if (!has_hi)
+                    return end;
+                return detail::partition<RandomIt>().call(
+                    policy(pika::execution::non_task), begin, end,
+                    [&comp, &hi](auto const& key) {
+                        return !PIKA_INVOKE(comp, hi, key);
+                    },
+                    proj);
+            };
+
+            // partition the whole range around the pivot further away from
+            // nth first, the second partitioning covers the smaller part
+            if (2 * rank < count)
+            {
+                RandomIt const mid = partition_hi(first, last);
+                if (nth >= mid)
+                {
+                    first = mid;
+                    continue;
+                }
+                last = mid;
+
+                RandomIt const mid_lo = partition_lo(first, last);
+                if (nth < mid_lo)
+                {
+                    last = mid_lo;
+                    continue;
+                }
+                first = mid_lo;
+            }
+            else
+            {
+                RandomIt const mid = partition_lo(first, last);
+                if (nth < mid)
+                {
+                    last = mid;
+                    continue;
+                }
+                first = mid;
+
+                RandomIt const mid_hi = partition_hi(first, last);
+                if (nth >= mid_hi)
+                {
+                    first = mid_hi;
+                    continue;
+                }
+                last = mid_hi;
+            }
+
+            // [first, last) holds the elements between lo and hi now, they
+            // are all equivalent if lo and hi are
+            if (has_lo && has_hi && !PIKA_INVOKE(comp, lo, hi))
+            {
+                return;
+            }
+        }
+
+        nth_element_seq(first, nth, last, util::nbits64(last - first) * 2,
+            PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
+    }
+    /// \endcond
+}}}}    // namespace pika::parallel::v1::detail
@@ -0,0 +1,349 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/execution/algorithms/detail/predicates.hpp>
+#include <pika/iterator_support/counting_iterator.hpp>
+#include <pika/iterator_support/iterator_range.hpp>
+#include <pika/modules/async_combinators.hpp>
+#include <pika/modules/execution.hpp>
+#include <pika/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Maps arithmetic keys to unsigned integers of the same size, such that
+    // comparing the integers yields the same order as comparing the keys
+    // using operator<.
+    template <typename T, typename Enable = void>
+    struct radix_key;
+
+    template <typename T>
+    struct radix_key<T, std::enable_if_t<std::is_integral_v<T>>>
+    {
+        using type = std::make_unsigned_t<T>;
+
+        static constexpr type encode(T t) noexcept
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                // flip the sign bit to order negative values first
+                return type(t) ^ (type(1) << (sizeof(T) * CHAR_BIT - 1));
+            }
+            else
+            {
+                return t;
+            }
+        }
+    };
+
+    template <typename T>
+    struct radix_key<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    {
+        using type = std::conditional_t<sizeof(T) == sizeof(std::uint32_t),
+            std::uint32_t, std::uint64_t>;
+
+        static type encode(T t) noexcept
+        {
+            type bits;
+            std::memcpy(&bits, &t, sizeof(T));
+
+            // flip all bits of negative values to reverse their order, set
+            // the sign bit of positive values to order them last
+            type const sign = type(1) << (sizeof(T) * CHAR_BIT - 1);
+            return (bits & sign) ? type(~bits) : type(bits | sign);
+        }
+    };
+
+    template <typename T>
+    inline constexpr bool is_radix_sortable_key_v =
+        (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+        ((std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+            std::numeric_limits<T>::is_iec559);
+
+    // Only comparisons known to be equivalent to operator< on the keys allow
+    // to use the radix sort.
+    template <typename Comp, typename Key>
+    inline constexpr bool is_radix_sort_compare_v =
+        std::is_same_v<Comp, detail::less> ||
+        std::is_same_v<Comp, std::less<Key>> ||
+        std::is_same_v<Comp, std::less<>>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Describes how to radix sort the elements of a sequence given the
+    // projection used by sort. It extracts the (encoded) keys from the
+    // elements and allocates the temporary buffer the elements are moved to
+    // and from. Specialized for all combinations of iterators and projections
+    // which can be radix sorted.
+    template <typename Iter, typename Proj, typename Enable = void>
+    struct radix_sort_traits : std::false_type
+    {
+    };
+
+    template <typename Iter>
+    struct radix_sort_traits<Iter, util::projection_identity,
+        std::enable_if_t<is_radix_sortable_key_v<
+            typename std::iterator_traits<Iter>::value_type>>> : std::true_type
+    {
+        using key_type = typename std::iterator_traits<Iter>::value_type;
+
+        template <typename T>
+        typename radix_key<key_type>::type operator()(T const& t) const
+            noexcept
+        {
+            return radix_key<key_type>::encode(t);
+        }
+
+        struct buffer
+        {
+            std::unique_ptr<key_type[]> data_;
+
+            explicit operator bool() const noexcept
+            {
+                return data_ != nullptr;
+            }
+
+            key_type* begin() const noexcept
+            {
+                return data_.get();
+            }
+        };
+
+        // the buffer is left uninitialized, an empty buffer is returned if
+        // the memory could not be allocated
+        static buffer allocate(std::size_t count)
+        {
+            return buffer{
+                std::unique_ptr<key_type[]>(new (std::nothrow) key_type[count])};
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // sequences shorter than this are sorted using the comparison sort
+    inline constexpr std::size_t radix_sort_limit = 65536;
+
+    // the minimal number of elements processed by one task
+    inline constexpr std::size_t radix_sort_min_block_size = 16384;
+
+    // The elements belonging to the same bucket are collected in a small
+    // buffer (of about two cache lines) and are written to the destination
+    // together (software write-combining).
+    template <typename T>
+    inline constexpr std::size_t radix_sort_wc_size =
+        sizeof(T) >= 128 ? 1 : 128 / sizeof(T);
+
+    // Sorts [first, first + count) by the keys extracted by key using a least
+    // significant digit radix sort with 8 bit digits. Every pass counts the
+    // digits of each block of elements, computes the destination of each
+    // block and bucket from the counts, and then moves the elements of all
+    // blocks to their destinations in parallel. The elements alternate
+    // between the sequence and buffer. Passes are skipped if all keys have
+    // the same digit.
+    template <typename ExPolicy, typename Iter, typename BufIter, typename Key>
+    void radix_sort(ExPolicy&& policy, Iter first, BufIter buffer,
+        std::size_t count, Key key)
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+        using key_type = decltype(key(*first));
+
+        constexpr std::size_t radix = 256;
+        constexpr std::size_t passes = sizeof(key_type);
+        constexpr std::size_t wc_size = radix_sort_wc_size<value_type>;
+
+        using counts_type = std::array<std::size_t, radix>;
+
+        std::size_t const cores = execution::processing_units_count(
+            policy.parameters(), policy.executor());
+        std::size_t const num_blocks = (std::max)(std::size_t(1),
+            (std::min)(cores, count / radix_sort_min_block_size));
+        std::size_t const block_size = (count + num_blocks - 1) / num_blocks;
+
+        auto shape = pika::util::make_iterator_range(
+            pika::util::make_counting_iterator(std::size_t(0)),
+            pika::util::make_counting_iterator(num_blocks));
+
+        auto for_each_block = [&](auto&& f) {
+            pika::when_all(execution::bulk_async_execute(
+                               policy.executor(),
+                               [&](std::size_t b) {
+                                   f(b, b * block_size,
+                                       (std::min)(count, (b + 1) * block_size));
+                               },
+                               shape))
+                .get();
+        };
+
+        auto digit = [](key_type k, std::size_t pass) -> std::size_t {
+            return std::size_t(k >> (pass * 8)) & (radix - 1);
+        };
+
+        // Count the digits of all passes at once. The counts of the blocks
+        // are only valid for the first pass, but the totals are valid for
+        // all passes.
+        std::vector<counts_type> counts(num_blocks * passes);
+        for_each_block([&](std::size_t b, std::size_t begin, std::size_t end) {
+            counts_type* c = &counts[b * passes];
+            Iter it = first + begin;
+            for (std::size_t i = begin; i != end; (void) ++i, ++it)
+            {
+                key_type const k = key(*it);
+                for (std::size_t p = 0; p != passes; ++p)
+                {
+                    ++c[p][digit(k, p)];
+                }
+            }
+        });
+
+        std::array<bool, passes> skip_pass;
+        for (std::size_t p = 0; p != passes; ++p)
+        {
+            counts_type total{};
+            for (std::size_t b = 0; b != num_blocks; ++b)
+            {
+                for (std::size_t d = 0; d != radix; ++d)
+                {
+                    total[d] += counts[b * passes + p][d];
+                }
+            }
+            skip_pass[p] = std::find(total.begin(), total.end(), count) !=
+                total.end();
+        }
+
+        if (std::find(skip_pass.begin(), skip_pass.end(), false) ==
+            skip_pass.end())
+        {
+            return;
+        }
+
+        std::vector<counts_type> offsets(num_blocks);
+        std::vector<std::unique_ptr<value_type[]>> wc_buffers(num_blocks);
+        for (auto& wc : wc_buffers)
+        {
+            wc.reset(new value_type[radix * wc_size]);
+        }
+
+        auto run_pass = [&](auto src, auto dst, std::size_t pass,
+                            bool recount) {
+            if (recount)
+            {
+                for_each_block(
+                    [&](std::size_t b, std::size_t begin, std::size_t end) {
+                        counts_type& c = counts[b * passes + pass];
+                        c.fill(0);
+                        auto it = src + begin;
+                        for (std::size_t i = begin; i != end; (void) ++i, ++it)
+                        {
+                            ++c[digit(key(*it), pass)];
+                        }
+                    });
+            }
+
+            // the elements of bucket d of block b go after the elements of
+            // all smaller buckets and of bucket d of all preceding blocks
+            std::size_t offset = 0;
+            for (std::size_t d = 0; d != radix; ++d)
+            {
+                for (std::size_t b = 0; b != num_blocks; ++b)
+                {
+                    offsets[b][d] = offset;
+                    offset += counts[b * passes + pass][d];
+                }
+            }
+
+            for_each_block(
+                [&](std::size_t b, std::size_t begin, std::size_t end) {
+                    counts_type& dest = offsets[b];
+                    value_type* wc = wc_buffers[b].get();
+                    std::array<std::size_t, radix> fill{};
+
+                    auto it = src + begin;
+                    for (std::size_t i = begin; i != end; (void) ++i, ++it)
+                    {
+                        std::size_t const d = digit(key(*it), pass);
+                        value_type* bucket = wc + d * wc_size;
+                        bucket[fill[d]] = PIKA_MOVE(*it);
+                        if (++fill[d] == wc_size)
+                        {
+                            std::move(bucket, bucket + wc_size, dst + dest[d]);
+                            dest[d] += wc_size;
+                            fill[d] = 0;
+                        }
+                    }
+
+                    for (std::size_t d = 0; d != radix; ++d)
+                    {
+                        value_type* bucket = wc + d * wc_size;
+                        std::move(bucket, bucket + fill[d], dst + dest[d]);
+                    }
+                });
+        };
+
+        bool in_buffer = false;
+        bool recount = false;
+        for (std::size_t p = 0; p != passes; ++p)
+        {
+            if (skip_pass[p])
+            {
+                continue;
+            }
+
+            if (in_buffer)
+            {
+                run_pass(buffer, first, p, recount);
+            }
+            else
+            {
+                run_pass(first, buffer, p, recount);
+            }
+
+            in_buffer = !in_buffer;
+            recount = true;
+        }
+
+        if (in_buffer)
+        {
+            for_each_block(
+                [&](std::size_t, std::size_t begin, std::size_t end) {
+                    std::move(buffer + begin, buffer + end, first + begin);
+                });
+        }
+    }
+
+    // Radix sorts [first, last), returns false if the temporary buffer could
+    // not be allocated.
+    template <typename Traits, typename ExPolicy, typename RandomIt>
+    bool parallel_radix_sort(ExPolicy&& policy, RandomIt first, RandomIt last)
+    {
+        std::size_t const count = last - first;
+
+        auto buffer = Traits::allocate(count);
+        if (!buffer)
+        {
+            return false;
+        }
+
+        radix_sort(PIKA_FORWARD(ExPolicy, policy), first, buffer.begin(),
+            count, Traits{});
+        return true;
+    }
+}}}}    // namespace pika::parallel::v1::detail
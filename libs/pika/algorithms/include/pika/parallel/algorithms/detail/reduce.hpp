@@ -0,0 +1,196 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/functional/detail/tag_fallback_invoke.hpp>
+#include <pika/functional/invoke.hpp>
+#include <pika/parallel/algorithms/detail/accumulate.hpp>
+#include <pika/parallel/util/loop.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Op1, typename Op2, typename T>
+    struct transform_reduce_binary_partition
+    {
+        typedef typename std::decay<T>::type value_type;
+
+        Op1 op1_;
+        Op2 op2_;
+        value_type& part_sum_;
+
+        template <typename Iter1, typename Iter2>
+        PIKA_HOST_DEVICE PIKA_FORCEINLINE constexpr void operator()(
+            Iter1 it1, Iter2 it2)
+        {
+            part_sum_ =
+                PIKA_INVOKE(op1_, part_sum_, PIKA_INVOKE(op2_, *it1, *it2));
+        }
+    };
+
+    template <typename F>
+    struct transform_reduce_binary_indirect
+    {
+        F f_;
+
+        template <typename Iter1, typename Iter2>
+        PIKA_HOST_DEVICE PIKA_FORCEINLINE constexpr auto operator()(
+            Iter1 it1, Iter2 it2) -> decltype(PIKA_INVOKE(f_, *it1, *it2))
+        {
+            return PIKA_INVOKE(f_, *it1, *it2);
+        }
+    };
+
+    template <typename ExPolicy, typename Iter, typename Sent, typename Iter2,
+        typename T, typename Op1, typename Op2>
+    T sequential_transform_reduce_binary_helper(
+        Iter first1, Sent last1, Iter2 first2, T init, Op1&& op1, Op2&& op2)
+    {
+        if (first1 == last1)
+        {
+            return init;
+        }
+
+        // check whether we should apply vectorization
+        if (!util::loop_optimization<ExPolicy>(first1, last1))
+        {
+            util::loop2<ExPolicy>(std::false_type(), first1, last1, first2,
+                transform_reduce_binary_partition<Op1, Op2, T>{
+                    PIKA_FORWARD(Op1, op1), PIKA_FORWARD(Op2, op2), init});
+            return init;
+        }
+
+        // loop_step properly advances the iterators
+        auto part_sum = util::loop_step<ExPolicy>(std::true_type(),
+            transform_reduce_binary_indirect<Op2>{op2}, first1, first2);
+
+        std::pair<Iter, Iter2> p = util::loop2<ExPolicy>(std::true_type(),
+            first1, last1, first2,
+            transform_reduce_binary_partition<Op1, Op2, decltype(part_sum)>{
+                op1, op2, part_sum});
+
+        // this is to support vectorization, it will call op1 for each
+        // of the elements of a value-pack
+        auto result = util::detail::accumulate_values<ExPolicy>(
+            [&op1](T const& sum, T&& val) -> T {
+                return PIKA_INVOKE(op1, sum, val);
+            },
+            PIKA_MOVE(part_sum), PIKA_MOVE(init));
+
+        // the vectorization might not cover all of the sequences,
+        // handle the remainder directly
+        if (p.first != last1)
+        {
+            util::loop2<ExPolicy>(std::false_type(), p.first, last1, p.second,
+                transform_reduce_binary_partition<Op1, Op2, decltype(result)>{
+                    PIKA_FORWARD(Op1, op1), PIKA_FORWARD(Op2, op2), result});
+        }
+
+        return util::detail::extract_value<ExPolicy>(result);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Reduces the elements of a sequence into init (reduce), optionally
+    // transforming every element (transform_reduce) or every pair of elements
+    // of two sequences (transform_reduce_binary) first. Vectorizing execution
+    // policies provide their own implementation (see datapar/reduce.hpp).
+    template <typename ExPolicy>
+    struct sequential_reduce_t
+      : pika::functional::detail::tag_fallback<sequential_reduce_t<ExPolicy>>
+    {
+    private:
+        template <typename Iter, typename Sent, typename T, typename Reduce>
+        friend constexpr T tag_fallback_invoke(sequential_reduce_t<ExPolicy>,
+            Iter first, Sent last, T init, Reduce&& r)
+        {
+            return detail::accumulate(
+                first, last, PIKA_MOVE(init), PIKA_FORWARD(Reduce, r));
+        }
+
+        template <typename Iter, typename Sent, typename T, typename Reduce,
+            typename Convert>
+        friend constexpr T tag_fallback_invoke(sequential_reduce_t<ExPolicy>,
+            Iter first, Sent last, T init, Reduce&& r, Convert&& conv)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+
+            return detail::accumulate(first, last, PIKA_MOVE(init),
+                [&r, &conv](T const& res, value_type const& next) -> T {
+                    return PIKA_INVOKE(r, res, PIKA_INVOKE(conv, next));
+                });
+        }
+
+        template <typename Iter, typename Sent, typename Iter2, typename T,
+            typename Reduce, typename Convert>
+        friend T tag_fallback_invoke(sequential_reduce_t<ExPolicy>,
+            Iter first1, Sent last1, Iter2 first2, T init, Reduce&& r,
+            Convert&& conv)
+        {
+            return sequential_transform_reduce_binary_helper<ExPolicy>(first1,
+                last1, first2, PIKA_MOVE(init), PIKA_FORWARD(Reduce, r),
+                PIKA_FORWARD(Convert, conv));
+        }
+    };
+
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+    template <typename ExPolicy>
+    inline constexpr sequential_reduce_t<ExPolicy> sequential_reduce =
+        sequential_reduce_t<ExPolicy>{};
+#else
+    template <typename ExPolicy, typename... Ts>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE auto sequential_reduce(Ts&&... ts)
+    {
+        return sequential_reduce_t<ExPolicy>{}(PIKA_FORWARD(Ts, ts)...);
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Same as sequential_reduce, but for a given number of elements
+    template <typename ExPolicy>
+    struct sequential_reduce_n_t
+      : pika::functional::detail::tag_fallback<sequential_reduce_n_t<ExPolicy>>
+    {
+    private:
+        template <typename Iter, typename T, typename Reduce>
+        friend constexpr T tag_fallback_invoke(sequential_reduce_n_t<ExPolicy>,
+            Iter first, std::size_t count, T init, Reduce&& r)
+        {
+            return util::accumulate_n(
+                first, count, PIKA_MOVE(init), PIKA_FORWARD(Reduce, r));
+        }
+
+        template <typename Iter, typename T, typename Reduce, typename Convert>
+        friend constexpr T tag_fallback_invoke(sequential_reduce_n_t<ExPolicy>,
+            Iter first, std::size_t count, T init, Reduce&& r, Convert&& conv)
+        {
+            using reference = typename std::iterator_traits<Iter>::reference;
+
+            return util::accumulate_n(first, count, PIKA_MOVE(init),
+                [&r, &conv](T const& res, reference next) -> T {
+                    return PIKA_INVOKE(r, res, PIKA_INVOKE(conv, next));
+                });
+        }
+    };
+
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+    template <typename ExPolicy>
+    inline constexpr sequential_reduce_n_t<ExPolicy> sequential_reduce_n =
+        sequential_reduce_n_t<ExPolicy>{};
+#else
+    template <typename ExPolicy, typename... Ts>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE auto sequential_reduce_n(Ts&&... ts)
+    {
+        return sequential_reduce_n_t<ExPolicy>{}(PIKA_FORWARD(Ts, ts)...);
+    }
+#endif
+}}}}    // namespace pika::parallel::v1::detail
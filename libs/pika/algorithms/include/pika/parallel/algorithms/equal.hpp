@@ -181,6 +181,7 @@ namespace pika {
 #include <pika/executors/execution_policy.hpp>
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/distance.hpp>
+#include <pika/parallel/algorithms/detail/mismatch.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/detail/sender_util.hpp>
 #include <pika/parallel/util/loop.hpp>
@@ -202,22 +203,6 @@ namespace pika { namespace parallel { inline namespace v1 {
     namespace detail {
         /// \cond NOINTERNAL
 
-        // Our own version of the C++14 equal (_binary).
-        template <typename InIter1, typename Sent1, typename InIter2,
-            typename Sent2, typename F, typename Proj1, typename Proj2>
-        bool sequential_equal_binary(InIter1 first1, Sent1 last1,
-            InIter2 first2, Sent2 last2, F&& f, Proj1&& proj1, Proj2&& proj2)
-        {
-            for (/* */; first1 != last1 && first2 != last2;
-                 (void) ++first1, ++first2)
-            {
-                if (!PIKA_INVOKE(f, PIKA_INVOKE(proj1, *first1),
-                        PIKA_INVOKE(proj2, *first2)))
-                    return false;
-            }
-            return first1 == last1 && first2 == last2;
-        }
-
         ///////////////////////////////////////////////////////////////////////
         struct equal_binary : public detail::algorithm<equal_binary, bool>
         {
@@ -232,9 +217,10 @@ namespace pika { namespace parallel { inline namespace v1 {
             static bool sequential(ExPolicy, Iter1 first1, Sent1 last1,
                 Iter2 first2, Sent2 last2, F&& f, Proj1&& proj1, Proj2&& proj2)
             {
-                return sequential_equal_binary(first1, last1, first2, last2,
-                    PIKA_FORWARD(F, f), PIKA_FORWARD(Proj1, proj1),
-                    PIKA_FORWARD(Proj2, proj2));
+                auto result = sequential_mismatch<std::decay_t<ExPolicy>>(
+                    first1, last1, first2, last2, PIKA_FORWARD(F, f),
+                    PIKA_FORWARD(Proj1, proj1), PIKA_FORWARD(Proj2, proj2));
+                return result.in1 == last1 && result.in2 == last2;
             }
 
             template <typename ExPolicy, typename Iter1, typename Sent1,
@@ -278,27 +264,16 @@ namespace pika { namespace parallel { inline namespace v1 {
                 }
 
                 typedef pika::util::zip_iterator<Iter1, Iter2> zip_iterator;
-                typedef typename zip_iterator::reference reference;
 
                 util::cancellation_token<> tok;
 
-                // Note: replacing the invoke() with PIKA_INVOKE()
-                // below makes gcc generate errors
                 auto f1 = [tok, f = PIKA_FORWARD(F, f),
                               proj1 = PIKA_FORWARD(Proj1, proj1),
                               proj2 = PIKA_FORWARD(Proj2, proj2)](
                               zip_iterator it,
                               std::size_t part_count) mutable -> bool {
-                    util::loop_n<std::decay_t<ExPolicy>>(it, part_count, tok,
-                        [&f, &proj1, &proj2, &tok](zip_iterator const& curr) {
-                            reference t = *curr;
-                            if (!pika::util::invoke(f,
-                                    pika::util::invoke(proj1, pika::get<0>(t)),
-                                    pika::util::invoke(proj2, pika::get<1>(t))))
-                            {
-                                tok.cancel();
-                            }
-                        });
+                    sequential_mismatch<std::decay_t<ExPolicy>>(
+                        it, part_count, tok, f, proj1, proj2);
                     return !tok.was_cancelled();
                 };
 
@@ -332,7 +307,11 @@ namespace pika { namespace parallel { inline namespace v1 {
             static bool sequential(
                 ExPolicy, InIter1 first1, InIter1 last1, InIter2 first2, F&& f)
             {
-                return std::equal(first1, last1, first2, PIKA_FORWARD(F, f));
+                return sequential_mismatch<std::decay_t<ExPolicy>>(first1,
+                           last1, first2, PIKA_FORWARD(F, f),
+                           util::projection_identity{},
+                           util::projection_identity{})
+                           .in1 == last1;
             }
 
             template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
@@ -353,20 +332,13 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 typedef pika::util::zip_iterator<FwdIter1, FwdIter2>
                     zip_iterator;
-                typedef typename zip_iterator::reference reference;
 
                 util::cancellation_token<> tok;
                 auto f1 = [f, tok](zip_iterator it,
                               std::size_t part_count) mutable -> bool {
-                    util::loop_n<std::decay_t<ExPolicy>>(it, part_count, tok,
-                        [&f, &tok](zip_iterator const& curr) mutable -> void {
-                            reference t = *curr;
-                            if (!PIKA_INVOKE(
-                                    f, pika::get<0>(t), pika::get<1>(t)))
-                            {
-                                tok.cancel();
-                            }
-                        });
+                    sequential_mismatch<std::decay_t<ExPolicy>>(it,
+                        part_count, tok, f, util::projection_identity{},
+                        util::projection_identity{});
                     return !tok.was_cancelled();
                 };
 
@@ -420,7 +420,8 @@ namespace pika { namespace parallel { inline namespace v1 {
                 };
 
                 return util::scan_partitioner<ExPolicy,
-                    util::in_out_result<FwdIter1, FwdIter2>, T>::
+                    util::in_out_result<FwdIter1, FwdIter2>, T, void,
+                    util::scan_partitioner_single_pass_tag>::
                     call(
                         PIKA_FORWARD(ExPolicy, policy),
                         make_zip_iterator(first, dest), count, init,
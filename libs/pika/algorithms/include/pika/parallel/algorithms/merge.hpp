@@ -170,6 +170,7 @@ namespace pika {
 #include <pika/assert.hpp>
 #include <pika/concepts/concepts.hpp>
 #include <pika/functional/invoke.hpp>
+#include <pika/iterator_support/counting_iterator.hpp>
 #include <pika/iterator_support/traits/is_iterator.hpp>
 #include <pika/parallel/util/detail/sender_util.hpp>
 
@@ -185,8 +186,10 @@ namespace pika {
 #include <pika/parallel/util/compare_projected.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/detail/handle_local_exceptions.hpp>
+#include <pika/parallel/util/partitioner.hpp>
 #include <pika/parallel/util/projection_identity.hpp>
 #include <pika/parallel/util/result_types.hpp>
+#include <pika/type_support/empty_function.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -194,6 +197,7 @@ namespace pika {
 #include <iterator>
 #include <list>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -276,140 +280,114 @@ namespace pika { namespace parallel { inline namespace v1 {
         };
 
         ///////////////////////////////////////////////////////////////////////
-        template <typename ExPolicy, typename Iter1, typename Sent1,
-            typename Iter2, typename Sent2, typename Iter3, typename Comp,
-            typename Proj1, typename Proj2, typename BinarySearchHelper>
-        void parallel_merge_helper(ExPolicy policy, Iter1 first1, Sent1 last1,
-            Iter2 first2, Sent2 last2, Iter3 dest, Comp&& comp, Proj1&& proj1,
-            Proj2&& proj2, bool range_reversal, BinarySearchHelper)
+        // sequences shorter than this are merged sequentially
+        inline constexpr std::size_t merge_sequential_limit = 65536;
+
+        // Returns the number of elements of [first1, first1 + len1) among the
+        // first k elements of the stable merge of [first1, first1 + len1) and
+        // [first2, first2 + len2), i.e. the position at which the merge path
+        // crosses the k-th diagonal.
+        template <typename Iter1, typename Iter2, typename Comp,
+            typename Proj1, typename Proj2>
+        std::size_t merge_path_co_rank(std::size_t k, Iter1 first1,
+            std::size_t len1, Iter2 first2, std::size_t len2, Comp& comp,
+            Proj1& proj1, Proj2& proj2)
         {
-            constexpr std::size_t threshold = 65536;
-
-            std::size_t size1 = detail::distance(first1, last1);
-            std::size_t size2 = detail::distance(first2, last2);
-
-            // Perform sequential merge if data size is smaller than threshold.
-            if (size1 + size2 <= threshold)
+            std::size_t lo = k > len2 ? k - len2 : 0;
+            std::size_t hi = (std::min)(k, len1);
+            while (lo < hi)
             {
-                if (range_reversal)
+                std::size_t const mid = lo + (hi - lo) / 2;
+
+                // first1[mid] is among the first k elements if it goes before
+                // first2[k - mid - 1]
+                if (!PIKA_INVOKE(comp,
+                        PIKA_INVOKE(proj2, *std::next(first2, k - mid - 1)),
+                        PIKA_INVOKE(proj1, *std::next(first1, mid))))
                 {
-                    sequential_merge(first2, last2, first1, last1, dest,
-                        PIKA_FORWARD(Comp, comp), PIKA_FORWARD(Proj2, proj2),
-                        PIKA_FORWARD(Proj1, proj1));
+                    lo = mid + 1;
                 }
                 else
                 {
-                    sequential_merge(first1, last1, first2, last2, dest,
-                        PIKA_FORWARD(Comp, comp), PIKA_FORWARD(Proj1, proj1),
-                        PIKA_FORWARD(Proj2, proj2));
+                    hi = mid;
                 }
-                return;
-            }
-
-            // Let size1 is bigger than size2 always.
-            if (size1 < size2)
-            {
-                // For stability of algorithm, must switch binary search methods
-                // when swapping size1 and size2.
-                parallel_merge_helper(policy, first2, last2, first1, last1,
-                    dest, PIKA_FORWARD(Comp, comp), PIKA_FORWARD(Proj2, proj2),
-                    PIKA_FORWARD(Proj1, proj1), !range_reversal,
-                    typename BinarySearchHelper::another_type());
-                return;
             }
+            return lo;
+        }
 
-            PIKA_ASSERT(size1 >= size2);
-            PIKA_ASSERT(size1 >= 1ul);
-
-            Iter1 mid1 = first1 + size1 / 2;
-            Iter2 boundary2 = BinarySearchHelper::call(
-                first2, last2, PIKA_INVOKE(proj1, *mid1), comp, proj2);
-            Iter3 target = dest + (mid1 - first1) + (boundary2 - first2);
-
-            *target = *mid1;
-
-            pika::future<void> fut =
-                execution::async_execute(policy.executor(), [&]() -> void {
-                    // Process left side ranges.
-                    parallel_merge_helper(policy, first1, mid1, first2,
-                        boundary2, dest, comp, proj1, proj2, range_reversal,
-                        BinarySearchHelper());
-                });
-
-            try
-            {
-                // Process right side ranges.
-                parallel_merge_helper(policy, mid1 + 1, last1, boundary2, last2,
-                    target + 1, PIKA_FORWARD(Comp, comp),
-                    PIKA_FORWARD(Proj1, proj1), PIKA_FORWARD(Proj2, proj2),
-                    range_reversal, BinarySearchHelper());
-            }
-            catch (...)
-            {
-                fut.wait();
-
-                std::vector<pika::future<void>> futures;
-                futures.reserve(2);
-                futures.emplace_back(PIKA_MOVE(fut));
-                futures.emplace_back(pika::make_exceptional_future<void>(
-                    std::current_exception()));
-
-                std::list<std::exception_ptr> errors;
-                util::detail::handle_local_exceptions<ExPolicy>::call(
-                    futures, errors);
-
-                // Not reachable.
-                PIKA_ASSERT(false);
-                return;
-            }
+        // Merges [first1, first1 + len1) and [first2, first2 + len2) into
+        // dest. The output is split into equally sized chunks by the
+        // partitioner, every chunk locates its part of both inputs on the
+        // merge path and merges them sequentially. All chunks are launched at
+        // once. The result is produced by f from the futures of the chunks.
+        template <typename ExPolicy, typename R, typename Iter1,
+            typename Iter2, typename Iter3, typename Comp, typename Proj1,
+            typename Proj2, typename F>
+        decltype(auto) merge_path(ExPolicy&& policy, Iter1 first1,
+            std::size_t len1, Iter2 first2, std::size_t len2, Iter3 dest,
+            Comp&& comp, Proj1&& proj1, Proj2&& proj2, F&& f)
+        {
+            auto f1 = [first1, len1, first2, len2, dest,
+                          comp = PIKA_FORWARD(Comp, comp),
+                          proj1 = PIKA_FORWARD(Proj1, proj1),
+                          proj2 = PIKA_FORWARD(Proj2, proj2)](
+                          pika::util::counting_iterator<std::size_t> it,
+                          std::size_t size) mutable {
+                std::size_t const k = *it;
+                std::size_t const begin1 = merge_path_co_rank(
+                    k, first1, len1, first2, len2, comp, proj1, proj2);
+                std::size_t const end1 = merge_path_co_rank(
+                    k + size, first1, len1, first2, len2, comp, proj1, proj2);
+
+                sequential_merge(std::next(first1, begin1),
+                    std::next(first1, end1), std::next(first2, k - begin1),
+                    std::next(first2, k + size - end1), std::next(dest, k),
+                    comp, proj1, proj2);
+            };
 
-            fut.get();
+            return util::partitioner<ExPolicy, R, void>::call(
+                PIKA_FORWARD(ExPolicy, policy),
+                pika::util::make_counting_iterator(std::size_t(0)),
+                len1 + len2, PIKA_MOVE(f1), PIKA_FORWARD(F, f));
         }
 
         template <typename ExPolicy, typename Iter1, typename Sent1,
             typename Iter2, typename Sent2, typename Iter3, typename Comp,
             typename Proj1, typename Proj2>
-        pika::future<util::in_in_out_result<Iter1, Iter2, Iter3>>
+        typename util::detail::algorithm_result<ExPolicy,
+            util::in_in_out_result<Iter1, Iter2, Iter3>>::type
         parallel_merge(ExPolicy&& policy, Iter1 first1, Sent1 last1,
             Iter2 first2, Sent2 last2, Iter3 dest, Comp&& comp, Proj1&& proj1,
             Proj2&& proj2)
         {
             using result_type = util::in_in_out_result<Iter1, Iter2, Iter3>;
+            using algorithm_result =
+                util::detail::algorithm_result<ExPolicy, result_type>;
 
-            auto f1 = [first1, last1, first2, last2, dest,
-                          policy = PIKA_FORWARD(ExPolicy, policy),
-                          comp = PIKA_FORWARD(Comp, comp),
-                          proj1 = PIKA_FORWARD(Proj1, proj1),
-                          proj2 = PIKA_FORWARD(
-                              Proj2, proj2)]() mutable -> result_type {
-                try
-                {
-                    parallel_merge_helper(PIKA_MOVE(policy), first1, last1,
-                        first2, last2, dest, PIKA_MOVE(comp), PIKA_MOVE(proj1),
-                        PIKA_MOVE(proj2), false, lower_bound_helper());
-
-                    auto len1 = detail::distance(first1, last1);
-                    auto len2 = detail::distance(first2, last2);
-                    return {std::next(first1, len1), std::next(first2, len2),
-                        std::next(dest, len1 + len2)};
-                }
-                catch (...)
-                {
-                    util::detail::handle_local_exceptions<ExPolicy>::call(
-                        std::current_exception());
-                    PIKA_ASSERT(false);
-                    // To silence no return statement in all control blocks
-                    auto len1 = detail::distance(first1, last1);
-                    auto len2 = detail::distance(first2, last2);
-                    return {std::next(first1, len1), std::next(first2, len2),
-                        std::next(dest, len1 + len2)};
-                }
+            std::size_t const len1 = detail::distance(first1, last1);
+            std::size_t const len2 = detail::distance(first2, last2);
+
+            if (len1 + len2 <= merge_sequential_limit)
+            {
+                return algorithm_result::get(sequential_merge(first1, last1,
+                    first2, last2, dest, PIKA_FORWARD(Comp, comp),
+                    PIKA_FORWARD(Proj1, proj1), PIKA_FORWARD(Proj2, proj2)));
+            }
 
-                // Not reachable.
-                PIKA_ASSERT(false);
+            auto f2 = [first1, len1, first2, len2, dest](
+                          std::vector<pika::future<void>>&& data) mutable
+                -> result_type {
+                // make sure iterators embedded in function object that is
+                // attached to futures are invalidated
+                data.clear();
+                return {std::next(first1, len1), std::next(first2, len2),
+                    std::next(dest, len1 + len2)};
             };
 
-            return execution::async_execute(policy.executor(), PIKA_MOVE(f1));
+            return merge_path<ExPolicy, result_type>(
+                PIKA_FORWARD(ExPolicy, policy), first1, len1, first2, len2,
+                dest, PIKA_FORWARD(Comp, comp), PIKA_FORWARD(Proj1, proj1),
+                PIKA_FORWARD(Proj2, proj2), PIKA_MOVE(f2));
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -448,11 +426,10 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 try
                 {
-                    return algorithm_result::get(parallel_merge(
-                        PIKA_FORWARD(ExPolicy, policy), first1, last1, first2,
-                        last2, dest, PIKA_FORWARD(Comp, comp),
-                        PIKA_FORWARD(Proj1, proj1),
-                        PIKA_FORWARD(Proj2, proj2)));
+                    return parallel_merge(PIKA_FORWARD(ExPolicy, policy),
+                        first1, last1, first2, last2, dest,
+                        PIKA_FORWARD(Comp, comp), PIKA_FORWARD(Proj1, proj1),
+                        PIKA_FORWARD(Proj2, proj2));
                 }
                 catch (...)
                 {
@@ -617,6 +594,70 @@ namespace pika { namespace parallel { inline namespace v1 {
             }
         }
 
+        // Merges [first, middle) and [middle, last) using a temporary buffer:
+        // the elements are copied to the buffer and are merged back into the
+        // sequence along the merge path, both in parallel. Returns false
+        // without touching the sequence if the elements are not trivially
+        // copyable or if no buffer could be allocated.
+        template <typename ExPolicy, typename Iter, typename Comp,
+            typename Proj>
+        bool parallel_buffered_inplace_merge(ExPolicy&& policy, Iter first,
+            Iter middle, Iter last, Comp&& comp, Proj&& proj)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+
+            // every chunk searches the merge path through the whole buffer,
+            // the elements in the buffer must stay valid while other chunks
+            // copy them back into the sequence
+            if constexpr (!std::is_trivially_copyable_v<value_type> ||
+                alignof(value_type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            {
+                return false;
+            }
+            else
+            {
+                std::size_t const len1 = detail::distance(first, middle);
+                std::size_t const len2 = detail::distance(middle, last);
+                std::size_t const count = len1 + len2;
+
+                value_type* buffer = static_cast<value_type*>(::operator new(
+                    count * sizeof(value_type), std::nothrow));
+                if (buffer == nullptr)
+                {
+                    return false;
+                }
+
+                struct buffer_guard
+                {
+                    value_type* buffer_;
+
+                    ~buffer_guard()
+                    {
+                        ::operator delete(buffer_);
+                    }
+                } guard{buffer};
+
+                util::partitioner<ExPolicy>::call(
+                    policy, pika::util::make_counting_iterator(std::size_t(0)),
+                    count,
+                    [first, buffer](
+                        pika::util::counting_iterator<std::size_t> it,
+                        std::size_t size) {
+                        std::uninitialized_copy_n(
+                            std::next(first, *it), size, buffer + *it);
+                    },
+                    pika::util::empty_function{});
+
+                merge_path<ExPolicy, void>(PIKA_FORWARD(ExPolicy, policy),
+                    static_cast<value_type const*>(buffer), len1,
+                    static_cast<value_type const*>(buffer + len1), len2, first,
+                    PIKA_FORWARD(Comp, comp), proj, proj,
+                    pika::util::empty_function{});
+
+                return true;
+            }
+        }
+
         template <typename ExPolicy, typename Iter, typename Sent,
             typename Comp, typename Proj>
         inline pika::future<Iter> parallel_inplace_merge(ExPolicy&& policy,
@@ -627,9 +668,22 @@ namespace pika { namespace parallel { inline namespace v1 {
                     proj = PIKA_FORWARD(Proj, proj)]() mutable -> Iter {
                     try
                     {
-                        parallel_inplace_merge_helper(policy, first, middle,
-                            last, PIKA_MOVE(comp), PIKA_MOVE(proj));
-                        return last;
+                        Iter const last_iter =
+                            detail::advance_to_sentinel(middle, last);
+
+                        // fall back to merging by rotations if the sequence
+                        // is small or if no buffer is available
+                        if (detail::distance(first, last_iter) <=
+                                merge_sequential_limit ||
+                            !parallel_buffered_inplace_merge(
+                                policy(pika::execution::non_task), first,
+                                middle, last_iter, comp, proj))
+                        {
+                            parallel_inplace_merge_helper(policy, first,
+                                middle, last, PIKA_MOVE(comp),
+                                PIKA_MOVE(proj));
+                        }
+                        return last_iter;
                     }
                     catch (...)
                     {
@@ -376,6 +376,7 @@ namespace pika {
 #include <pika/executors/execution_policy.hpp>
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/distance.hpp>
+#include <pika/parallel/algorithms/detail/minmax.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/loop.hpp>
 #include <pika/parallel/util/partitioner.hpp>
@@ -396,34 +397,6 @@ namespace pika { namespace parallel { inline namespace v1 {
     // min_element
     namespace detail {
         /// \cond NOINTERNAL
-        template <typename ExPolicy, typename FwdIter, typename F,
-            typename Proj>
-        constexpr FwdIter sequential_min_element(ExPolicy&&, FwdIter it,
-            std::size_t count, F const& f, Proj const& proj)
-        {
-            if (count == 0 || count == 1)
-                return it;
-
-            using element_type = pika::traits::proxy_value_t<
-                typename std::iterator_traits<FwdIter>::value_type>;
-
-            auto smallest = it;
-
-            element_type value = PIKA_INVOKE(proj, *smallest);
-            util::loop_n<std::decay_t<ExPolicy>>(
-                ++it, count - 1, [&](FwdIter const& curr) -> void {
-                    element_type curr_value = PIKA_INVOKE(proj, *curr);
-                    if (PIKA_INVOKE(f, curr_value, value))
-                    {
-                        smallest = curr;
-                        value = PIKA_MOVE(curr_value);
-                    }
-                });
-
-            return smallest;
-        }
-
-        ///////////////////////////////////////////////////////////////////////
         template <typename Iter>
         struct min_element : public detail::algorithm<min_element<Iter>, Iter>
         {
@@ -448,7 +421,9 @@ namespace pika { namespace parallel { inline namespace v1 {
                         decltype(smallest)>::value_type>;
 
                 element_type value = PIKA_INVOKE(proj, *smallest);
-                util::loop_n<std::decay_t<ExPolicy>>(
+                // the partition results are iterators, which can't be
+                // processed in vector packs
+                util::loop_n<pika::execution::sequenced_policy>(
                     ++it, count - 1, [&](FwdIter const& curr) -> void {
                         element_type curr_value = PIKA_INVOKE(proj, **curr);
                         if (PIKA_INVOKE(f, curr_value, value))
@@ -469,28 +444,10 @@ namespace pika { namespace parallel { inline namespace v1 {
             template <typename ExPolicy, typename FwdIter, typename Sent,
                 typename F, typename Proj>
             static FwdIter sequential(
-                ExPolicy&& policy, FwdIter first, Sent last, F&& f, Proj&& proj)
+                ExPolicy&&, FwdIter first, Sent last, F&& f, Proj&& proj)
             {
-                if (first == last)
-                    return first;
-
-                using element_type = pika::traits::proxy_value_t<
-                    typename std::iterator_traits<FwdIter>::value_type>;
-
-                auto smallest = first;
-
-                element_type value = PIKA_INVOKE(proj, *smallest);
-                util::loop(PIKA_FORWARD(ExPolicy, policy), ++first, last,
-                    [&](FwdIter const& curr) -> void {
-                        element_type curr_value = PIKA_INVOKE(proj, *curr);
-                        if (PIKA_INVOKE(f, curr_value, value))
-                        {
-                            smallest = curr;
-                            value = PIKA_MOVE(curr_value);
-                        }
-                    });
-
-                return smallest;
+                return sequential_min_element<std::decay_t<ExPolicy>>(
+                    first, detail::distance(first, last), f, proj);
             }
 
             template <typename ExPolicy, typename FwdIter, typename Sent,
@@ -508,8 +465,8 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 auto f1 = [f, proj, policy](
                               FwdIter it, std::size_t part_count) -> FwdIter {
-                    return sequential_min_element(
-                        policy, it, part_count, f, proj);
+                    return sequential_min_element<std::decay_t<ExPolicy>>(
+                        it, part_count, f, proj);
                 };
                 auto f2 = [policy, f = PIKA_FORWARD(F, f),
                               proj = PIKA_FORWARD(Proj, proj)](
@@ -532,34 +489,6 @@ namespace pika { namespace parallel { inline namespace v1 {
     // max_element
     namespace detail {
         /// \cond NOINTERNAL
-        template <typename ExPolicy, typename FwdIter, typename F,
-            typename Proj>
-        constexpr FwdIter sequential_max_element(ExPolicy&&, FwdIter it,
-            std::size_t count, F const& f, Proj const& proj)
-        {
-            if (count == 0 || count == 1)
-                return it;
-
-            using element_type = pika::traits::proxy_value_t<
-                typename std::iterator_traits<FwdIter>::value_type>;
-
-            auto largest = it;
-
-            element_type value = PIKA_INVOKE(proj, *largest);
-            util::loop_n<std::decay_t<ExPolicy>>(
-                ++it, count - 1, [&](FwdIter const& curr) -> void {
-                    element_type curr_value = PIKA_INVOKE(proj, *curr);
-                    if (!PIKA_INVOKE(f, curr_value, value))
-                    {
-                        largest = curr;
-                        value = PIKA_MOVE(curr_value);
-                    }
-                });
-
-            return largest;
-        }
-
-        ///////////////////////////////////////////////////////////////////////
         template <typename Iter>
         struct max_element : public detail::algorithm<max_element<Iter>, Iter>
         {
@@ -583,7 +512,7 @@ namespace pika { namespace parallel { inline namespace v1 {
                         decltype(largest)>::value_type>;
 
                 element_type value = PIKA_INVOKE(proj, *largest);
-                util::loop_n<std::decay_t<ExPolicy>>(
+                util::loop_n<pika::execution::sequenced_policy>(
                     ++it, count - 1, [&](FwdIter const& curr) -> void {
                         element_type curr_value = PIKA_INVOKE(proj, **curr);
                         if (!PIKA_INVOKE(f, curr_value, value))
@@ -604,28 +533,10 @@ namespace pika { namespace parallel { inline namespace v1 {
             template <typename ExPolicy, typename FwdIter, typename Sent,
                 typename F, typename Proj>
             static FwdIter sequential(
-                ExPolicy&& policy, FwdIter first, Sent last, F&& f, Proj&& proj)
+                ExPolicy&&, FwdIter first, Sent last, F&& f, Proj&& proj)
             {
-                if (first == last)
-                    return first;
-
-                using element_type = pika::traits::proxy_value_t<
-                    typename std::iterator_traits<FwdIter>::value_type>;
-
-                auto largest = first;
-
-                element_type value = PIKA_INVOKE(proj, *largest);
-                util::loop(PIKA_FORWARD(ExPolicy, policy), ++first, last,
-                    [&](FwdIter const& curr) -> void {
-                        element_type curr_value = PIKA_INVOKE(proj, *curr);
-                        if (!PIKA_INVOKE(f, curr_value, value))
-                        {
-                            largest = curr;
-                            value = PIKA_MOVE(curr_value);
-                        }
-                    });
-
-                return largest;
+                return sequential_max_element<std::decay_t<ExPolicy>>(
+                    first, detail::distance(first, last), f, proj);
             }
 
             template <typename ExPolicy, typename FwdIter, typename Sent,
@@ -643,8 +554,8 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 auto f1 = [f, proj, policy](
                               FwdIter it, std::size_t part_count) -> FwdIter {
-                    return sequential_max_element(
-                        policy, it, part_count, f, proj);
+                    return sequential_max_element<std::decay_t<ExPolicy>>(
+                        it, part_count, f, proj);
                 };
                 auto f2 = [policy, f = PIKA_FORWARD(F, f),
                               proj = PIKA_FORWARD(Proj, proj)](
@@ -667,40 +578,6 @@ namespace pika { namespace parallel { inline namespace v1 {
     // minmax_element
     namespace detail {
         /// \cond NOINTERNAL
-        template <typename ExPolicy, typename FwdIter, typename F,
-            typename Proj>
-        minmax_element_result<FwdIter> sequential_minmax_element(ExPolicy&&,
-            FwdIter it, std::size_t count, F const& f, Proj const& proj)
-        {
-            minmax_element_result<FwdIter> result = {it, it};
-
-            if (count == 0 || count == 1)
-                return result;
-
-            using element_type = pika::traits::proxy_value_t<
-                typename std::iterator_traits<FwdIter>::value_type>;
-
-            element_type min_value = PIKA_INVOKE(proj, *it);
-            element_type max_value = min_value;
-            util::loop_n<std::decay_t<ExPolicy>>(
-                ++it, count - 1, [&](FwdIter const& curr) -> void {
-                    element_type curr_value = PIKA_INVOKE(proj, *curr);
-                    if (PIKA_INVOKE(f, curr_value, min_value))
-                    {
-                        result.min = curr;
-                        min_value = curr_value;
-                    }
-
-                    if (!PIKA_INVOKE(f, curr_value, max_value))
-                    {
-                        result.max = curr;
-                        max_value = PIKA_MOVE(curr_value);
-                    }
-                });
-
-            return result;
-        }
-
         template <typename Iter>
         struct minmax_element
           : public detail::algorithm<minmax_element<Iter>,
@@ -726,7 +603,7 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 element_type min_value = PIKA_INVOKE(proj, *result.min);
                 element_type max_value = PIKA_INVOKE(proj, *result.max);
-                util::loop_n<std::decay_t<ExPolicy>>(
+                util::loop_n<pika::execution::sequenced_policy>(
                     ++it, count - 1, [&](PairIter const& curr) -> void {
                         element_type curr_min_value =
                             PIKA_INVOKE(proj, *curr->min);
@@ -756,37 +633,10 @@ namespace pika { namespace parallel { inline namespace v1 {
             template <typename ExPolicy, typename FwdIter, typename Sent,
                 typename F, typename Proj>
             static minmax_element_result<FwdIter> sequential(
-                ExPolicy&& policy, FwdIter first, Sent last, F&& f, Proj&& proj)
+                ExPolicy&&, FwdIter first, Sent last, F&& f, Proj&& proj)
             {
-                auto min = first, max = first;
-
-                if (first == last || ++first == last)
-                {
-                    return minmax_element_result<FwdIter>{min, max};
-                }
-
-                using element_type = pika::traits::proxy_value_t<
-                    typename std::iterator_traits<FwdIter>::value_type>;
-
-                element_type min_value = PIKA_INVOKE(proj, *min);
-                element_type max_value = PIKA_INVOKE(proj, *max);
-                util::loop(PIKA_FORWARD(ExPolicy, policy), first, last,
-                    [&](FwdIter const& curr) -> void {
-                        element_type curr_value = PIKA_INVOKE(proj, *curr);
-                        if (PIKA_INVOKE(f, curr_value, min_value))
-                        {
-                            min = curr;
-                            min_value = curr_value;
-                        }
-
-                        if (!PIKA_INVOKE(f, curr_value, max_value))
-                        {
-                            max = curr;
-                            max_value = PIKA_MOVE(curr_value);
-                        }
-                    });
-
-                return minmax_element_result<FwdIter>{min, max};
+                return sequential_minmax_element<std::decay_t<ExPolicy>>(
+                    first, detail::distance(first, last), f, proj);
             }
 
             template <typename ExPolicy, typename FwdIter, typename Sent,
@@ -807,8 +657,8 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 auto f1 = [f, proj, policy](FwdIter it, std::size_t part_count)
                     -> minmax_element_result<FwdIter> {
-                    return sequential_minmax_element(
-                        policy, it, part_count, f, proj);
+                    return sequential_minmax_element<std::decay_t<ExPolicy>>(
+                        it, part_count, f, proj);
                 };
                 auto f2 =
                     [policy, f = PIKA_FORWARD(F, f),
@@ -138,10 +138,8 @@ namespace pika {
 #include <pika/execution/algorithms/detail/predicates.hpp>
 #include <pika/executors/execution_policy.hpp>
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
-#include <pika/parallel/algorithms/detail/pivot.hpp>
-#include <pika/parallel/algorithms/minmax.hpp>
+#include <pika/parallel/algorithms/detail/nth_element.hpp>
 #include <pika/parallel/algorithms/partial_sort.hpp>
-#include <pika/parallel/algorithms/partition.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 
 #include <algorithm>
@@ -157,76 +155,6 @@ namespace pika { namespace parallel { inline namespace v1 {
     // nth_element
     namespace detail {
 
-        ///////////////////////////////////////////////////////////////////////
-        ///
-        /// \brief : The element placed in the nth position is exactly the
-        ///          element that would occur in this position if the range
-        ///          was fully sorted. All of the elements before this new nth
-        ///          element are less than or equal to the elements after the
-        ///          new nth element.
-        ///
-        /// \param first : iterator to the first element
-        /// \param nth : iterator defining the sort partition point
-        /// \param end : iterator to the element after the last in the range
-        /// \param level : level of depth in the call from the root
-        /// \param comp : object for to Compare elements
-        /// \param proj : projection
-        ///
-        template <class RandomIt, typename Compare, typename Proj>
-        static constexpr void nth_element_seq(RandomIt first, RandomIt nth,
-            RandomIt end, std::uint32_t level, Compare&& comp, Proj&& proj)
-        {
-            std::uint32_t const nmin_sort = 24;
-            auto nelem = end - first;
-
-            // Check  the special conditions
-            if (nth == first)
-            {
-                RandomIt it = detail::min_element<RandomIt>().call(
-                    pika::execution::seq, first, end,
-                    PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
-
-                if (it != first)
-                {
-#if defined(PIKA_HAVE_CXX20_STD_RANGES_ITER_SWAP)
-                    std::ranges::iter_swap(it, first);
-#else
-                    std::iter_swap(it, first);
-#endif
-                }
-
-                return;
-            };
-
-            if (nelem < nmin_sort)
-            {
-                detail::sort<RandomIt>().call(pika::execution::seq, first, end,
-                    PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
-                return;
-            }
-            if (level == 0)
-            {
-                std::make_heap(first, end, comp);
-                std::sort_heap(first, nth, comp);
-                return;
-            };
-
-            // Filter the range and check which part contains the nth element
-            RandomIt c_last = filter(first, end, comp);
-
-            if (c_last == nth)
-                return;
-
-            if (nth < c_last)
-                nth_element_seq(first, nth, c_last, level - 1,
-                    PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
-            else
-                nth_element_seq(c_last + 1, nth, end, level - 1,
-                    PIKA_FORWARD(Compare, comp), PIKA_FORWARD(Proj, proj));
-
-            return;
-        }
-
         template <typename Iter>
         struct nth_element : public detail::algorithm<nth_element<Iter>, Iter>
         {
@@ -261,11 +189,6 @@ namespace pika { namespace parallel { inline namespace v1 {
             parallel(ExPolicy&& policy, RandomIt first, RandomIt nth, Sent last,
                 Pred&& pred, Proj&& proj)
             {
-                using value_type =
-                    typename std::iterator_traits<RandomIt>::value_type;
-
-                RandomIt partitionIter, return_last;
-
                 if (first == last)
                 {
                     return util::detail::algorithm_result<ExPolicy,
@@ -282,49 +205,12 @@ namespace pika { namespace parallel { inline namespace v1 {
                 {
                     RandomIt last_iter =
                         detail::advance_to_sentinel(first, last);
-                    return_last = last_iter;
-
-                    while (first != last_iter)
-                    {
-                        detail::pivot9(first, last_iter, pred);
-
-                        partitionIter =
-                            pika::parallel::v1::detail::partition<RandomIt>()
-                                .call(
-                                    policy(pika::execution::non_task),
-                                    first + 1, last_iter,
-                                    [val = PIKA_INVOKE(proj, *first), &pred](
-                                        value_type const& elem) {
-                                        return PIKA_INVOKE(pred, elem, val);
-                                    },
-                                    proj);
 
-                        --partitionIter;
-                        // swap first element and partitionIter
-                        // (ending element of first group)
-#if defined(PIKA_HAVE_CXX20_STD_RANGES_ITER_SWAP)
-                        std::ranges::iter_swap(first, partitionIter);
-#else
-                        std::iter_swap(first, partitionIter);
-#endif
+                    detail::parallel_nth_element(policy, first, nth, last_iter,
+                        PIKA_FORWARD(Pred, pred), PIKA_FORWARD(Proj, proj));
 
-                        // if nth element < partitioned index,
-                        // it lies in [first, partitionIter)
-                        if (partitionIter < nth)
-                        {
-                            first = partitionIter + 1;
-                        }
-                        // else it lies in [partitionIter + 1, last)
-                        else if (partitionIter > nth)
-                        {
-                            last_iter = partitionIter;
-                        }
-                        // partitionIter == nth
-                        else
-                        {
-                            break;
-                        }
-                    }
+                    return util::detail::algorithm_result<ExPolicy,
+                        RandomIt>::get(PIKA_MOVE(last_iter));
                 }
                 catch (...)
                 {
@@ -332,9 +218,6 @@ namespace pika { namespace parallel { inline namespace v1 {
                         RandomIt>::get(detail::handle_exception<ExPolicy,
                         RandomIt>::call(std::current_exception()));
                 }
-
-                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
-                    PIKA_MOVE(return_last));
             }
         };
         /// \endcond
@@ -119,6 +119,8 @@ namespace pika {
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/distance.hpp>
 #include <pika/parallel/algorithms/detail/is_sorted.hpp>
+#include <pika/parallel/algorithms/detail/nth_element.hpp>
+#include <pika/parallel/algorithms/detail/pivot.hpp>
 #include <pika/parallel/algorithms/sort.hpp>
 #include <pika/parallel/util/compare_projected.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
@@ -187,93 +189,6 @@ namespace pika { namespace parallel { inline namespace v1 {
             return nb;
         }
 
-        ///////////////////////////////////////////////////////////////////////
-        ///
-        /// Receive a range between first and last, obtain 9 values
-        /// between the elements  including the first and the previous
-        /// to the last. Obtain the iterator to the mid value and swap
-        /// with the first position
-        //
-        /// \param first    iterator to the first element
-        /// \param last     iterator to the last element
-        /// \param comp     object to Comp two elements
-        ///
-        template <typename Iter, typename Comp>
-        inline constexpr void pivot3(
-            Iter first, Iter last, Comp&& comp) noexcept
-        {
-            auto N2 = (last - first) >> 1;
-            Iter it_val =
-                mid3(first + 1, first + N2, last - 1, PIKA_FORWARD(Comp, comp));
-#if defined(PIKA_HAVE_CXX20_STD_RANGES_ITER_SWAP)
-            std::ranges::iter_swap(first, it_val);
-#else
-            std::iter_swap(first, it_val);
-#endif
-        }
-
-        ///////////////////////////////////////////////////////////////////////
-        ///
-        /// This function obtain a pivot in the range and filter the elements
-        /// according the value of that pivot
-        ///
-        /// \param first : iterator to the first element
-        /// \param end : iterator to the element after the last
-        /// \param comp : object to Comp two elements
-        ///
-        /// \return iterator where is the pivot used in the filtering
-        ///
-        template <typename Iter, typename Comp>
-        constexpr inline Iter filter(Iter first, Iter end, Comp&& comp)
-        {
-            std::int64_t nelem = (end - first);
-            if (nelem > 4096)
-            {
-                pivot9(first, end, comp);
-            }
-            else
-            {
-                pivot3(first, end, comp);
-            }
-
-            typename std::iterator_traits<Iter>::value_type const& pivot =
-                *first;
-
-            Iter c_first = first + 1, c_last = end - 1;
-            while (PIKA_INVOKE(comp, *c_first, pivot))
-            {
-                ++c_first;
-            }
-            while (PIKA_INVOKE(comp, pivot, *c_last))
-            {
-                --c_last;
-            }
-
-            while (c_first < c_last)
-            {
-#if defined(PIKA_HAVE_CXX20_STD_RANGES_ITER_SWAP)
-                std::ranges::iter_swap(c_first++, c_last--);
-#else
-                std::iter_swap(c_first++, c_last--);
-#endif
-                while (PIKA_INVOKE(comp, *c_first, pivot))
-                {
-                    ++c_first;
-                }
-                while (PIKA_INVOKE(comp, pivot, *c_last))
-                {
-                    --c_last;
-                }
-            }
-
-#if defined(PIKA_HAVE_CXX20_STD_RANGES_ITER_SWAP)
-            std::ranges::iter_swap(first, c_last);
-#else
-            std::iter_swap(first, c_last);
-#endif
-            return c_last;
-        }
-
         ///////////////////////////////////////////////////////////////////////
         ///
         /// Internal function to divide and sort the ranges
@@ -340,106 +255,6 @@ namespace pika { namespace parallel { inline namespace v1 {
             recursive_partial_sort(
                 first, middle, c_last, level - 1, PIKA_FORWARD(Comp, comp));
         }
-
-        ///////////////////////////////////////////////////////////////////////
-        ///
-        /// Internal function to divide and sort the ranges
-        ///
-        /// \param first : iterator to the first element
-        /// \param middle: iterator defining the last element to be sorted
-        /// \param end : iterator to the element after the end in the range
-        /// \param level : level of depth from the top level call
-        /// \param comp : object for to Comp elements
-        ///
-        struct sort_thread_helper
-        {
-            template <typename... Ts>
-            decltype(auto) operator()(Ts&&... ts) const
-            {
-                return sort_thread(PIKA_FORWARD(Ts, ts)...);
-            }
-        };
-
-        template <typename ExPolicy, typename Iter, typename Comp>
-        pika::future<Iter> parallel_partial_sort(ExPolicy&& policy, Iter first,
-            Iter middle, Iter last, std::uint32_t level, Comp&& comp = Comp());
-
-        struct parallel_partial_sort_helper
-        {
-            template <typename... Ts>
-            decltype(auto) operator()(Ts&&... ts) const
-            {
-                return parallel_partial_sort(PIKA_FORWARD(Ts, ts)...);
-            }
-        };
-
-        template <typename ExPolicy, typename Iter, typename Comp>
-        pika::future<Iter> parallel_partial_sort(ExPolicy&& policy, Iter first,
-            Iter middle, Iter last, std::uint32_t level, Comp&& comp)
-        {
-            std::int64_t nelem = last - first;
-            std::int64_t nmid = middle - first;
-            PIKA_ASSERT(nelem >= nmid);
-
-            if (nelem == 0 || nmid == 0)
-            {
-                return pika::make_ready_future(last);
-            }
-
-            if (nmid < 4096 || level < 12)
-            {
-                recursive_partial_sort(first, middle, last, level, comp);
-                return pika::make_ready_future(last);
-            }
-
-            Iter c_last = filter(first, last, comp);
-            if (middle >= c_last)
-            {
-                // figure out the chunk size to use
-                std::size_t const cores = execution::processing_units_count(
-                    policy.parameters(), policy.executor());
-
-                // number of elements to sort
-                std::size_t chunk_size = execution::get_chunk_size(
-                    policy.parameters(), policy.executor(), 0, cores, nelem);
-
-                pika::future<Iter> left = execution::async_execute(
-                    policy.executor(), sort_thread_helper(), policy, first,
-                    c_last, comp, chunk_size);
-
-                pika::future<Iter> right;
-                if (middle != c_last)
-                {
-                    right = execution::async_execute(policy.executor(),
-                        parallel_partial_sort_helper(), policy, c_last + 1,
-                        middle, last, level - 1, comp);
-                }
-                else
-                {
-                    right = pika::make_ready_future(last);
-                }
-
-                return pika::dataflow(
-                    [last](pika::future<Iter>&& left,
-                        pika::future<Iter>&& right) -> Iter {
-                        if (left.has_exception() || right.has_exception())
-                        {
-                            std::list<std::exception_ptr> errors;
-                            if (left.has_exception())
-                                errors.push_back(left.get_exception_ptr());
-                            if (right.has_exception())
-                                errors.push_back(right.get_exception_ptr());
-
-                            throw exception_list(PIKA_MOVE(errors));
-                        }
-                        return last;
-                    },
-                    PIKA_MOVE(left), PIKA_MOVE(right));
-            }
-
-            return parallel_partial_sort(PIKA_FORWARD(ExPolicy, policy), first,
-                middle, c_last, level - 1, PIKA_FORWARD(Comp, comp));
-        }
         /// \endcond NOINTERNAL
     }    // end namespace detail
 
@@ -506,9 +321,34 @@ namespace pika { namespace parallel { inline namespace v1 {
             }
         }
 
-        std::uint32_t level = parallel::v1::detail::nbits64(nelem) * 2;
-        return detail::parallel_partial_sort(PIKA_FORWARD(ExPolicy, policy),
-            first, middle, first + nelem, level, PIKA_FORWARD(Comp, comp));
+        Iter last = first + nelem;
+        if (nmid == 0)
+        {
+            return pika::make_ready_future(last);
+        }
+
+        if (std::size_t(nelem) <= detail::nth_element_sequential_limit)
+        {
+            std::uint32_t level = detail::nbits64(nelem) * 2;
+            detail::recursive_partial_sort(
+                first, middle, last, level, PIKA_FORWARD(Comp, comp));
+            return pika::make_ready_future(last);
+        }
+
+        // move the nmid smallest elements to the front, then sort those
+        if (middle != last)
+        {
+            detail::parallel_nth_element(policy, first, middle, last, comp,
+                util::projection_identity{});
+        }
+
+        return pika::dataflow(
+            [last](pika::future<Iter>&& f) -> Iter {
+                f.get();
+                return last;
+            },
+            detail::parallel_sort_async(PIKA_FORWARD(ExPolicy, policy), first,
+                middle, PIKA_FORWARD(Comp, comp)));
     }
 
     ///////////////////////////////////////////////////////////////////////
@@ -224,6 +224,7 @@ namespace pika {
 #include <pika/parallel/algorithms/detail/accumulate.hpp>
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/distance.hpp>
+#include <pika/parallel/algorithms/detail/reduce.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/loop.hpp>
 #include <pika/parallel/util/partitioner.hpp>
@@ -254,8 +255,8 @@ namespace pika { namespace parallel { inline namespace v1 {
             static T sequential(
                 ExPolicy, InIterB first, InIterE last, T_&& init, Reduce&& r)
             {
-                return detail::accumulate(first, last, PIKA_FORWARD(T_, init),
-                    PIKA_FORWARD(Reduce, r));
+                return sequential_reduce<ExPolicy>(first, last,
+                    T(PIKA_FORWARD(T_, init)), PIKA_FORWARD(Reduce, r));
             }
 
             template <typename ExPolicy, typename FwdIterB, typename FwdIterE,
@@ -272,7 +273,7 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 auto f1 = [r](FwdIterB part_begin, std::size_t part_size) -> T {
                     T val = *part_begin;
-                    return util::accumulate_n(
+                    return sequential_reduce_n<ExPolicy>(
                         ++part_begin, --part_size, PIKA_MOVE(val), r);
                 };
 
@@ -212,8 +212,8 @@ namespace pika {
 #include <pika/concepts/concepts.hpp>
 #include <pika/functional/invoke.hpp>
 #include <pika/iterator_support/traits/is_iterator.hpp>
+#include <pika/iterator_support/counting_iterator.hpp>
 #include <pika/parallel/util/detail/sender_util.hpp>
-#include <pika/type_support/unused.hpp>
 
 #include <pika/algorithms/traits/projected.hpp>
 #include <pika/execution/algorithms/detail/is_negative.hpp>
@@ -222,6 +222,7 @@ namespace pika {
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/find.hpp>
 #include <pika/parallel/algorithms/detail/transfer.hpp>
+#include <pika/parallel/util/compaction_mask.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/foreach_partitioner.hpp>
 #include <pika/parallel/util/invoke_projected.hpp>
@@ -231,10 +232,6 @@ namespace pika {
 #include <pika/parallel/util/transfer.hpp>
 #include <pika/parallel/util/zip_iterator.hpp>
 
-#if !defined(PIKA_HAVE_CXX17_SHARED_PTR_ARRAY)
-#include <boost/shared_array.hpp>
-#endif
-
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
@@ -288,7 +285,8 @@ namespace pika { namespace parallel { inline namespace v1 {
             parallel(ExPolicy&& policy, Iter first, Sent last, Pred&& pred,
                 Proj&& proj)
             {
-                typedef pika::util::zip_iterator<Iter, bool*> zip_iterator;
+                using zip_iterator = pika::util::zip_iterator<Iter,
+                    pika::util::counting_iterator<std::size_t>>;
                 typedef util::detail::algorithm_result<ExPolicy, Iter>
                     algorithm_result;
                 typedef typename std::iterator_traits<Iter>::difference_type
@@ -299,11 +297,7 @@ namespace pika { namespace parallel { inline namespace v1 {
                 if (count == 0)
                     return algorithm_result::get(PIKA_MOVE(first));
 
-#if defined(PIKA_HAVE_CXX17_SHARED_PTR_ARRAY)
-                std::shared_ptr<bool[]> flags(new bool[count]);
-#else
-                boost::shared_array<bool> flags(new bool[count]);
-#endif
+                util::compaction_mask mask(count);
                 std::size_t init = 0u;
 
                 using pika::get;
@@ -314,17 +308,15 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 // Note: replacing the invoke() with PIKA_INVOKE()
                 // below makes gcc generate errors
-                auto f1 = [pred = PIKA_FORWARD(Pred, pred),
+                auto f1 = [mask, pred = PIKA_FORWARD(Pred, pred),
                               proj = PIKA_FORWARD(Proj, proj)](
                               zip_iterator part_begin,
-                              std::size_t part_size) -> std::size_t {
-                    // MSVC complains if pred or proj is captured by ref below
-                    util::loop_n<std::decay_t<ExPolicy>>(part_begin, part_size,
-                        [pred, proj](zip_iterator it) mutable {
-                            bool f = pika::util::invoke(
-                                pred, pika::util::invoke(proj, get<0>(*it)));
-
-                            get<1>(*it) = f;
+                              std::size_t part_size) mutable -> std::size_t {
+                    Iter it = get<0>(part_begin.get_iterator_tuple());
+                    mask.set(*get<1>(part_begin.get_iterator_tuple()),
+                        part_size, [&]() -> bool {
+                            return !pika::util::invoke(
+                                pred, pika::util::invoke(proj, *it++));
                         });
 
                     // There is no need to return the partition result.
@@ -344,50 +336,34 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 std::shared_ptr<Iter> dest_ptr = std::make_shared<Iter>(first);
                 auto f3 =
-                    [dest_ptr, flags](zip_iterator part_begin,
+                    [dest_ptr, mask](zip_iterator part_begin,
                         std::size_t part_size,
                         pika::shared_future<std::size_t> curr,
                         pika::shared_future<std::size_t> next) mutable -> void {
-                    PIKA_UNUSED(flags);
-
                     curr.get();    // rethrow exceptions
                     next.get();    // rethrow exceptions
 
                     Iter& dest = *dest_ptr;
-
-                    using execution_policy_type = std::decay_t<ExPolicy>;
-                    if (dest == get<0>(part_begin.get_iterator_tuple()))
-                    {
-                        // Self-assignment must be detected.
-                        util::loop_n<execution_policy_type>(
-                            part_begin, part_size, [&dest](zip_iterator it) {
-                                if (!get<1>(*it))
-                                {
-                                    if (dest != get<0>(it.get_iterator_tuple()))
-                                        *dest++ = PIKA_MOVE(get<0>(*it));
-                                    else
-                                        ++dest;
-                                }
-                            });
-                    }
-                    else
-                    {
-                        // Self-assignment can't be performed.
-                        util::loop_n<execution_policy_type>(
-                            part_begin, part_size, [&dest](zip_iterator it) {
-                                if (!get<1>(*it))
-                                    *dest++ = PIKA_MOVE(get<0>(*it));
-                            });
-                    }
+                    Iter it = get<0>(part_begin.get_iterator_tuple());
+                    std::size_t pos = 0;
+
+                    mask.for_each_set(*get<1>(part_begin.get_iterator_tuple()),
+                        part_size, [&](std::size_t i) {
+                            std::advance(it, i - pos);
+                            pos = i;
+
+                            // Self-assignment must be detected.
+                            if (dest != it)
+                                *dest = PIKA_MOVE(*it);
+                            ++dest;
+                        });
                 };
 
                 auto f4 =
-                    [dest_ptr, flags](
+                    [dest_ptr](
                         std::vector<pika::shared_future<std::size_t>>&& items,
                         std::vector<pika::future<void>>&& data) mutable
                     -> Iter {
-                    PIKA_UNUSED(flags);
-
                     // make sure iterators embedded in function object that is
                     // attached to futures are invalidated
                     items.clear();
@@ -398,7 +374,9 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 return scan_partitioner_type::call(
                     PIKA_FORWARD(ExPolicy, policy),
-                    make_zip_iterator(first, flags.get()), count, init,
+                    make_zip_iterator(first,
+                        pika::util::make_counting_iterator(std::size_t(0))),
+                    count, init,
                     // step 1 performs first part of scan algorithm
                     PIKA_MOVE(f1),
                     // step 2 propagates the partition results from left
@@ -244,6 +244,7 @@ namespace pika {
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/is_sorted.hpp>
 #include <pika/parallel/algorithms/detail/pivot.hpp>
+#include <pika/parallel/algorithms/detail/radix_sort.hpp>
 #include <pika/parallel/util/compare_projected.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/detail/chunk_size.hpp>
@@ -412,6 +413,39 @@ namespace pika { namespace parallel { inline namespace v1 {
                 PIKA_FORWARD(Comp, comp), chunk_size);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Sorts arithmetic keys using the parallel radix sort, falls back to
+        // the comparison sort if there is not enough memory available for
+        // the temporary buffer.
+        template <typename Traits, typename ExPolicy, typename RandomIt,
+            typename Comp>
+        pika::future<RandomIt> parallel_radix_sort_async(
+            ExPolicy&& policy, RandomIt first, RandomIt last, Comp&& comp)
+        {
+            auto f = [policy, first, last,
+                         comp = PIKA_FORWARD(Comp, comp)]() mutable
+                -> RandomIt {
+                if (!parallel_radix_sort<Traits>(policy, first, last))
+                {
+                    parallel_sort_async(
+                        PIKA_MOVE(policy), first, last, PIKA_MOVE(comp))
+                        .get();
+                }
+                return last;
+            };
+
+            if constexpr (pika::is_async_execution_policy_v<
+                              std::decay_t<ExPolicy>>)
+            {
+                return execution::async_execute(
+                    policy.executor(), PIKA_MOVE(f));
+            }
+            else
+            {
+                return pika::make_ready_future(f());
+            }
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // sort
         template <typename RandomIt>
@@ -446,6 +480,28 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 try
                 {
+                    // use the radix sort for arithmetic keys compared using
+                    // operator<
+                    using radix_traits =
+                        radix_sort_traits<RandomIt, std::decay_t<Proj>>;
+                    if constexpr (radix_traits::value)
+                    {
+                        if constexpr (is_radix_sort_compare_v<
+                                          std::decay_t<Comp>,
+                                          typename radix_traits::key_type>)
+                        {
+                            if (std::size_t(last - first) >= radix_sort_limit)
+                            {
+                                return algorithm_result::get(
+                                    parallel_radix_sort_async<radix_traits>(
+                                        PIKA_FORWARD(ExPolicy, policy), first,
+                                        last,
+                                        util::compare_projected<Comp&, Proj&>(
+                                            comp, proj)));
+                            }
+                        }
+                    }
+
                     // call the sort routine and return the right type,
                     // depending on execution policy
                     return algorithm_result::get(parallel_sort_async(
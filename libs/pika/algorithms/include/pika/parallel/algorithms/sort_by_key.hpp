@@ -10,11 +10,15 @@
 #include <pika/config.hpp>
 #include <pika/datastructures/tuple.hpp>
 
+#include <pika/parallel/algorithms/detail/radix_sort.hpp>
 #include <pika/parallel/algorithms/sort.hpp>
 #include <pika/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -36,6 +40,57 @@ namespace pika { namespace parallel { inline namespace v1 {
                 return pika::get<0>(PIKA_FORWARD(Tuple, t));
             }
         };
+
+        // Arithmetic keys are radix sorted, the values are moved along with
+        // the keys. The temporary buffer holds separate arrays of keys and
+        // values, which requires the values to be trivial types.
+        template <typename KeyIter, typename ValueIter>
+        struct radix_sort_traits<pika::util::zip_iterator<KeyIter, ValueIter>,
+            extract_key,
+            std::enable_if_t<is_radix_sortable_key_v<typename std::
+                                     iterator_traits<KeyIter>::value_type> &&
+                std::is_trivial_v<
+                    typename std::iterator_traits<ValueIter>::value_type>>>
+          : std::true_type
+        {
+            using key_type = typename std::iterator_traits<KeyIter>::value_type;
+            using value_type =
+                typename std::iterator_traits<ValueIter>::value_type;
+
+            template <typename Tuple>
+            typename radix_key<key_type>::type operator()(
+                Tuple const& t) const noexcept
+            {
+                return radix_key<key_type>::encode(pika::get<0>(t));
+            }
+
+            struct buffer
+            {
+                std::unique_ptr<key_type[]> keys_;
+                std::unique_ptr<value_type[]> values_;
+
+                explicit operator bool() const noexcept
+                {
+                    return keys_ != nullptr && values_ != nullptr;
+                }
+
+                pika::util::zip_iterator<key_type*, value_type*> begin()
+                    const noexcept
+                {
+                    return pika::util::make_zip_iterator(
+                        keys_.get(), values_.get());
+                }
+            };
+
+            static buffer allocate(std::size_t count)
+            {
+                return buffer{
+                    std::unique_ptr<key_type[]>(
+                        new (std::nothrow) key_type[count]),
+                    std::unique_ptr<value_type[]>(
+                        new (std::nothrow) value_type[count])};
+            }
+        };
         /// \endcond
     }    // namespace detail
 
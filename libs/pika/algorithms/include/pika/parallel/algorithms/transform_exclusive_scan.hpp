@@ -346,7 +346,8 @@ namespace pika { namespace parallel { inline namespace v1 {
                         });
                 };
 
-                return util::scan_partitioner<ExPolicy, result_type, T>::call(
+                return util::scan_partitioner<ExPolicy, result_type, T, void,
+                    util::scan_partitioner_single_pass_tag>::call(
                     PIKA_FORWARD(ExPolicy, policy),
                     make_zip_iterator(first, dest), count, init,
                     // step 1 performs first part of scan algorithm
@@ -263,9 +263,9 @@ namespace pika {
 
 #include <pika/execution/algorithms/detail/predicates.hpp>
 #include <pika/executors/execution_policy.hpp>
-#include <pika/parallel/algorithms/detail/accumulate.hpp>
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/distance.hpp>
+#include <pika/parallel/algorithms/detail/reduce.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/loop.hpp>
 #include <pika/parallel/util/partitioner.hpp>
@@ -334,17 +334,9 @@ namespace pika { namespace parallel { inline namespace v1 {
             PIKA_HOST_DEVICE PIKA_FORCEINLINE T operator()(
                 Iter part_begin, std::size_t part_size)
             {
-                using reference =
-                    typename std::iterator_traits<Iter>::reference;
-
                 T val = PIKA_INVOKE(convert_, *part_begin);
-                return util::accumulate_n(++part_begin, --part_size,
-                    PIKA_MOVE(val),
-                    [PIKA_CXX20_CAPTURE_THIS(=)](
-                        T const& res, reference next) mutable -> T {
-                        return PIKA_INVOKE(
-                            reduce_, res, PIKA_INVOKE(convert_, next));
-                    });
+                return sequential_reduce_n<execution_policy_type>(++part_begin,
+                    --part_size, PIKA_MOVE(val), reduce_, convert_);
             }
         };
 
@@ -362,13 +354,9 @@ namespace pika { namespace parallel { inline namespace v1 {
             static T sequential(ExPolicy, Iter first, Sent last, T_&& init,
                 Reduce&& r, Convert&& conv)
             {
-                using value_type =
-                    typename std::iterator_traits<Iter>::value_type;
-
-                return detail::accumulate(first, last, PIKA_FORWARD(T_, init),
-                    [&r, &conv](T const& res, value_type const& next) -> T {
-                        return PIKA_INVOKE(r, res, PIKA_INVOKE(conv, next));
-                    });
+                return sequential_reduce<ExPolicy>(first, last,
+                    T(PIKA_FORWARD(T_, init)), PIKA_FORWARD(Reduce, r),
+                    PIKA_FORWARD(Convert, conv));
             }
 
             template <typename ExPolicy, typename Iter, typename Sent,
@@ -407,37 +395,6 @@ namespace pika { namespace parallel { inline namespace v1 {
     // transform_reduce_binary
     namespace detail {
 
-        template <typename F>
-        struct transform_reduce_binary_indirect
-        {
-            F f_;
-
-            template <typename Iter1, typename Iter2>
-            PIKA_HOST_DEVICE PIKA_FORCEINLINE constexpr auto operator()(
-                Iter1 it1, Iter2 it2) -> decltype(PIKA_INVOKE(f_, *it1, *it2))
-            {
-                return PIKA_INVOKE(f_, *it1, *it2);
-            }
-        };
-
-        template <typename Op1, typename Op2, typename T>
-        struct transform_reduce_binary_partition
-        {
-            typedef typename std::decay<T>::type value_type;
-
-            Op1 op1_;
-            Op2 op2_;
-            value_type& part_sum_;
-
-            template <typename Iter1, typename Iter2>
-            PIKA_HOST_DEVICE PIKA_FORCEINLINE constexpr void operator()(
-                Iter1 it1, Iter2 it2)
-            {
-                part_sum_ =
-                    PIKA_INVOKE(op1_, part_sum_, PIKA_INVOKE(op2_, *it1, *it2));
-            }
-        };
-
         template <typename T>
         struct transform_reduce_binary
           : public detail::algorithm<transform_reduce_binary<T>, T>
@@ -452,51 +409,9 @@ namespace pika { namespace parallel { inline namespace v1 {
             static T sequential(ExPolicy&& /* policy */, Iter first1,
                 Sent last1, Iter2 first2, T_ init, Op1&& op1, Op2&& op2)
             {
-                if (first1 == last1)
-                {
-                    return init;
-                }
-
-                // check whether we should apply vectorization
-                if (!util::loop_optimization<ExPolicy>(first1, last1))
-                {
-                    util::loop2<ExPolicy>(std::false_type(), first1, last1,
-                        first2,
-                        transform_reduce_binary_partition<Op1, Op2, T>{
-                            PIKA_FORWARD(Op1, op1), PIKA_FORWARD(Op2, op2),
-                            init});
-                    return init;
-                }
-
-                // loop_step properly advances the iterators
-                auto part_sum = util::loop_step<ExPolicy>(std::true_type(),
-                    transform_reduce_binary_indirect<Op2>{op2}, first1, first2);
-
-                std::pair<Iter, Iter2> p = util::loop2<ExPolicy>(
-                    std::true_type(), first1, last1, first2,
-                    transform_reduce_binary_partition<Op1, Op2,
-                        decltype(part_sum)>{op1, op2, part_sum});
-
-                // this is to support vectorization, it will call op1 for each
-                // of the elements of a value-pack
-                auto result = util::detail::accumulate_values<ExPolicy>(
-                    [&op1](T const& sum, T&& val) -> T {
-                        return PIKA_INVOKE(op1, sum, val);
-                    },
-                    PIKA_MOVE(part_sum), PIKA_MOVE(init));
-
-                // the vectorization might not cover all of the sequences,
-                // handle the remainder directly
-                if (p.first != last1)
-                {
-                    util::loop2<ExPolicy>(std::false_type(), p.first, last1,
-                        p.second,
-                        transform_reduce_binary_partition<Op1, Op2,
-                            decltype(result)>{PIKA_FORWARD(Op1, op1),
-                            PIKA_FORWARD(Op2, op2), result});
-                }
-
-                return util::detail::extract_value<ExPolicy>(result);
+                return sequential_reduce<ExPolicy>(first1, last1, first2,
+                    T(PIKA_MOVE(init)), PIKA_FORWARD(Op1, op1),
+                    PIKA_FORWARD(Op2, op2));
             }
 
             template <typename ExPolicy, typename Iter, typename Sent,
@@ -527,52 +442,9 @@ namespace pika { namespace parallel { inline namespace v1 {
                     Iter last1 = it1;
                     std::advance(last1, part_size);
 
-                    if (!util::loop_optimization<ExPolicy>(it1, last1))
-                    {
-                        // loop_step properly advances the iterators
-                        auto result =
-                            util::loop_step<ExPolicy>(std::false_type(),
-                                transform_reduce_binary_indirect<Op2>{op2}, it1,
-                                it2);
-
-                        util::loop2<ExPolicy>(std::false_type(), it1, last1,
-                            it2,
-                            transform_reduce_binary_partition<Op1, Op2,
-                                decltype(result)>{PIKA_FORWARD(Op1, op1),
-                                PIKA_FORWARD(Op2, op2), result});
-
-                        return util::detail::extract_value<ExPolicy>(result);
-                    }
-
-                    // loop_step properly advances the iterators
-                    auto part_sum = util::loop_step<ExPolicy>(std::true_type(),
-                        transform_reduce_binary_indirect<Op2>{op2}, it1, it2);
-
-                    std::pair<Iter, Iter2> p =
-                        util::loop2<ExPolicy>(std::true_type(), it1, last1, it2,
-                            transform_reduce_binary_partition<Op1, Op2,
-                                decltype(part_sum)>{op1, op2, part_sum});
-
-                    // this is to support vectorization, it will call op1
-                    // for each of the elements of a value-pack
-                    auto result = util::detail::accumulate_values<ExPolicy>(
-                        [&op1](T const& sum, T&& val) -> T {
-                            return PIKA_INVOKE(op1, sum, val);
-                        },
-                        part_sum);
-
-                    // the vectorization might not cover all of the sequences,
-                    // handle the remainder directly
-                    if (p.first != last1)
-                    {
-                        util::loop2<ExPolicy>(std::false_type(), p.first, last1,
-                            p.second,
-                            transform_reduce_binary_partition<Op1, Op2,
-                                decltype(result)>{PIKA_FORWARD(Op1, op1),
-                                PIKA_FORWARD(Op2, op2), result});
-                    }
-
-                    return util::detail::extract_value<ExPolicy>(result);
+                    T val = PIKA_INVOKE(op2, *it1, *it2);
+                    return sequential_reduce<ExPolicy>(
+                        ++it1, last1, ++it2, PIKA_MOVE(val), op1, op2);
                 };
 
                 using pika::util::make_zip_iterator;
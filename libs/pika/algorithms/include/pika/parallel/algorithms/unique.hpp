@@ -461,8 +461,8 @@ namespace pika {
 #include <pika/config.hpp>
 #include <pika/concepts/concepts.hpp>
 #include <pika/functional/invoke.hpp>
+#include <pika/iterator_support/counting_iterator.hpp>
 #include <pika/iterator_support/traits/is_iterator.hpp>
-#include <pika/type_support/unused.hpp>
 
 #include <pika/algorithms/traits/projected.hpp>
 #include <pika/execution/algorithms/detail/is_negative.hpp>
@@ -472,6 +472,7 @@ namespace pika {
 #include <pika/parallel/algorithms/detail/dispatch.hpp>
 #include <pika/parallel/algorithms/detail/distance.hpp>
 #include <pika/parallel/algorithms/detail/transfer.hpp>
+#include <pika/parallel/util/compaction_mask.hpp>
 #include <pika/parallel/util/detail/algorithm_result.hpp>
 #include <pika/parallel/util/detail/sender_util.hpp>
 #include <pika/parallel/util/foreach_partitioner.hpp>
@@ -481,10 +482,6 @@ namespace pika {
 #include <pika/parallel/util/transfer.hpp>
 #include <pika/parallel/util/zip_iterator.hpp>
 
-#if !defined(PIKA_HAVE_CXX17_SHARED_PTR_ARRAY)
-#include <boost/shared_array.hpp>
-#endif
-
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
@@ -552,7 +549,8 @@ namespace pika { namespace parallel { inline namespace v1 {
                 parallel(ExPolicy&& policy, FwdIter first, Sent last,
                     Pred&& pred, Proj&& proj)
             {
-                using zip_iterator = pika::util::zip_iterator<FwdIter, bool*>;
+                using zip_iterator = pika::util::zip_iterator<FwdIter,
+                    pika::util::counting_iterator<std::size_t>>;
                 using algorithm_result =
                     util::detail::algorithm_result<ExPolicy, FwdIter>;
                 using difference_type =
@@ -566,14 +564,11 @@ namespace pika { namespace parallel { inline namespace v1 {
                     return algorithm_result::get(PIKA_MOVE(first));
                 }
 
-#if defined(PIKA_HAVE_CXX17_SHARED_PTR_ARRAY)
-                std::shared_ptr<bool[]> flags(new bool[count]);
-#else
-                boost::shared_array<bool> flags(new bool[count]);
-#endif
+                util::compaction_mask mask(count);
                 std::size_t init = 0u;
 
-                flags[0] = false;
+                // the first element is always kept
+                mask.set(0, 1, []() { return true; });
 
                 using pika::get;
                 using pika::util::make_zip_iterator;
@@ -581,25 +576,25 @@ namespace pika { namespace parallel { inline namespace v1 {
                     util::scan_partitioner<ExPolicy, FwdIter, std::size_t, void,
                         util::scan_partitioner_sequential_f3_tag>;
 
-                auto f1 = [pred = PIKA_FORWARD(Pred, pred),
+                // Every partition marks the elements following its elements
+                // in the mask, i.e. [part_begin + 1, part_begin + part_size].
+                auto f1 = [mask, pred = PIKA_FORWARD(Pred, pred),
                               proj = PIKA_FORWARD(Proj, proj)](
                               zip_iterator part_begin,
-                              std::size_t part_size) -> std::size_t {
+                              std::size_t part_size) mutable -> std::size_t {
                     FwdIter base = get<0>(part_begin.get_iterator_tuple());
+                    FwdIter it = base;
 
                     // Note: replacing the invoke() with PIKA_INVOKE()
                     // below makes gcc generate errors
-
-                    // MSVC complains if pred or proj is captured by ref below
-                    util::loop_n<std::decay_t<ExPolicy>>(++part_begin,
-                        part_size,
-                        [base, pred, proj](zip_iterator it) mutable -> void {
-                            bool f = pika::util::invoke(pred,
+                    mask.set(*get<1>(part_begin.get_iterator_tuple()) + 1,
+                        part_size, [&]() -> bool {
+                            bool const f = pika::util::invoke(pred,
                                 pika::util::invoke(proj, *base),
-                                pika::util::invoke(proj, get<0>(*it)));
-
-                            if (!(get<1>(*it) = f))
-                                base = get<0>(it.get_iterator_tuple());
+                                pika::util::invoke(proj, *++it));
+                            if (!f)
+                                base = it;
+                            return !f;
                         });
 
                     // There is no need to return the partition result.
@@ -611,45 +606,31 @@ namespace pika { namespace parallel { inline namespace v1 {
                 std::shared_ptr<FwdIter> dest_ptr =
                     std::make_shared<FwdIter>(first);
                 auto f3 =
-                    [dest_ptr, flags](zip_iterator part_begin,
+                    [dest_ptr, mask](zip_iterator part_begin,
                         std::size_t part_size,
                         pika::shared_future<std::size_t> curr,
                         pika::shared_future<std::size_t> next) mutable -> void {
-                    PIKA_UNUSED(flags);
-
                     curr.get();    // rethrow exceptions
                     next.get();    // rethrow exceptions
 
                     FwdIter& dest = *dest_ptr;
-
-                    using execution_policy_type = std::decay_t<ExPolicy>;
-                    if (dest == get<0>(part_begin.get_iterator_tuple()))
-                    {
-                        // Self-assignment must be detected.
-                        util::loop_n<execution_policy_type>(
-                            part_begin, part_size, [&dest](zip_iterator it) {
-                                if (!get<1>(*it))
-                                {
-                                    if (dest != get<0>(it.get_iterator_tuple()))
-                                        *dest++ = PIKA_MOVE(get<0>(*it));
-                                    else
-                                        ++dest;
-                                }
-                            });
-                    }
-                    else
-                    {
-                        // Self-assignment can't be performed.
-                        util::loop_n<execution_policy_type>(
-                            part_begin, part_size, [&dest](zip_iterator it) {
-                                if (!get<1>(*it))
-                                    *dest++ = PIKA_MOVE(get<0>(*it));
-                            });
-                    }
+                    FwdIter it = get<0>(part_begin.get_iterator_tuple());
+                    std::size_t pos = 0;
+
+                    mask.for_each_set(*get<1>(part_begin.get_iterator_tuple()),
+                        part_size, [&](std::size_t i) {
+                            std::advance(it, i - pos);
+                            pos = i;
+
+                            // Self-assignment must be detected.
+                            if (dest != it)
+                                *dest = PIKA_MOVE(*it);
+                            ++dest;
+                        });
                 };
 
                 auto f4 =
-                    [dest_ptr = PIKA_MOVE(dest_ptr), first, count, flags](
+                    [dest_ptr = PIKA_MOVE(dest_ptr), first, count, mask](
                         std::vector<pika::shared_future<std::size_t>>&& items,
                         std::vector<pika::future<void>>&& data) mutable
                     -> FwdIter {
@@ -658,7 +639,7 @@ namespace pika { namespace parallel { inline namespace v1 {
                     items.clear();
                     data.clear();
 
-                    if (!flags[count - 1])
+                    if (mask.test(count - 1))
                     {
                         std::advance(first, count - 1);
                         if (first != (*dest_ptr))
@@ -671,7 +652,9 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 return scan_partitioner_type::call(
                     PIKA_FORWARD(ExPolicy, policy),
-                    make_zip_iterator(first, flags.get()), count - 1, init,
+                    make_zip_iterator(first,
+                        pika::util::make_counting_iterator(std::size_t(0))),
+                    count - 1, init,
                     // step 1 performs first part of scan algorithm
                     PIKA_MOVE(f1),
                     // step 2 propagates the partition results from left
@@ -792,7 +775,8 @@ namespace pika { namespace parallel { inline namespace v1 {
             parallel(ExPolicy&& policy, FwdIter1 first, Sent last,
                 FwdIter2 dest, Pred&& pred, Proj&& proj)
             {
-                using zip_iterator = pika::util::zip_iterator<FwdIter1, bool*>;
+                using zip_iterator = pika::util::zip_iterator<FwdIter1,
+                    pika::util::counting_iterator<std::size_t>>;
                 using algorithm_result =
                     util::detail::algorithm_result<ExPolicy,
                         unique_copy_result<FwdIter1, FwdIter2>>;
@@ -818,58 +802,56 @@ namespace pika { namespace parallel { inline namespace v1 {
                         PIKA_MOVE(++first), PIKA_MOVE(dest)});
                 }
 
-#if defined(PIKA_HAVE_CXX17_SHARED_PTR_ARRAY)
-                std::shared_ptr<bool[]> flags(new bool[count - 1]);
-#else
-                boost::shared_array<bool> flags(new bool[count - 1]);
-#endif
+                util::compaction_mask mask(count);
                 std::size_t init = 0;
 
                 using pika::get;
                 using pika::util::make_zip_iterator;
                 using scan_partitioner_type = util::scan_partitioner<ExPolicy,
-                    unique_copy_result<FwdIter1, FwdIter2>, std::size_t>;
-
-                auto f1 = [pred = PIKA_FORWARD(Pred, pred),
+                    unique_copy_result<FwdIter1, FwdIter2>, std::size_t, void,
+                    util::scan_partitioner_single_pass_tag>;
+
+                // Every partition marks the elements following its elements
+                // in the mask, i.e. [part_begin + 1, part_begin + part_size],
+                // and copies them once the number of elements copied by the
+                // preceding partitions is known.
+                auto f1 = [mask, pred = PIKA_FORWARD(Pred, pred),
                               proj = PIKA_FORWARD(Proj, proj)](
                               zip_iterator part_begin,
                               std::size_t part_size) -> std::size_t {
                     FwdIter1 base = get<0>(part_begin.get_iterator_tuple());
-                    std::size_t curr = 0;
-
-                    // MSVC complains if pred or proj is captured by ref below
-                    util::loop_n<std::decay_t<ExPolicy>>(
-                        ++part_begin, part_size, [&](zip_iterator it) mutable {
-                            bool f = PIKA_INVOKE(pred, PIKA_INVOKE(proj, *base),
-                                PIKA_INVOKE(proj, get<0>(*it)));
-
-                            if (!(get<1>(*it) = f))
-                            {
-                                base = get<0>(it.get_iterator_tuple());
-                                ++curr;
-                            }
+                    FwdIter1 it = base;
+
+                    return mask.set(
+                        *get<1>(part_begin.get_iterator_tuple()) + 1,
+                        part_size, [&]() -> bool {
+                            bool const f = PIKA_INVOKE(pred,
+                                PIKA_INVOKE(proj, *base),
+                                PIKA_INVOKE(proj, *++it));
+                            if (!f)
+                                base = it;
+                            return !f;
                         });
-
-                    return curr;
                 };
-                auto f3 = [dest, flags](zip_iterator part_begin,
-                              std::size_t part_size,
-                              std::size_t val) mutable -> void {
-                    PIKA_UNUSED(flags);
-                    std::advance(dest, val);
-                    util::loop_n<std::decay_t<ExPolicy>>(++part_begin,
-                        part_size, [&dest](zip_iterator it) mutable {
-                            if (!get<1>(*it))
-                                *dest++ = get<0>(*it);
+                auto f3 = [dest, mask](zip_iterator part_begin,
+                              std::size_t part_size, std::size_t val) -> void {
+                    FwdIter1 it = get<0>(part_begin.get_iterator_tuple());
+                    std::size_t pos = 0;
+
+                    FwdIter2 out = dest;
+                    std::advance(out, val);
+                    mask.for_each_set(
+                        *get<1>(part_begin.get_iterator_tuple()) + 1,
+                        part_size, [&](std::size_t i) {
+                            std::advance(it, i + 1 - pos);
+                            pos = i + 1;
+                            *out++ = *it;
                         });
                 };
 
-                auto f4 = [last_iter, dest, flags](
-                              std::vector<std::size_t>&& items,
+                auto f4 = [last_iter, dest](std::vector<std::size_t>&& items,
                               std::vector<pika::future<void>>&& data) mutable
                     -> unique_copy_result<FwdIter1, FwdIter2> {
-                    PIKA_UNUSED(flags);
-
                     std::advance(dest, items.back());
 
                     // make sure iterators embedded in function object that is
@@ -882,8 +864,9 @@ namespace pika { namespace parallel { inline namespace v1 {
 
                 return scan_partitioner_type::call(
                     PIKA_FORWARD(ExPolicy, policy),
-                    //make_zip_iterator(first, flags.get() - 1),
-                    make_zip_iterator(first, flags.get() - 1), count - 1, init,
+                    make_zip_iterator(first,
+                        pika::util::make_counting_iterator(std::size_t(0))),
+                    count - 1, init,
                     // step 1 performs first part of scan algorithm
                     PIKA_MOVE(f1),
                     // step 2 propagates the partition results from left
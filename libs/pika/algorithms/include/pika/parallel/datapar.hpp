@@ -18,6 +18,9 @@
 #include <pika/parallel/datapar/generate.hpp>
 #include <pika/parallel/datapar/iterator_helpers.hpp>
 #include <pika/parallel/datapar/loop.hpp>
+#include <pika/parallel/datapar/minmax.hpp>
+#include <pika/parallel/datapar/mismatch.hpp>
+#include <pika/parallel/datapar/reduce.hpp>
 #include <pika/parallel/datapar/transfer.hpp>
 #include <pika/parallel/datapar/transform_loop.hpp>
 #include <pika/parallel/datapar/zip_iterator.hpp>
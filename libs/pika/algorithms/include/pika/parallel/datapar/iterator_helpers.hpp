@@ -44,6 +44,19 @@ namespace pika { namespace parallel { namespace util { namespace detail {
         return is_data_aligned_impl<Iter>::call(it);
     }
 
+    // Returns the number of elements before the first one which is properly
+    // aligned for vector pack loads (at most count)
+    template <typename Iter>
+    std::size_t unaligned_head(Iter const& first, std::size_t count)
+    {
+        std::size_t head = 0;
+        while (head != count && !is_data_aligned(std::next(first, head)))
+        {
+            ++head;
+        }
+        return head;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Iter1, typename Iter2>
     struct iterators_datapar_compatible_impl
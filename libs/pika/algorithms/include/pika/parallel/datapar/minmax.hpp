@@ -0,0 +1,277 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// make inspect happy: pikainspect:nominmax
+
+#pragma once
+
+#include <pika/config.hpp>
+
+#if defined(PIKA_HAVE_DATAPAR)
+#include <pika/concepts/concepts.hpp>
+#include <pika/execution/algorithms/detail/predicates.hpp>
+#include <pika/execution/traits/is_execution_policy.hpp>
+#include <pika/execution/traits/vector_pack_all_any_none.hpp>
+#include <pika/execution/traits/vector_pack_find.hpp>
+#include <pika/execution/traits/vector_pack_load_store.hpp>
+#include <pika/execution/traits/vector_pack_min_max.hpp>
+#include <pika/execution/traits/vector_pack_type.hpp>
+#include <pika/executors/execution_policy.hpp>
+#include <pika/functional/tag_invoke.hpp>
+#include <pika/parallel/algorithms/detail/minmax.hpp>
+#include <pika/parallel/datapar/iterator_helpers.hpp>
+#include <pika/parallel/util/projection_identity.hpp>
+#include <pika/parallel/util/result_types.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The smallest and largest elements are searched in vector packs only if
+    // the elements are compared by their natural order, i.e. without a
+    // projection and with operator<.
+    template <typename T, typename F>
+    struct is_datapar_minmax_compare
+      : std::disjunction<std::is_same<F, less>, std::is_same<F, std::less<>>,
+            std::is_same<F, std::less<T>>>
+    {
+    };
+
+    template <typename Iter, typename F, typename Proj, typename Enable = void>
+    struct datapar_minmax_compatible : std::false_type
+    {
+    };
+
+    template <typename Iter, typename F, typename Proj>
+    struct datapar_minmax_compatible<Iter, F, Proj,
+        std::enable_if_t<
+            util::detail::iterator_datapar_compatible<Iter>::value>>
+      : std::conjunction<
+            std::negation<std::is_same<
+                typename std::iterator_traits<Iter>::value_type, bool>>,
+            is_datapar_minmax_compare<
+                typename std::iterator_traits<Iter>::value_type,
+                std::decay_t<F>>,
+            std::is_same<std::decay_t<Proj>, util::projection_identity>>
+    {
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The positions are found in two passes. The first pass determines the
+    // smallest and largest values, the second one finds the first element
+    // equal to the smallest and/or the last element equal to the largest
+    // value. Both passes handle the elements before the first properly
+    // aligned one and the elements not filling a whole vector pack at the
+    // end one by one.
+    template <typename ExPolicy>
+    struct datapar_minmax
+    {
+        // Determines the smallest and largest values of the count > 0
+        // elements starting at first. Returns false if the sequence contains
+        // a NaN, as the position of a NaN determines the result then.
+        template <typename Iter, typename T>
+        static bool min_max_values(
+            Iter first, std::size_t count, T& min_value, T& max_value)
+        {
+            using V = typename traits::vector_pack_type<T>::type;
+            using load = traits::vector_pack_load<V, T>;
+
+            std::size_t constexpr size = traits::vector_pack_size<V>::value;
+
+            bool nan = false;
+            auto step1 = [&](T const& value) {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    nan = nan || value != value;
+                }
+                if (value < min_value)
+                    min_value = value;
+                if (max_value < value)
+                    max_value = value;
+            };
+
+            min_value = max_value = first[0];
+
+            std::size_t const head = util::detail::unaligned_head(first, count);
+
+            std::size_t i = 0;
+            for (/**/; i != head; ++i)
+            {
+                step1(first[i]);
+            }
+
+            if (count - i >= size)
+            {
+                V vmin = load::aligned(first + i);
+                V vmax = vmin;
+                PIKA_MAYBE_UNUSED auto vnan = vmin != vmin;
+                for (i += size; count - i >= size; i += size)
+                {
+                    V const v = load::aligned(first + i);
+                    vmin = traits::elementwise_min(vmin, v);
+                    vmax = traits::elementwise_max(vmax, v);
+                    if constexpr (std::is_floating_point_v<T>)
+                    {
+                        vnan = vnan || v != v;
+                    }
+                }
+
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    nan = nan || traits::any_of(vnan);
+                }
+
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    step1(T(vmin[j]));
+                    step1(T(vmax[j]));
+                }
+            }
+
+            for (/**/; i != count; ++i)
+            {
+                step1(first[i]);
+            }
+
+            return !nan;
+        }
+
+        // Returns the offset of the first element equal to value
+        template <typename Iter, typename T>
+        static std::size_t find_first(
+            Iter first, std::size_t count, T const& value)
+        {
+            using V = typename traits::vector_pack_type<T>::type;
+            using load = traits::vector_pack_load<V, T>;
+
+            std::size_t constexpr size = traits::vector_pack_size<V>::value;
+
+            std::size_t const head = util::detail::unaligned_head(first, count);
+
+            std::size_t i = 0;
+            for (/**/; i != head; ++i)
+            {
+                if (first[i] == value)
+                    return i;
+            }
+
+            V const v(value);
+            for (/**/; count - i >= size; i += size)
+            {
+                int const offset =
+                    traits::find_first_of(load::aligned(first + i) == v);
+                if (offset != -1)
+                    return i + offset;
+            }
+
+            for (/**/; i != count; ++i)
+            {
+                if (first[i] == value)
+                    return i;
+            }
+            return count;
+        }
+
+        // Returns the offset of the last element equal to value
+        template <typename Iter, typename T>
+        static std::size_t find_last(
+            Iter first, std::size_t count, T const& value)
+        {
+            using V = typename traits::vector_pack_type<T>::type;
+            using load = traits::vector_pack_load<V, T>;
+
+            std::size_t constexpr size = traits::vector_pack_size<V>::value;
+
+            V const v(value);
+            std::size_t i = count;
+            for (/**/; i >= size; i -= size)
+            {
+                int const offset = traits::find_last_of(
+                    load::unaligned(first + (i - size)) == v);
+                if (offset != -1)
+                    return i - size + offset;
+            }
+
+            while (i != 0)
+            {
+                if (first[--i] == value)
+                    return i;
+            }
+            return count;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename F, typename Proj,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                datapar_minmax_compatible<Iter, F, Proj>::value)>
+    Iter tag_invoke(sequential_min_element_t<ExPolicy>, Iter it,
+        std::size_t count, F const& f, Proj const& proj)
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+
+        value_type min_value, max_value;
+        if (count < 2 ||
+            !datapar_minmax<ExPolicy>::min_max_values(
+                it, count, min_value, max_value))
+        {
+            return sequential_min_element<pika::execution::sequenced_policy>(
+                it, count, f, proj);
+        }
+
+        return it + datapar_minmax<ExPolicy>::find_first(it, count, min_value);
+    }
+
+    template <typename ExPolicy, typename Iter, typename F, typename Proj,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                datapar_minmax_compatible<Iter, F, Proj>::value)>
+    Iter tag_invoke(sequential_max_element_t<ExPolicy>, Iter it,
+        std::size_t count, F const& f, Proj const& proj)
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+
+        value_type min_value, max_value;
+        if (count < 2 ||
+            !datapar_minmax<ExPolicy>::min_max_values(
+                it, count, min_value, max_value))
+        {
+            return sequential_max_element<pika::execution::sequenced_policy>(
+                it, count, f, proj);
+        }
+
+        return it + datapar_minmax<ExPolicy>::find_last(it, count, max_value);
+    }
+
+    template <typename ExPolicy, typename Iter, typename F, typename Proj,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                datapar_minmax_compatible<Iter, F, Proj>::value)>
+    util::min_max_result<Iter> tag_invoke(
+        sequential_minmax_element_t<ExPolicy>, Iter it, std::size_t count,
+        F const& f, Proj const& proj)
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+
+        value_type min_value, max_value;
+        if (count < 2 ||
+            !datapar_minmax<ExPolicy>::min_max_values(
+                it, count, min_value, max_value))
+        {
+            return sequential_minmax_element<
+                pika::execution::sequenced_policy>(it, count, f, proj);
+        }
+
+        return {it + datapar_minmax<ExPolicy>::find_first(it, count, min_value),
+            it + datapar_minmax<ExPolicy>::find_last(it, count, max_value)};
+    }
+}}}}    // namespace pika::parallel::v1::detail
+#endif
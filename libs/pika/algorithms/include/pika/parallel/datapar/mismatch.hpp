@@ -0,0 +1,240 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+
+#if defined(PIKA_HAVE_DATAPAR)
+#include <pika/concepts/concepts.hpp>
+#include <pika/execution/traits/is_execution_policy.hpp>
+#include <pika/execution/traits/vector_pack_all_any_none.hpp>
+#include <pika/execution/traits/vector_pack_find.hpp>
+#include <pika/execution/traits/vector_pack_load_store.hpp>
+#include <pika/execution/traits/vector_pack_type.hpp>
+#include <pika/functional/invoke.hpp>
+#include <pika/functional/tag_invoke.hpp>
+#include <pika/iterator_support/zip_iterator.hpp>
+#include <pika/parallel/algorithms/detail/distance.hpp>
+#include <pika/parallel/algorithms/detail/mismatch.hpp>
+#include <pika/parallel/datapar/iterator_helpers.hpp>
+#include <pika/parallel/util/result_types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The sequences are compared in vector packs if both hold the same
+    // arithmetic type and if the predicate and the projections can be invoked
+    // with vector packs.
+    template <typename V, typename F, typename Proj1, typename Proj2,
+        typename Enable = void>
+    struct is_datapar_mismatch_predicate : std::false_type
+    {
+    };
+
+    template <typename V, typename F, typename Proj1, typename Proj2>
+    struct is_datapar_mismatch_predicate<V, F, Proj1, Proj2,
+        std::void_t<decltype(pika::util::invoke(std::declval<F&>(),
+            pika::util::invoke(std::declval<Proj1&>(), std::declval<V>()),
+            pika::util::invoke(std::declval<Proj2&>(), std::declval<V>())))>>
+      : std::true_type
+    {
+    };
+
+    template <typename Iter1, typename Iter2, typename F, typename Proj1,
+        typename Proj2, typename Enable = void>
+    struct datapar_mismatch_compatible : std::false_type
+    {
+    };
+
+    template <typename Iter1, typename Iter2, typename F, typename Proj1,
+        typename Proj2>
+    struct datapar_mismatch_compatible<Iter1, Iter2, F, Proj1, Proj2,
+        std::enable_if_t<
+            util::detail::iterator_datapar_compatible<Iter1>::value &&
+            util::detail::iterator_datapar_compatible<Iter2>::value &&
+            std::is_same_v<typename std::iterator_traits<Iter1>::value_type,
+                typename std::iterator_traits<Iter2>::value_type> &&
+            !std::is_same_v<typename std::iterator_traits<Iter1>::value_type,
+                bool>>>
+      : is_datapar_mismatch_predicate<
+            typename traits::vector_pack_type<
+                typename std::iterator_traits<Iter1>::value_type>::type,
+            std::decay_t<F>, std::decay_t<Proj1>, std::decay_t<Proj2>>
+    {
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns the offset of the first position at which the sequences differ,
+    // or count if there is none. The elements before the first properly
+    // aligned element of the first sequence and the elements not filling a
+    // whole vector pack at the end are compared one by one, all others as
+    // vector packs. The second sequence is loaded unaligned if it is not
+    // aligned the same way as the first one. The comparison is abandoned
+    // (count is returned) as soon as stop(offset) returns true, which is
+    // checked once per vector pack.
+    template <typename ExPolicy>
+    struct datapar_mismatch
+    {
+        template <typename Iter1, typename Iter2, typename F, typename Proj1,
+            typename Proj2, typename Stop>
+        static std::size_t call(Iter1 first1, Iter2 first2, std::size_t count,
+            F& f, Proj1& proj1, Proj2& proj2, Stop&& stop)
+        {
+            using value_type =
+                typename std::iterator_traits<Iter1>::value_type;
+            using V = typename traits::vector_pack_type<value_type>::type;
+            using load = traits::vector_pack_load<V, value_type>;
+
+            std::size_t constexpr size = traits::vector_pack_size<V>::value;
+
+            auto mismatch1 = [&](std::size_t i) -> bool {
+                return !PIKA_INVOKE(f, PIKA_INVOKE(proj1, first1[i]),
+                    PIKA_INVOKE(proj2, first2[i]));
+            };
+
+            std::size_t const head =
+                util::detail::unaligned_head(first1, count);
+
+            std::size_t i = 0;
+            for (/**/; i != head; ++i)
+            {
+                if (mismatch1(i))
+                {
+                    return i;
+                }
+            }
+
+            bool const aligned2 =
+                head == count || util::detail::is_data_aligned(first2 + head);
+
+            for (/**/; count - i >= size; i += size)
+            {
+                if (stop(i))
+                {
+                    return count;
+                }
+
+                V const v1 = load::aligned(first1 + i);
+                V const v2 = aligned2 ? load::aligned(first2 + i) :
+                                        load::unaligned(first2 + i);
+
+                auto msk = PIKA_INVOKE(
+                    f, PIKA_INVOKE(proj1, v1), PIKA_INVOKE(proj2, v2));
+                if (!traits::all_of(msk))
+                {
+                    return i + traits::find_first_of(!msk);
+                }
+            }
+
+            for (/**/; i != count; ++i)
+            {
+                if (mismatch1(i))
+                {
+                    return i;
+                }
+            }
+            return count;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter1, typename Sent1, typename Iter2,
+        typename Sent2, typename F, typename Proj1, typename Proj2,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                datapar_mismatch_compatible<Iter1, Iter2, F, Proj1,
+                    Proj2>::value)>
+    util::in_in_result<Iter1, Iter2> tag_invoke(
+        sequential_mismatch_t<ExPolicy>, Iter1 first1, Sent1 last1,
+        Iter2 first2, Sent2 last2, F&& f, Proj1&& proj1, Proj2&& proj2)
+    {
+        std::size_t const count =
+            (std::min)(std::size_t(detail::distance(first1, last1)),
+                std::size_t(detail::distance(first2, last2)));
+
+        std::size_t const offset = datapar_mismatch<ExPolicy>::call(first1,
+            first2, count, f, proj1, proj2, [](std::size_t) { return false; });
+
+        return {std::next(first1, offset), std::next(first2, offset)};
+    }
+
+    template <typename ExPolicy, typename Iter1, typename Sent1, typename Iter2,
+        typename F, typename Proj1, typename Proj2,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                datapar_mismatch_compatible<Iter1, Iter2, F, Proj1,
+                    Proj2>::value)>
+    util::in_in_result<Iter1, Iter2> tag_invoke(
+        sequential_mismatch_t<ExPolicy>, Iter1 first1, Sent1 last1,
+        Iter2 first2, F&& f, Proj1&& proj1, Proj2&& proj2)
+    {
+        std::size_t const offset =
+            datapar_mismatch<ExPolicy>::call(first1, first2,
+                detail::distance(first1, last1), f, proj1, proj2,
+                [](std::size_t) { return false; });
+
+        return {std::next(first1, offset), std::next(first2, offset)};
+    }
+
+    template <typename ExPolicy, typename Iter1, typename Iter2, typename Token,
+        typename F, typename Proj1, typename Proj2,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                datapar_mismatch_compatible<Iter1, Iter2, F, Proj1,
+                    Proj2>::value)>
+    void tag_invoke(sequential_mismatch_t<ExPolicy>,
+        pika::util::zip_iterator<Iter1, Iter2> part_begin,
+        std::size_t part_count, Token& tok, F&& f, Proj1&& proj1,
+        Proj2&& proj2)
+    {
+        auto const& iters = part_begin.get_iterator_tuple();
+        std::size_t const offset = datapar_mismatch<ExPolicy>::call(
+            pika::get<0>(iters), pika::get<1>(iters), part_count, f, proj1,
+            proj2, [&tok](std::size_t) { return tok.was_cancelled(); });
+
+        if (offset != part_count)
+        {
+            tok.cancel();
+        }
+    }
+
+    template <typename ExPolicy, typename Iter1, typename Iter2, typename Token,
+        typename F, typename Proj1, typename Proj2,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                datapar_mismatch_compatible<Iter1, Iter2, F, Proj1,
+                    Proj2>::value)>
+    void tag_invoke(sequential_mismatch_t<ExPolicy>, std::size_t base_idx,
+        pika::util::zip_iterator<Iter1, Iter2> part_begin,
+        std::size_t part_count, Token& tok, F&& f, Proj1&& proj1,
+        Proj2&& proj2)
+    {
+        if (tok.was_cancelled(base_idx))
+        {
+            return;
+        }
+
+        auto const& iters = part_begin.get_iterator_tuple();
+        std::size_t const offset = datapar_mismatch<ExPolicy>::call(
+            pika::get<0>(iters), pika::get<1>(iters), part_count, f, proj1,
+            proj2, [&tok, base_idx](std::size_t i) {
+                return tok.was_cancelled(base_idx + i);
+            });
+
+        if (offset != part_count)
+        {
+            tok.cancel(base_idx + offset);
+        }
+    }
+}}}}    // namespace pika::parallel::v1::detail
+#endif
@@ -0,0 +1,331 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+
+#if defined(PIKA_HAVE_DATAPAR)
+#include <pika/concepts/concepts.hpp>
+#include <pika/execution/algorithms/detail/predicates.hpp>
+#include <pika/execution/traits/is_execution_policy.hpp>
+#include <pika/execution/traits/vector_pack_alignment_size.hpp>
+#include <pika/execution/traits/vector_pack_load_store.hpp>
+#include <pika/execution/traits/vector_pack_type.hpp>
+#include <pika/functional/invoke.hpp>
+#include <pika/functional/tag_invoke.hpp>
+#include <pika/functional/traits/is_invocable.hpp>
+#include <pika/parallel/algorithms/detail/distance.hpp>
+#include <pika/parallel/algorithms/detail/reduce.hpp>
+#include <pika/parallel/datapar/iterator_helpers.hpp>
+#include <pika/parallel/datapar/loop.hpp>
+#include <pika/parallel/util/loop.hpp>
+#include <pika/parallel/util/projection_identity.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace pika { namespace parallel { inline namespace v1 { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // std::plus<T> and std::multiplies<T> (reduce uses std::plus<T> by
+    // default) accept scalars only, use their generic counterparts for vector
+    // packs instead.
+    template <typename F>
+    struct datapar_reduce_operation
+    {
+        template <typename F_>
+        static constexpr F_& call(F_& f) noexcept
+        {
+            return f;
+        }
+    };
+
+    template <typename T>
+    struct datapar_reduce_operation<std::plus<T>>
+    {
+        static constexpr plus call(std::plus<T> const&) noexcept
+        {
+            return plus{};
+        }
+    };
+
+    template <typename T>
+    struct datapar_reduce_operation<std::multiplies<T>>
+    {
+        static constexpr multiplies call(std::multiplies<T> const&) noexcept
+        {
+            return multiplies{};
+        }
+    };
+
+    template <typename Reduce>
+    using datapar_reduce_operation_t =
+        decltype(datapar_reduce_operation<std::decay_t<Reduce>>::call(
+            std::declval<Reduce&>()));
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The elements are reduced in vector packs only if the result type of the
+    // reduction is the value type of the sequences (accumulating in packs of
+    // a narrower type would change the result) and if the operations can be
+    // invoked with vector packs.
+    template <typename T, typename Reduce, typename Convert, typename Iter,
+        typename... Iters>
+    struct datapar_reduce_compatible
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+        using V = typename traits::vector_pack_type<value_type>::type;
+
+        static constexpr bool value = std::conjunction_v<
+            std::is_same<T, value_type>,
+            std::is_same<T,
+                typename std::iterator_traits<Iters>::value_type>...,
+            pika::is_invocable_r<V, datapar_reduce_operation_t<Reduce>, V, V>,
+            pika::is_invocable_r<V, Convert&, V,
+                std::conditional_t<true, V, Iters>...>>;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Reduces count elements into init. The first head elements (those before
+    // the first properly aligned one) and the elements not filling a whole
+    // vector pack at the end are reduced one by one. All other elements are
+    // loaded as vector packs which are reduced into four independent partial
+    // results to hide the latency of the reduction operation. The partial
+    // results are combined and reduced horizontally at the end.
+    template <typename V>
+    struct datapar_reduce_kernel
+    {
+        static constexpr std::size_t size = traits::vector_pack_size<V>::value;
+
+        template <typename T, typename Reduce, typename VReduce,
+            typename Load1, typename LoadV>
+        static T call(std::size_t head, std::size_t count, T init, Reduce& r,
+            VReduce&& vr, Load1&& load1, LoadV&& loadv)
+        {
+            std::size_t i = 0;
+            for (/**/; i != head; ++i)
+            {
+                init = PIKA_INVOKE(r, init, load1(i));
+            }
+
+            std::size_t const last_v = head + (count - head) / size * size;
+            if (i != last_v)
+            {
+                V acc = loadv(i);
+                i += size;
+
+                if (last_v - i >= 3 * size)
+                {
+                    V acc1 = loadv(i);
+                    V acc2 = loadv(i + size);
+                    V acc3 = loadv(i + 2 * size);
+                    i += 3 * size;
+
+                    for (/**/; last_v - i >= 4 * size; i += 4 * size)
+                    {
+                        acc = PIKA_INVOKE(vr, acc, loadv(i));
+                        acc1 = PIKA_INVOKE(vr, acc1, loadv(i + size));
+                        acc2 = PIKA_INVOKE(vr, acc2, loadv(i + 2 * size));
+                        acc3 = PIKA_INVOKE(vr, acc3, loadv(i + 3 * size));
+                    }
+
+                    acc = PIKA_INVOKE(vr, V(PIKA_INVOKE(vr, acc, acc1)),
+                        V(PIKA_INVOKE(vr, acc2, acc3)));
+                }
+
+                for (/**/; i != last_v; i += size)
+                {
+                    acc = PIKA_INVOKE(vr, acc, loadv(i));
+                }
+
+                // horizontal reduction of the lanes of the partial result
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    init = PIKA_INVOKE(r, init, T(acc[j]));
+                }
+            }
+
+            for (/**/; i != count; ++i)
+            {
+                init = PIKA_INVOKE(r, init, load1(i));
+            }
+            return init;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy>
+    struct datapar_reduce
+    {
+        template <typename Iter, typename T, typename Reduce, typename Convert>
+        static T call(
+            Iter first, std::size_t count, T init, Reduce& r, Convert& conv)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            using V = typename traits::vector_pack_type<value_type>::type;
+
+            if constexpr (datapar_reduce_compatible<T, Reduce, Convert,
+                              Iter>::value)
+            {
+                return datapar_reduce_kernel<V>::call(
+                    util::detail::unaligned_head(first, count), count,
+                    PIKA_MOVE(init), r,
+                    datapar_reduce_operation<std::decay_t<Reduce>>::call(r),
+                    [&](std::size_t i) -> T {
+                        return PIKA_INVOKE(conv, first[i]);
+                    },
+                    [&](std::size_t i) -> V {
+                        return PIKA_INVOKE(conv,
+                            traits::vector_pack_load<V, value_type>::aligned(
+                                first + i));
+                    });
+            }
+            else
+            {
+                using reference =
+                    typename std::iterator_traits<Iter>::reference;
+
+                return util::accumulate_n(first, count, PIKA_MOVE(init),
+                    [&r, &conv](T const& res, reference next) -> T {
+                        return PIKA_INVOKE(r, res, PIKA_INVOKE(conv, next));
+                    });
+            }
+        }
+
+        template <typename Iter1, typename Iter2, typename T, typename Reduce,
+            typename Convert>
+        static T call(Iter1 first1, Iter2 first2, std::size_t count, T init,
+            Reduce& r, Convert& conv)
+        {
+            using value_type = typename std::iterator_traits<Iter1>::value_type;
+            using V = typename traits::vector_pack_type<value_type>::type;
+
+            if constexpr (datapar_reduce_compatible<T, Reduce, Convert, Iter1,
+                              Iter2>::value)
+            {
+                std::size_t const head =
+                    util::detail::unaligned_head(first1, count);
+                auto load1 = [&](std::size_t i) -> T {
+                    return PIKA_INVOKE(conv, first1[i], first2[i]);
+                };
+
+                // the second sequence is loaded unaligned if it is not
+                // aligned the same way as the first one
+                if (head == count ||
+                    util::detail::is_data_aligned(first2 + head))
+                {
+                    return datapar_reduce_kernel<V>::call(head, count,
+                        PIKA_MOVE(init), r,
+                        datapar_reduce_operation<std::decay_t<Reduce>>::call(
+                            r),
+                        load1, [&](std::size_t i) -> V {
+                            return PIKA_INVOKE(conv,
+                                traits::vector_pack_load<V,
+                                    value_type>::aligned(first1 + i),
+                                traits::vector_pack_load<V,
+                                    value_type>::aligned(first2 + i));
+                        });
+                }
+
+                return datapar_reduce_kernel<V>::call(head, count,
+                    PIKA_MOVE(init), r,
+                    datapar_reduce_operation<std::decay_t<Reduce>>::call(r),
+                    load1, [&](std::size_t i) -> V {
+                        return PIKA_INVOKE(conv,
+                            traits::vector_pack_load<V, value_type>::aligned(
+                                first1 + i),
+                            traits::vector_pack_load<V, value_type>::unaligned(
+                                first2 + i));
+                    });
+            }
+            else
+            {
+                return sequential_transform_reduce_binary_helper<ExPolicy>(
+                    first1, std::next(first1, count), first2, PIKA_MOVE(init),
+                    r, conv);
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename Sent, typename T,
+        typename Reduce,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                pika::parallel::util::detail::iterator_datapar_compatible<
+                    Iter>::value)>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE T tag_invoke(
+        sequential_reduce_t<ExPolicy>, Iter first, Sent last, T init,
+        Reduce&& r)
+    {
+        util::projection_identity conv;
+        return datapar_reduce<ExPolicy>::call(first,
+            detail::distance(first, last), PIKA_MOVE(init), r, conv);
+    }
+
+    template <typename ExPolicy, typename Iter, typename Sent, typename T,
+        typename Reduce, typename Convert,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                pika::parallel::util::detail::iterator_datapar_compatible<
+                    Iter>::value)>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE T tag_invoke(
+        sequential_reduce_t<ExPolicy>, Iter first, Sent last, T init,
+        Reduce&& r, Convert&& conv)
+    {
+        return datapar_reduce<ExPolicy>::call(
+            first, detail::distance(first, last), PIKA_MOVE(init), r, conv);
+    }
+
+    template <typename ExPolicy, typename Iter1, typename Sent, typename Iter2,
+        typename T, typename Reduce, typename Convert,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                pika::parallel::util::detail::iterator_datapar_compatible<
+                    Iter1>::value&&
+                    pika::parallel::util::detail::iterator_datapar_compatible<
+                        Iter2>::value)>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE T tag_invoke(
+        sequential_reduce_t<ExPolicy>, Iter1 first1, Sent last1, Iter2 first2,
+        T init, Reduce&& r, Convert&& conv)
+    {
+        return datapar_reduce<ExPolicy>::call(first1, first2,
+            detail::distance(first1, last1), PIKA_MOVE(init), r, conv);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename T, typename Reduce,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                pika::parallel::util::detail::iterator_datapar_compatible<
+                    Iter>::value)>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE T tag_invoke(
+        sequential_reduce_n_t<ExPolicy>, Iter first, std::size_t count, T init,
+        Reduce&& r)
+    {
+        util::projection_identity conv;
+        return datapar_reduce<ExPolicy>::call(
+            first, count, PIKA_MOVE(init), r, conv);
+    }
+
+    template <typename ExPolicy, typename Iter, typename T, typename Reduce,
+        typename Convert,
+        PIKA_CONCEPT_REQUIRES_(
+            pika::is_vectorpack_execution_policy<ExPolicy>::value&&
+                pika::parallel::util::detail::iterator_datapar_compatible<
+                    Iter>::value)>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE T tag_invoke(
+        sequential_reduce_n_t<ExPolicy>, Iter first, std::size_t count, T init,
+        Reduce&& r, Convert&& conv)
+    {
+        return datapar_reduce<ExPolicy>::call(
+            first, count, PIKA_MOVE(init), r, conv);
+    }
+}}}}    // namespace pika::parallel::v1::detail
+#endif
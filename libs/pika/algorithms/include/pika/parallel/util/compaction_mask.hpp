@@ -0,0 +1,159 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/assert.hpp>
+
+#if defined(PIKA_MSVC)
+#include <intrin.h>
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace pika { namespace parallel { namespace util {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Holds one bit per element of a sequence, marking the elements kept by a
+    // stream compaction (copy_if, remove_if, unique, ...). The bits of a
+    // partition are set while the predicate is evaluated and are consumed
+    // while the kept elements are moved into place, runs of dropped elements
+    // are skipped a word at a time.
+    //
+    // Partitions don't have to start at a word boundary, neighboring
+    // partitions may share a word. The bits are therefore merged into the
+    // words atomically, which happens once per word only. Copies of a
+    // compaction_mask refer to the same bits. As for std::shared_ptr, the
+    // bits can be modified through a const compaction_mask.
+    class compaction_mask
+    {
+        using word_type = std::uint64_t;
+        static constexpr std::size_t word_bits = 64;
+
+    public:
+        explicit compaction_mask(std::size_t count)
+          : words_(new std::atomic<word_type>[(count + word_bits - 1) /
+                       word_bits](),
+                std::default_delete<std::atomic<word_type>[]>())
+#if defined(PIKA_DEBUG)
+          , count_(count)
+#endif
+        {
+        }
+
+        // Calls keep() for each of the elements [offset, offset + count) in
+        // order and sets the bits of the elements for which it returns true.
+        // Returns the number of bits set.
+        template <typename F>
+        std::size_t set(
+            std::size_t offset, std::size_t count, F&& keep) const
+        {
+            PIKA_ASSERT(offset + count <= count_);
+
+            std::atomic<word_type>* words = words_.get() + offset / word_bits;
+            std::size_t bit = offset % word_bits;
+
+            std::size_t kept = 0;
+            word_type word = 0;
+            for (/**/; count != 0; --count)
+            {
+                bool const k = keep();
+                word |= word_type(k) << bit;
+                kept += k;
+
+                if (++bit == word_bits)
+                {
+                    merge(*words++, word);
+                    word = 0;
+                    bit = 0;
+                }
+            }
+
+            if (word != 0)
+            {
+                merge(*words, word);
+            }
+            return kept;
+        }
+
+        bool test(std::size_t pos) const
+        {
+            PIKA_ASSERT(pos < count_);
+            return (words_.get()[pos / word_bits].load(
+                        std::memory_order_relaxed) >>
+                       (pos % word_bits)) &
+                1;
+        }
+
+        // Calls f(i) in increasing order for the position i, relative to
+        // offset, of each set bit in [offset, offset + count).
+        template <typename F>
+        void for_each_set(std::size_t offset, std::size_t count, F&& f) const
+        {
+            PIKA_ASSERT(offset + count <= count_);
+
+            if (count == 0)
+            {
+                return;
+            }
+
+            std::size_t const last = offset + count;
+            std::size_t const last_word = (last - 1) / word_bits;
+            for (std::size_t w = offset / word_bits; w <= last_word; ++w)
+            {
+                word_type word =
+                    words_.get()[w].load(std::memory_order_relaxed);
+
+                // mask out the bits belonging to neighboring partitions
+                std::size_t const base = w * word_bits;
+                if (base < offset)
+                {
+                    word &= ~word_type(0) << (offset - base);
+                }
+                if (last - base < word_bits)
+                {
+                    word &= (word_type(1) << (last - base)) - 1;
+                }
+
+                while (word != 0)
+                {
+                    f(base + count_trailing_zeros(word) - offset);
+                    word &= word - 1;
+                }
+            }
+        }
+
+    private:
+        static void merge(std::atomic<word_type>& dest, word_type word) noexcept
+        {
+            if (word != 0)
+            {
+                dest.fetch_or(word, std::memory_order_relaxed);
+            }
+        }
+
+        static std::size_t count_trailing_zeros(word_type v) noexcept
+        {
+            PIKA_ASSERT(v != 0);
+#if defined(PIKA_MSVC)
+            unsigned long index = 0;
+            _BitScanForward64(&index, v);
+            return std::size_t(index);
+#else
+            return std::size_t(__builtin_ctzll(v));
+#endif
+        }
+
+        std::shared_ptr<std::atomic<word_type>> words_;
+#if defined(PIKA_DEBUG)
+        std::size_t count_;
+#endif
+    };
+}}}    // namespace pika::parallel::util
@@ -0,0 +1,70 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/async_base/scheduling_properties.hpp>
+#include <pika/coroutines/thread_enums.hpp>
+#include <pika/execution/executors/execution.hpp>
+#include <pika/execution/executors/execution_parameters.hpp>
+#include <pika/execution_base/traits/is_executor_parameters.hpp>
+#include <pika/futures/future.hpp>
+#include <pika/iterator_support/range.hpp>
+#include <pika/properties/property.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pika { namespace parallel { namespace util { namespace detail {
+    ///////////////////////////////////////////////////////////////////////////
+    // Schedules one task for every chunk described by the given shape. By
+    // default the executor decides where the tasks run. If the executor
+    // parameters ask for chunk affinity (see persistent_affinity_chunk_size),
+    // the task running chunk i is scheduled on worker thread i modulo the
+    // number of cores instead. Executors not supporting scheduling hints run
+    // the chunks wherever they see fit.
+    template <typename Result, typename ExPolicy, typename F, typename Shape>
+    std::vector<pika::future<Result>> bulk_async_execute_chunks(
+        ExPolicy&& policy, F&& f, Shape&& shape)
+    {
+        using parameters_type =
+            typename std::decay_t<ExPolicy>::executor_parameters_type;
+        using has_chunk_affinity =
+            typename execution::extract_has_chunk_affinity<
+                parameters_type>::type;
+
+        if constexpr (has_chunk_affinity::value)
+        {
+            std::size_t const cores = execution::processing_units_count(
+                policy.parameters(), policy.executor());
+
+            std::vector<pika::future<Result>> workitems;
+            workitems.reserve(pika::util::size(shape));
+
+            std::size_t chunk = 0;
+            for (auto&& elem : shape)
+            {
+                auto exec = pika::experimental::prefer(
+                    pika::execution::experimental::with_hint,
+                    policy.executor(),
+                    threads::thread_schedule_hint(
+                        static_cast<std::int16_t>(chunk++ % cores)));
+
+                workitems.push_back(execution::async_execute(exec, f, elem));
+            }
+            return workitems;
+        }
+        else
+        {
+            return execution::bulk_async_execute(policy.executor(),
+                PIKA_FORWARD(F, f), PIKA_FORWARD(Shape, shape));
+        }
+    }
+}}}}    // namespace pika::parallel::util::detail
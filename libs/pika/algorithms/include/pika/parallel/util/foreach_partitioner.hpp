@@ -19,6 +19,7 @@
 #include <pika/execution/executors/execution.hpp>
 #include <pika/execution/executors/execution_parameters.hpp>
 #include <pika/executors/execution_policy.hpp>
+#include <pika/parallel/util/detail/bulk_async_execute_chunks.hpp>
 #include <pika/parallel/util/detail/chunk_size.hpp>
 #include <pika/parallel/util/detail/handle_local_exceptions.hpp>
 #include <pika/parallel/util/detail/partitioner_iteration.hpp>
@@ -57,7 +58,7 @@ namespace pika { namespace parallel { namespace util {
                 inititems, f, first, count, 1);
 
             std::vector<pika::future<Result>> workitems =
-                execution::bulk_async_execute(policy.executor(),
+                detail::bulk_async_execute_chunks<Result>(policy,
                     partitioner_iteration<Result, F>{PIKA_FORWARD(F, f)},
                     PIKA_MOVE(shape));
             return std::make_pair(PIKA_MOVE(inititems), PIKA_MOVE(workitems));
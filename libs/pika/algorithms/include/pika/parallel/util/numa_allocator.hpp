@@ -0,0 +1,126 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/executors/execution_policy.hpp>
+#include <pika/parallel/util/partitioner.hpp>
+#include <pika/topology/topology.hpp>
+#include <pika/type_support/empty_function.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace pika { namespace parallel { namespace util {
+    ///////////////////////////////////////////////////////////////////////////
+    /// An allocator placing the memory it hands out close to the threads
+    /// which will later process it.
+    ///
+    /// The memory is obtained from the topology (hwloc) without touching it.
+    /// The operating system places every page on the NUMA domain of the
+    /// thread writing to it first. The allocator touches the memory in
+    /// parallel using the partitioner the parallel algorithms use, running
+    /// on the executor and with the executor parameters of the given policy.
+    /// A parallel algorithm later invoked on the whole sequence with the same
+    /// policy splits it into the same chunks and runs every chunk on the
+    /// same worker thread (modulo work stealing), which therefore mostly
+    /// accesses memory local to its NUMA domain.
+    ///
+    /// The memory is zeroed, but no objects are constructed. Every
+    /// allocation occupies whole pages, the allocator should be used for
+    /// large sequences only.
+    template <typename T,
+        typename ExPolicy = pika::execution::parallel_policy>
+    class numa_allocator
+    {
+        static_assert(!pika::is_async_execution_policy_v<ExPolicy>,
+            "numa_allocator requires a synchronous execution policy");
+
+    public:
+        using value_type = T;
+        using policy_type = ExPolicy;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = numa_allocator<U, ExPolicy>;
+        };
+
+        numa_allocator() = default;
+
+        explicit numa_allocator(ExPolicy const& policy)
+          : policy_(policy)
+        {
+        }
+
+        template <typename U>
+        numa_allocator(numa_allocator<U, ExPolicy> const& rhs)
+          : policy_(rhs.policy())
+        {
+        }
+
+        ExPolicy const& policy() const noexcept
+        {
+            return policy_;
+        }
+
+        PIKA_NODISCARD T* allocate(std::size_t n)
+        {
+            if (n == 0)
+            {
+                return nullptr;
+            }
+
+            T* p = static_cast<T*>(
+                pika::threads::create_topology().allocate(n * sizeof(T)));
+            if (p == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            // first touch the memory in the chunks an algorithm will use
+            util::partitioner<ExPolicy>::call(
+                policy_, p, n,
+                [](T* part_begin, std::size_t part_size) {
+                    std::memset(static_cast<void*>(part_begin), 0,
+                        part_size * sizeof(T));
+                },
+                pika::util::empty_function{});
+
+            return p;
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            if (p != nullptr)
+            {
+                pika::threads::create_topology().deallocate(
+                    p, n * sizeof(T));
+            }
+        }
+
+        // the memory is released the same way, regardless of the policy
+        friend constexpr bool operator==(
+            numa_allocator const&, numa_allocator const&) noexcept
+        {
+            return true;
+        }
+
+        friend constexpr bool operator!=(
+            numa_allocator const&, numa_allocator const&) noexcept
+        {
+            return false;
+        }
+
+    private:
+        ExPolicy policy_;
+    };
+}}}    // namespace pika::parallel::util
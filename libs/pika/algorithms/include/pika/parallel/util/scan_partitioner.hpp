@@ -12,6 +12,9 @@
 #include <pika/config.hpp>
 #include <pika/assert.hpp>
 #include <pika/async_combinators/wait_all.hpp>
+#include <pika/concurrency/cache_line_data.hpp>
+#include <pika/execution_base/this_thread.hpp>
+#include <pika/iterator_support/traits/is_iterator.hpp>
 #include <pika/modules/errors.hpp>
 #if !defined(PIKA_COMPUTE_DEVICE_CODE)
 #include <pika/async/dataflow.hpp>
@@ -27,6 +30,7 @@
 #include <pika/parallel/util/detail/select_partitioner.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <exception>
 #include <list>
@@ -44,8 +48,42 @@ namespace pika { namespace parallel { namespace util {
     {
     };
 
+    // Performs the scan in a single pass over the data (chained scan with
+    // decoupled look-back): every chunk publishes its aggregate and, once
+    // known, its inclusive prefix, and f3 runs right after f1 while the chunk
+    // is still in cache. Falls back to scan_partitioner_normal_tag for
+    // iterators that are not random access.
+    struct scan_partitioner_single_pass_tag
+    {
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // The status word of a chunk used by the single-pass scan. The
+        // aggregate (the result of f1) and the inclusive prefix of the chunk
+        // are published by setting the flag, both are never modified after
+        // that.
+        template <typename Result1>
+        struct scan_chunk_status
+        {
+            enum : int
+            {
+                invalid = 0,
+                aggregate_available = 1,
+                prefix_available = 2
+            };
+
+            std::atomic<int> flag_{invalid};
+            Result1 aggregate_{};
+            Result1 prefix_{};
+        };
+
+        // the number of bytes of intermediate results per chunk of the
+        // single-pass scan, chosen such that a chunk stays in cache between
+        // f1 and f3
+        inline constexpr std::size_t scan_single_pass_chunk_bytes = 64 * 1024;
+
         ///////////////////////////////////////////////////////////////////////
         // The static partitioner simply spawns one chunk of iterations for
         // each available core.
@@ -316,6 +354,190 @@ namespace pika { namespace parallel { namespace util {
 #endif
             }
 
+            template <typename ExPolicy_, typename FwdIter, typename T,
+                typename F1, typename F2, typename F3, typename F4>
+            static R call(scan_partitioner_single_pass_tag, ExPolicy_ policy,
+                FwdIter first, std::size_t count, T&& init, F1&& f1, F2&& f2,
+                F3&& f3, F4&& f4)
+            {
+#if defined(PIKA_COMPUTE_DEVICE_CODE)
+                PIKA_UNUSED(policy);
+                PIKA_UNUSED(first);
+                PIKA_UNUSED(count);
+                PIKA_UNUSED(init);
+                PIKA_UNUSED(f1);
+                PIKA_UNUSED(f2);
+                PIKA_UNUSED(f3);
+                PIKA_UNUSED(f4);
+                PIKA_ASSERT(false);
+                return R();
+#else
+                if constexpr (!pika::traits::is_random_access_iterator_v<
+                                  FwdIter>)
+                {
+                    // chunks are located independently of each other
+                    return call(scan_partitioner_normal_tag{},
+                        PIKA_MOVE(policy), first, count, PIKA_FORWARD(T, init),
+                        PIKA_FORWARD(F1, f1), PIKA_FORWARD(F2, f2),
+                        PIKA_FORWARD(F3, f3), PIKA_FORWARD(F4, f4));
+                }
+                else
+                {
+                    static_assert(std::is_void_v<Result2>,
+                        "the single-pass scan does not support results of f3");
+
+                    using status_type = scan_chunk_status<Result1>;
+
+                    // inform parameter traits
+                    scoped_executor_parameters scoped_params(
+                        policy.parameters(), policy.executor());
+
+                    PIKA_ASSERT(count > 0);
+
+                    // Use chunks small enough to stay in cache, but give
+                    // every core at least one chunk.
+                    std::size_t const cores =
+                        execution::processing_units_count(
+                            policy.parameters(), policy.executor());
+                    std::size_t chunk_size = (std::max)(std::size_t(1),
+                        scan_single_pass_chunk_bytes / sizeof(Result1));
+                    chunk_size =
+                        (std::min)(chunk_size, (count + cores - 1) / cores);
+
+                    std::size_t const num_chunks =
+                        (count + chunk_size - 1) / chunk_size;
+                    std::size_t const num_tasks = (std::min)(cores, num_chunks);
+
+                    // The first status word holds the initial value, the
+                    // status word of chunk i is stored at index i + 1.
+                    std::vector<pika::util::cache_aligned_data<status_type>>
+                        status(num_chunks + 1);
+                    status[0].data_.prefix_ = PIKA_FORWARD(T, init);
+                    status[0].data_.flag_.store(
+                        status_type::prefix_available,
+                        std::memory_order_relaxed);
+
+                    std::atomic<std::size_t> next_chunk(0);
+                    std::atomic<bool> failed(false);
+
+                    // Chunks are handed out in order. A chunk waits only for
+                    // chunks handed out earlier to publish their aggregate,
+                    // which never depends on other chunks. This guarantees
+                    // progress even if all tasks run on the same core.
+                    auto process_chunks = [&]() {
+                        for (;;)
+                        {
+                            std::size_t const chunk = next_chunk.fetch_add(
+                                1, std::memory_order_relaxed);
+                            if (chunk >= num_chunks ||
+                                failed.load(std::memory_order_relaxed))
+                            {
+                                return;
+                            }
+
+                            std::size_t const offset = chunk * chunk_size;
+                            std::size_t const size =
+                                (std::min)(chunk_size, count - offset);
+                            FwdIter it = first + offset;
+                            status_type& s = status[chunk + 1].data_;
+
+                            try
+                            {
+                                s.aggregate_ = PIKA_INVOKE(f1, it, size);
+                                s.flag_.store(status_type::aggregate_available,
+                                    std::memory_order_release);
+
+                                // Look back over the preceding chunks,
+                                // combining their aggregates until a chunk
+                                // with a known prefix is found.
+                                Result1 prefix;
+                                bool has_prefix = false;
+                                for (std::size_t pred = chunk + 1; pred-- != 0;)
+                                {
+                                    status_type const& p = status[pred].data_;
+
+                                    int flag = status_type::invalid;
+                                    pika::util::yield_while([&] {
+                                        flag = p.flag_.load(
+                                            std::memory_order_acquire);
+                                        return flag == status_type::invalid &&
+                                            !failed.load(
+                                                std::memory_order_relaxed);
+                                    });
+
+                                    if (flag == status_type::invalid)
+                                    {
+                                        // some other chunk has failed
+                                        return;
+                                    }
+
+                                    Result1 const& value =
+                                        flag == status_type::prefix_available ?
+                                        p.prefix_ :
+                                        p.aggregate_;
+                                    prefix = has_prefix ?
+                                        PIKA_INVOKE(f2, value, prefix) :
+                                        value;
+                                    has_prefix = true;
+
+                                    if (flag == status_type::prefix_available)
+                                    {
+                                        break;
+                                    }
+                                }
+
+                                s.prefix_ =
+                                    PIKA_INVOKE(f2, prefix, s.aggregate_);
+                                s.flag_.store(status_type::prefix_available,
+                                    std::memory_order_release);
+
+                                PIKA_INVOKE(f3, it, size, PIKA_MOVE(prefix));
+                            }
+                            catch (...)
+                            {
+                                failed.store(true, std::memory_order_relaxed);
+                                throw;
+                            }
+                        }
+                    };
+
+                    std::vector<pika::future<Result2>> finalitems;
+                    std::list<std::exception_ptr> errors;
+                    try
+                    {
+                        finalitems.reserve(num_tasks);
+                        for (std::size_t i = 0; i != num_tasks; ++i)
+                        {
+                            finalitems.push_back(execution::async_execute(
+                                policy.executor(), process_chunks));
+                        }
+
+                        scoped_params.mark_end_of_scheduling();
+                    }
+                    catch (...)
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                        handle_local_exceptions::call(
+                            std::current_exception(), errors);
+                    }
+
+                    // the tasks refer to the status words, wait for them
+                    // before collecting the prefixes of all chunks
+                    pika::wait_all_nothrow(finalitems);
+
+                    std::vector<Result1> prefixes;
+                    prefixes.reserve(status.size());
+                    for (auto& s : status)
+                    {
+                        prefixes.push_back(PIKA_MOVE(s.data_.prefix_));
+                    }
+
+                    return reduce(PIKA_MOVE(prefixes), PIKA_MOVE(finalitems),
+                        PIKA_MOVE(errors), PIKA_FORWARD(F4, f4));
+                }
+#endif
+            }
+
             template <typename ExPolicy_, typename FwdIter, typename T,
                 typename F1, typename F2, typename F3, typename F4>
             static R call(ExPolicy_&& policy, FwdIter first, std::size_t count,
@@ -0,0 +1,120 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures repeated parallel sweeps over the same sequence, as
+// done by iterative solvers. The sequence is meant to fit into the combined
+// caches of all cores. With static_chunk_size every sweep may run a chunk on
+// a different core than the previous sweep did, with
+// persistent_affinity_chunk_size every chunk stays on the same core and
+// finds its data in that core's caches.
+
+#include <pika/algorithm.hpp>
+#include <pika/chrono.hpp>
+#include <pika/execution.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/format.hpp>
+#include <pika/modules/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the best time (in seconds) per sweep out of the given number of
+// iterations
+template <typename Policy>
+double measure(Policy const& policy, std::vector<double>& v,
+    std::size_t iterations, std::size_t sweeps)
+{
+    // warm up the caches
+    pika::fill(policy, v.begin(), v.end(), 1.0);
+
+    double best = (std::numeric_limits<double>::max)();
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        pika::chrono::high_resolution_timer t;
+        for (std::size_t s = 0; s != sweeps; ++s)
+        {
+            pika::for_each(policy, v.begin(), v.end(),
+                [](double& d) { d = 0.5 * d + 1.0; });
+        }
+        best = (std::min)(best, t.elapsed() / double(sweeps));
+    }
+
+    // the sweeps converge towards 2.0
+    PIKA_TEST(std::all_of(v.begin(), v.end(),
+        [](double d) { return d > 1.0 && d <= 2.0; }));
+
+    return best;
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    std::size_t const size = vm["vector_size"].as<std::size_t>();
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+    std::size_t const sweeps = vm["sweeps"].as<std::size_t>();
+    std::size_t const chunks_per_core = vm["chunks_per_core"].as<std::size_t>();
+
+    std::vector<double> v(size);
+
+    // every sweep reads and writes every element once
+    double const bytes = 2.0 * sizeof(double) * double(size);
+
+    std::cout << "Parameters,Size,Time/Sweep[s],Bandwidth[GB/s]" << std::endl;
+
+    auto report = [&](char const* name, double time) {
+        pika::util::format_to(std::cout, "{:18},{:10},{:10.6},{:10.4}\n", name,
+            size, time, bytes / time * 1e-9)
+            << std::flush;
+
+        pika::util::print_cdash_timing(
+            (std::string("PersistentAffinity_") + name).c_str(), time);
+    };
+
+    report("static",
+        measure(pika::execution::par.with(pika::execution::static_chunk_size()),
+            v, iterations, sweeps));
+
+    report("persistent_affinity",
+        measure(pika::execution::par.with(
+                    pika::execution::persistent_affinity_chunk_size(
+                        chunks_per_core)),
+            v, iterations, sweeps));
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = pika::program_options;
+
+    po::options_description cmdline(
+        "usage: " PIKA_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("vector_size", po::value<std::size_t>()->default_value(1 << 18),
+         "number of elements to sweep over (default: 2^18)")
+        ("iterations", po::value<std::size_t>()->default_value(10),
+         "number of iterations, the best time is reported (default: 10)")
+        ("sweeps", po::value<std::size_t>()->default_value(100),
+         "number of sweeps per iteration (default: 100)")
+        ("chunks_per_core", po::value<std::size_t>()->default_value(1),
+         "number of chunks per core for persistent_affinity_chunk_size "
+         "(default: 1)");
+    // clang-format on
+
+    pika::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
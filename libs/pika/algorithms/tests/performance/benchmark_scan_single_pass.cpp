@@ -0,0 +1,167 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the memory bandwidth achieved by an inclusive scan
+// using the multi-pass (scan_partitioner_normal_tag) and the single-pass
+// (scan_partitioner_single_pass_tag) scan partitioners. The bandwidth of a
+// parallel copy is reported as a reference. Following STREAM, the bandwidth
+// counts every element being read once and written once.
+
+#include <pika/algorithm.hpp>
+#include <pika/chrono.hpp>
+#include <pika/execution.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/format.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/numeric.hpp>
+#include <pika/parallel/util/scan_partitioner.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Tag>
+void scan(std::vector<double> const& in, std::vector<double>& out)
+{
+    using iterator = std::vector<double>::const_iterator;
+    using zip_iterator =
+        pika::util::zip_iterator<iterator, std::vector<double>::iterator>;
+    using pika::get;
+
+    pika::parallel::util::scan_partitioner<pika::execution::parallel_policy,
+        void, double, void, Tag>::call(pika::execution::par,
+        pika::util::make_zip_iterator(in.begin(), out.begin()), in.size(),
+        0.0,
+        // step 1 scans every partition in place
+        [](zip_iterator part_begin, std::size_t part_size) -> double {
+            auto iters = part_begin.get_iterator_tuple();
+            iterator it = get<0>(iters);
+            auto dest = get<1>(iters);
+
+            double sum = 0.0;
+            for (std::size_t i = 0; i != part_size; (void) ++i, ++it, ++dest)
+            {
+                sum += *it;
+                *dest = sum;
+            }
+            return sum;
+        },
+        // step 2 combines the results of the partitions
+        std::plus<double>(),
+        // step 3 adds the prefix of the partition
+        [](zip_iterator part_begin, std::size_t part_size, double val) {
+            auto dest = get<1>(part_begin.get_iterator_tuple());
+            for (std::size_t i = 0; i != part_size; (void) ++i, ++dest)
+            {
+                *dest += val;
+            }
+        },
+        // step 4 has nothing to do
+        [](std::vector<double>&&, std::vector<pika::future<void>>&&) {});
+}
+
+void copy(std::vector<double> const& in, std::vector<double>& out)
+{
+    pika::copy(pika::execution::par, in.begin(), in.end(), out.begin());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the best time (in seconds) out of the given number of iterations
+template <typename F>
+double measure(std::size_t iterations, F&& f, std::vector<double> const& in,
+    std::vector<double>& out)
+{
+    double best = (std::numeric_limits<double>::max)();
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        pika::chrono::high_resolution_timer t;
+        f(in, out);
+        best = (std::min)(best, t.elapsed());
+    }
+    return best;
+}
+
+void verify(std::vector<double> const& in, std::vector<double> const& out)
+{
+    std::vector<double> expected(in.size());
+    std::inclusive_scan(in.begin(), in.end(), expected.begin());
+    PIKA_TEST(expected == out);
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    std::size_t const size = vm["vector_size"].as<std::size_t>();
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+
+    // small integers keep the floating point sums exact
+    std::vector<double> in(size);
+    std::vector<double> out(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        in[i] = double(i % 8);
+    }
+
+    double const bytes = 2.0 * sizeof(double) * double(size);
+
+    std::cout << "Kernel,Size,Time[s],Bandwidth[GB/s]" << std::endl;
+
+    auto report = [&](char const* name, double time) {
+        pika::util::format_to(std::cout, "{:10},{:10},{:10.6},{:10.4}\n", name,
+            size, time, bytes / time * 1e-9)
+            << std::flush;
+
+        pika::util::print_cdash_timing(
+            (std::string("ScanSinglePass_") + name).c_str(), time);
+    };
+
+    report("copy", measure(iterations, &copy, in, out));
+
+    report("multi_pass",
+        measure(iterations,
+            &scan<pika::parallel::util::scan_partitioner_normal_tag>, in,
+            out));
+    verify(in, out);
+
+    std::fill(out.begin(), out.end(), 0.0);
+    report("single_pass",
+        measure(iterations,
+            &scan<pika::parallel::util::scan_partitioner_single_pass_tag>, in,
+            out));
+    verify(in, out);
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = pika::program_options;
+
+    po::options_description cmdline(
+        "usage: " PIKA_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("vector_size", po::value<std::size_t>()->default_value(1 << 26),
+         "number of elements to scan (default: 2^26)")
+        ("iterations", po::value<std::size_t>()->default_value(10),
+         "number of iterations, the best time is reported (default: 10)");
+    // clang-format on
+
+    pika::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
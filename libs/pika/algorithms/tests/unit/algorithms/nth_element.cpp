@@ -123,6 +123,41 @@ void test_nth_element_async(ExPolicy p, IteratorTag)
     }
 }
 
+// exercises the parallel selection, which handles large ranges only
+template <typename ExPolicy, typename IteratorTag>
+void test_nth_element_large(ExPolicy policy, IteratorTag)
+{
+    using base_iterator = std::vector<std::size_t>::iterator;
+    using iterator = test::test_iterator<base_iterator, IteratorTag>;
+
+    std::size_t const size = 1000003;
+    std::uniform_int_distribution<std::size_t> dis(0, size - 1);
+
+    // distinct values, many duplicates, and a single value
+    for (std::size_t range : {size, std::size_t(100), std::size_t(1)})
+    {
+        std::vector<std::size_t> c(size);
+        std::generate(std::begin(c), std::end(c),
+            [&]() { return std::size_t(gen() % range); });
+
+        for (std::size_t nth : {std::size_t(0), dis(gen), size - 1})
+        {
+            std::vector<std::size_t> d = c;
+
+            pika::nth_element(policy, iterator(std::begin(c)),
+                iterator(std::begin(c) + nth), iterator(std::end(c)));
+
+            std::nth_element(std::begin(d), std::begin(d) + nth, std::end(d));
+
+            PIKA_TEST_EQ(c[nth], d[nth]);
+            PIKA_TEST(std::all_of(std::begin(c), std::begin(c) + nth,
+                [&](std::size_t v) { return v <= c[nth]; }));
+            PIKA_TEST(std::all_of(std::begin(c) + nth, std::end(c),
+                [&](std::size_t v) { return v >= c[nth]; }));
+        }
+    }
+}
+
 template <typename IteratorTag>
 void test_nth_element()
 {
@@ -134,6 +169,8 @@ void test_nth_element()
 
     test_nth_element_async(seq(task), IteratorTag());
     test_nth_element_async(par(task), IteratorTag());
+
+    test_nth_element_large(par, IteratorTag());
 }
 
 void nth_element_test()
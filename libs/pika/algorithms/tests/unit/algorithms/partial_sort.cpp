@@ -109,6 +109,36 @@ void test_partial_sort_async(ExPolicy p, IteratorTag)
     }
 }
 
+// exercises the parallel selection, which handles large ranges only
+template <typename ExPolicy, typename IteratorTag>
+void test_partial_sort_large(ExPolicy policy, IteratorTag)
+{
+    using compare_t = std::less<std::uint64_t>;
+
+    std::uint64_t const size = 1000003;
+
+    std::vector<std::uint64_t> A, B;
+    A.reserve(size);
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        A.emplace_back(i);
+    }
+    std::shuffle(A.begin(), A.end(), gen);
+
+    for (std::uint64_t i : {std::uint64_t(1), size / 3, size - 1})
+    {
+        B = A;
+        pika::partial_sort(
+            policy, B.begin(), B.begin() + i, B.end(), compare_t());
+
+        for (std::uint64_t j = 0; j < i; ++j)
+        {
+            PIKA_TEST(B[j] == j);
+        }
+    }
+}
+
 template <typename IteratorTag>
 void test_partial_sort()
 {
@@ -120,6 +150,8 @@ void test_partial_sort()
 
     test_partial_sort_async(seq(task), IteratorTag());
     test_partial_sort_async(par(task), IteratorTag());
+
+    test_partial_sort_large(par, IteratorTag());
 }
 
 void partial_sort_test()
@@ -9,6 +9,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -68,6 +69,15 @@ void test_sort1()
     test_sort1(par, double());
     test_sort1(par_unseq, double());
 
+    // arithmetic keys of all sizes (radix sort)
+    test_sort1(par, std::int8_t());
+    test_sort1(par, std::uint16_t());
+    test_sort1(par, std::int64_t());
+    test_sort1(par, std::uint64_t());
+    test_sort1(par, float());
+    test_sort1_comp(par, std::int64_t(), std::less<std::int64_t>());
+    test_sort1_comp(par, double(), std::less<>());
+
     // default comparison operator (std::less)
     test_sort1(seq, std::string());
     test_sort1(par, std::string());
@@ -255,6 +255,9 @@ void test_sort_by_key1()
             [](int key) { return key; });
         test_sort_by_key1(par_unseq, int(), double(), std::equal_to<double>(),
             [](int key) { return key; });
+        //
+        test_sort_by_key1(par, std::uint64_t(), float(),
+            std::equal_to<float>(), [](std::uint64_t key) { return key; });
         // custom compare
         test_sort_by_key1(
             seq, double(), double(),
@@ -0,0 +1,83 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/algorithm.hpp>
+#include <pika/execution.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/numeric.hpp>
+#include <pika/parallel/util/numa_allocator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using pika::parallel::util::numa_allocator;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Policy>
+void test_numa_allocator(Policy&& policy, std::size_t size)
+{
+    using allocator_type = numa_allocator<double, std::decay_t<Policy>>;
+    allocator_type alloc(policy);
+
+    // the memory is handed out zeroed
+    double* p = alloc.allocate(size);
+    PIKA_TEST(p != nullptr);
+    PIKA_TEST(std::all_of(p, p + size, [](double d) { return d == 0.0; }));
+    alloc.deallocate(p, size);
+
+    std::vector<double, allocator_type> v(size, 1.0, alloc);
+    PIKA_TEST_EQ(std::size_t(std::count(v.begin(), v.end(), 1.0)), size);
+
+    pika::for_each(policy, v.begin(), v.end(), [](double& d) { d *= 2.0; });
+    PIKA_TEST_EQ(pika::reduce(policy, v.begin(), v.end(), 0.0), 2.0 * size);
+
+    // growing the vector allocates and touches new memory
+    v.resize(2 * size, 3.0);
+    PIKA_TEST_EQ(pika::reduce(policy, v.begin(), v.end(), 0.0), 5.0 * size);
+
+    // allocators with different value types compare equal
+    numa_allocator<int, std::decay_t<Policy>> int_alloc(alloc);
+    PIKA_TEST(allocator_type(int_alloc) == alloc);
+    PIKA_TEST(!(allocator_type(int_alloc) != alloc));
+}
+
+int pika_main()
+{
+    for (std::size_t size : {std::size_t(1), std::size_t(1000),
+             std::size_t(1) << 20})
+    {
+        test_numa_allocator(pika::execution::par, size);
+        test_numa_allocator(
+            pika::execution::par.with(pika::execution::static_chunk_size(64)),
+            size);
+        test_numa_allocator(pika::execution::seq, size);
+    }
+
+    // an empty allocation does not need any memory
+    numa_allocator<double> alloc;
+    PIKA_TEST(alloc.allocate(0) == nullptr);
+    alloc.deallocate(nullptr, 0);
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {"pika.os_threads=all"};
+
+    pika::init_params init_args;
+    init_args.cfg = cfg;
+
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
@@ -0,0 +1,150 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/algorithm.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/parallel/datapar.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Compares the results for subranges starting at every offset within a vector
+// pack, so that all of the unaligned head, the vectorized body, and the tail
+// are exercised.
+template <typename ExPolicy, typename T>
+void test_minmax_element(ExPolicy policy, std::vector<T> const& c)
+{
+    for (std::size_t offset = 0; offset != 16 && offset < c.size(); ++offset)
+    {
+        auto first = c.begin() + offset;
+        auto last = c.end();
+
+        auto min_it = pika::min_element(policy, first, last);
+        PIKA_TEST(min_it == std::min_element(first, last));
+
+        // pika::max_element returns the last largest element
+        auto max_it = pika::max_element(policy, first, last);
+        PIKA_TEST(max_it == pika::max_element(first, last));
+
+        auto minmax = pika::minmax_element(policy, first, last);
+        auto expected = std::minmax_element(first, last);
+        PIKA_TEST(minmax.min == expected.first);
+        PIKA_TEST(minmax.max == expected.second);
+    }
+}
+
+template <typename T>
+void test_minmax_element(std::vector<T> const& c)
+{
+    using namespace pika::execution;
+
+    test_minmax_element(simd, c);
+    test_minmax_element(par_simd, c);
+}
+
+template <typename T>
+void test_minmax_element()
+{
+    for (std::size_t size : {1, 2, 3, 7, 8, 17, 31, 64, 1000, 10007})
+    {
+        // random values with many duplicates
+        std::vector<T> c(size);
+        std::generate(c.begin(), c.end(), []() { return T(std::rand() % 64); });
+        test_minmax_element(c);
+
+        // the extremes at the very beginning and at the very end
+        std::fill(c.begin(), c.end(), T(1));
+        c.front() = T(0);
+        c.back() = T(2);
+        test_minmax_element(c);
+
+        c.front() = T(2);
+        c.back() = T(0);
+        test_minmax_element(c);
+    }
+}
+
+void test_minmax_element_nan()
+{
+    using namespace pika::execution;
+
+    std::vector<double> c(1007);
+    std::generate(
+        c.begin(), c.end(), []() { return double(std::rand() % 64); });
+
+    for (std::size_t pos : {std::size_t(0), std::size_t(500), c.size() - 1})
+    {
+        std::vector<double> d = c;
+        d[pos] = std::numeric_limits<double>::quiet_NaN();
+
+        // the sequential algorithm defines the result for NaNs
+        auto min_it = pika::min_element(simd, d.begin(), d.end());
+        PIKA_TEST(min_it == pika::min_element(seq, d.begin(), d.end()));
+
+        auto max_it = pika::max_element(simd, d.begin(), d.end());
+        PIKA_TEST(max_it == pika::max_element(seq, d.begin(), d.end()));
+
+        auto minmax = pika::minmax_element(simd, d.begin(), d.end());
+        auto expected = pika::minmax_element(seq, d.begin(), d.end());
+        PIKA_TEST(minmax.min == expected.min);
+        PIKA_TEST(minmax.max == expected.max);
+    }
+}
+
+void minmax_element_test()
+{
+    test_minmax_element<int>();
+    test_minmax_element<unsigned char>();
+    test_minmax_element<float>();
+    test_minmax_element<double>();
+
+    test_minmax_element_nan();
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    minmax_element_test();
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace pika::program_options;
+    options_description desc_commandline(
+        "Usage: " PIKA_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"pika.os_threads=all"};
+
+    // Initialize and run pika
+    pika::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+    init_args.cfg = cfg;
+
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
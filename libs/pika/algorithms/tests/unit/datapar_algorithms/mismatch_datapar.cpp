@@ -0,0 +1,146 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/algorithm.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/parallel/datapar.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The second sequence is offset against the first one so that it is loaded
+// both aligned and unaligned. The mismatch is placed into the unaligned head,
+// the vectorized body, and the tail of the sequences.
+template <typename T, typename ExPolicy>
+void test_mismatch(ExPolicy policy, std::size_t size)
+{
+    std::vector<T> c1(size + 16);
+    std::generate(c1.begin(), c1.end(), []() { return T(std::rand() % 100); });
+
+    for (std::size_t offset = 0; offset != 16; ++offset)
+    {
+        std::vector<T> c2(c1.begin() + offset, c1.end());
+        c2.resize(c1.size());
+
+        auto first1 = c1.begin() + offset;
+        auto last1 = first1 + size;
+        auto first2 = c2.begin();
+        auto last2 = first2 + size;
+
+        {
+            auto result = pika::mismatch(policy, first1, last1, first2);
+            PIKA_TEST(result.first == last1);
+            PIKA_TEST(result.second == last2);
+
+            auto result_binary =
+                pika::mismatch(policy, first1, last1, first2, last2);
+            PIKA_TEST(result_binary.first == last1);
+            PIKA_TEST(result_binary.second == last2);
+
+            PIKA_TEST(pika::equal(policy, first1, last1, first2));
+            PIKA_TEST(pika::equal(policy, first1, last1, first2, last2));
+        }
+
+        for (std::size_t pos :
+            {std::size_t(0), std::size_t(3), size / 2, size - 1})
+        {
+            if (pos >= size)
+                continue;
+
+            ++c2[pos];
+
+            auto result = pika::mismatch(policy, first1, last1, first2);
+            PIKA_TEST(result.first == first1 + pos);
+            PIKA_TEST(result.second == first2 + pos);
+
+            auto result_binary =
+                pika::mismatch(policy, first1, last1, first2, last2);
+            PIKA_TEST(result_binary.first == first1 + pos);
+            PIKA_TEST(result_binary.second == first2 + pos);
+
+            PIKA_TEST(!pika::equal(policy, first1, last1, first2));
+            PIKA_TEST(!pika::equal(policy, first1, last1, first2, last2));
+
+            --c2[pos];
+        }
+
+        // sequences of different lengths, the parallel algorithm doesn't
+        // compare those at all
+        if (!pika::is_parallel_execution_policy_v<ExPolicy> && size != 0)
+        {
+            auto result_binary =
+                pika::mismatch(policy, first1, last1, first2, last2 - 1);
+            PIKA_TEST(result_binary.first == last1 - 1);
+            PIKA_TEST(result_binary.second == last2 - 1);
+
+            PIKA_TEST(!pika::equal(policy, first1, last1, first2, last2 - 1));
+        }
+    }
+}
+
+template <typename T>
+void test_mismatch()
+{
+    using namespace pika::execution;
+
+    for (std::size_t size : {0, 1, 5, 8, 33, 100, 10007})
+    {
+        test_mismatch<T>(seq, size);
+        test_mismatch<T>(simd, size);
+        test_mismatch<T>(par_simd, size);
+    }
+}
+
+void mismatch_test()
+{
+    test_mismatch<int>();
+    test_mismatch<unsigned char>();
+    test_mismatch<double>();
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    mismatch_test();
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace pika::program_options;
+    options_description desc_commandline(
+        "Usage: " PIKA_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"pika.os_threads=all"};
+
+    // Initialize and run pika
+    pika::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+    init_args.cfg = cfg;
+
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
@@ -0,0 +1,175 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/init.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/parallel/algorithms/reduce.hpp>
+#include <pika/parallel/datapar.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../algorithms/test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag>
+void test_reduce(ExPolicy policy, IteratorTag)
+{
+    static_assert(pika::is_execution_policy<ExPolicy>::value,
+        "pika::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> c(10007);
+    std::iota(std::begin(c), std::end(c), std::rand() % 1007);
+
+    int val(42);
+    auto op = [](auto v1, auto v2) { return v1 + v2; };
+
+    int r1 = pika::reduce(
+        policy, iterator(std::begin(c)), iterator(std::end(c)), val, op);
+
+    // verify values
+    int r2 = std::accumulate(std::begin(c), std::end(c), val);
+    PIKA_TEST_EQ(r1, r2);
+
+    // std::plus<int> is used by default
+    int r3 =
+        pika::reduce(policy, iterator(std::begin(c)), iterator(std::end(c)));
+    PIKA_TEST_EQ(r3, std::accumulate(std::begin(c), std::end(c), 0));
+}
+
+// exercise unaligned heads and incomplete vector packs at the end
+template <typename ExPolicy>
+void test_reduce_offsets(ExPolicy policy)
+{
+    std::vector<int> c(1007);
+    std::iota(std::begin(c), std::end(c), std::rand() % 1007);
+
+    for (std::size_t first = 0; first != 17; ++first)
+    {
+        for (std::size_t last = c.size() - 67; last != c.size(); ++last)
+        {
+            int r1 = pika::reduce(policy, std::begin(c) + first,
+                std::begin(c) + last, 1, std::plus<int>());
+            int r2 = std::accumulate(
+                std::begin(c) + first, std::begin(c) + last, 1);
+            PIKA_TEST_EQ(r1, r2);
+        }
+    }
+
+    // short sequences do not fill a single vector pack
+    for (std::size_t count = 0; count != 67; ++count)
+    {
+        int r1 = pika::reduce(
+            policy, std::begin(c) + 3, std::begin(c) + 3 + count, 5);
+        int r2 =
+            std::accumulate(std::begin(c) + 3, std::begin(c) + 3 + count, 5);
+        PIKA_TEST_EQ(r1, r2);
+    }
+}
+
+// accumulating into a different type is not vectorized
+template <typename ExPolicy>
+void test_reduce_widening(ExPolicy policy)
+{
+    std::vector<std::int8_t> c(1007, std::int8_t(100));
+
+    std::int64_t r1 = pika::reduce(policy, std::begin(c), std::end(c),
+        std::int64_t(0), [](auto v1, auto v2) { return v1 + v2; });
+    PIKA_TEST_EQ(r1, std::int64_t(100 * 1007));
+}
+
+template <typename ExPolicy, typename IteratorTag>
+void test_reduce_async(ExPolicy p, IteratorTag)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> c(10007);
+    std::iota(std::begin(c), std::end(c), std::rand() % 1007);
+
+    int val(42);
+    auto op = [](auto v1, auto v2) { return v1 + v2; };
+
+    pika::future<int> f = pika::reduce(
+        p, iterator(std::begin(c)), iterator(std::end(c)), val, op);
+    f.wait();
+
+    // verify values
+    int r2 = std::accumulate(std::begin(c), std::end(c), val);
+    PIKA_TEST_EQ(f.get(), r2);
+}
+
+template <typename IteratorTag>
+void test_reduce()
+{
+    using namespace pika::execution;
+
+    test_reduce(simd, IteratorTag());
+    test_reduce(par_simd, IteratorTag());
+
+    test_reduce_async(simd(task), IteratorTag());
+    test_reduce_async(par_simd(task), IteratorTag());
+}
+
+void reduce_test()
+{
+    test_reduce<std::random_access_iterator_tag>();
+    test_reduce<std::forward_iterator_tag>();
+
+    test_reduce_offsets(pika::execution::simd);
+    test_reduce_offsets(pika::execution::par_simd);
+
+    test_reduce_widening(pika::execution::simd);
+    test_reduce_widening(pika::execution::par_simd);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int pika_main(pika::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    reduce_test();
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace pika::program_options;
+    options_description desc_commandline(
+        "Usage: " PIKA_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"pika.os_threads=all"};
+
+    // Initialize and run pika
+    pika::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+    init_args.cfg = cfg;
+
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
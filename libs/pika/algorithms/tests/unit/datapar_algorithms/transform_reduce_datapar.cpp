@@ -0,0 +1,167 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/init.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/parallel/algorithms/transform_reduce.hpp>
+#include <pika/parallel/datapar.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../algorithms/test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag>
+void test_transform_reduce(ExPolicy policy, IteratorTag)
+{
+    static_assert(pika::is_execution_policy<ExPolicy>::value,
+        "pika::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> c(10007);
+    std::iota(std::begin(c), std::end(c), std::rand() % 1007);
+
+    auto reduce_op = [](auto v1, auto v2) { return v1 + v2; };
+    auto convert_op = [](auto v) { return v * v; };
+
+    int r1 = pika::transform_reduce(policy, iterator(std::begin(c)),
+        iterator(std::end(c)), 42, reduce_op, convert_op);
+
+    // verify values
+    int r2 = std::accumulate(std::begin(c), std::end(c), 42,
+        [](int res, int val) { return res + val * val; });
+    PIKA_TEST_EQ(r1, r2);
+}
+
+template <typename ExPolicy, typename IteratorTag>
+void test_transform_reduce_async(ExPolicy p, IteratorTag)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> c(10007);
+    std::iota(std::begin(c), std::end(c), std::rand() % 1007);
+
+    auto reduce_op = [](auto v1, auto v2) { return v1 + v2; };
+    auto convert_op = [](auto v) { return v * v; };
+
+    pika::future<int> f = pika::transform_reduce(p, iterator(std::begin(c)),
+        iterator(std::end(c)), 42, reduce_op, convert_op);
+    f.wait();
+
+    // verify values
+    int r2 = std::accumulate(std::begin(c), std::end(c), 42,
+        [](int res, int val) { return res + val * val; });
+    PIKA_TEST_EQ(f.get(), r2);
+}
+
+// exercise unaligned heads, differently aligned sequences and incomplete
+// vector packs at the end (all values are exactly representable)
+template <typename ExPolicy>
+void test_transform_reduce_offsets(ExPolicy policy)
+{
+    std::vector<float> c(1007);
+    std::vector<float> d(1007);
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        c[i] = float(std::rand() % 16);
+        d[i] = float(std::rand() % 16);
+    }
+
+    auto plus = [](auto v1, auto v2) { return v1 + v2; };
+    auto multiplies = [](auto v1, auto v2) { return v1 * v2; };
+
+    for (std::size_t first1 = 0; first1 != 9; ++first1)
+    {
+        for (std::size_t first2 = 0; first2 != 9; ++first2)
+        {
+            for (std::size_t count = 0; count != 66; count += 3)
+            {
+                auto const first = std::begin(c) + first1;
+                auto const last = first + (c.size() - 80 + count);
+
+                float r1 = pika::transform_reduce(policy, first, last,
+                    std::begin(d) + first2, 1.0f, plus, multiplies);
+                float r2 = std::inner_product(
+                    first, last, std::begin(d) + first2, 1.0f);
+                PIKA_TEST_EQ(r1, r2);
+
+                float r3 = pika::transform_reduce(policy, first, last, 1.0f,
+                    plus, [](auto v) { return v * v; });
+                float r4 = std::inner_product(first, last, first, 1.0f);
+                PIKA_TEST_EQ(r3, r4);
+            }
+        }
+    }
+}
+
+template <typename IteratorTag>
+void test_transform_reduce()
+{
+    using namespace pika::execution;
+
+    test_transform_reduce(simd, IteratorTag());
+    test_transform_reduce(par_simd, IteratorTag());
+
+    test_transform_reduce_async(simd(task), IteratorTag());
+    test_transform_reduce_async(par_simd(task), IteratorTag());
+}
+
+void transform_reduce_test()
+{
+    test_transform_reduce<std::random_access_iterator_tag>();
+    test_transform_reduce<std::forward_iterator_tag>();
+
+    test_transform_reduce_offsets(pika::execution::simd);
+    test_transform_reduce_offsets(pika::execution::par_simd);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int pika_main(pika::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    transform_reduce_test();
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace pika::program_options;
+    options_description desc_commandline(
+        "Usage: " PIKA_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"pika.os_threads=all"};
+
+    // Initialize and run pika
+    pika::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+    init_args.cfg = cfg;
+
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
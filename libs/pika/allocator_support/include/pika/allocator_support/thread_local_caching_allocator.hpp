@@ -0,0 +1,171 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace pika { namespace detail {
+    ///////////////////////////////////////////////////////////////////////////
+    /// An allocator adaptor which keeps a small cache of released memory
+    /// blocks per thread. Requests for single objects are served from the
+    /// cache of the calling thread if possible, and released single objects
+    /// are put back into the cache as long as it is not full. All other
+    /// requests are forwarded to the underlying allocator.
+    ///
+    /// Memory is only cached if all instances of the underlying allocator
+    /// compare equal (and can be default constructed), i.e. if memory
+    /// allocated by one instance can be released by any other instance.
+    /// Otherwise all requests are forwarded to the underlying allocator.
+    template <typename Allocator, std::size_t CacheSize = 64>
+    class thread_local_caching_allocator
+    {
+        template <typename Allocator_, std::size_t CacheSize_>
+        friend class thread_local_caching_allocator;
+
+        using traits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = typename traits::value_type;
+        using pointer = typename traits::pointer;
+        using const_pointer = typename traits::const_pointer;
+        using size_type = typename traits::size_type;
+        using difference_type = typename traits::difference_type;
+
+        using is_always_equal = typename traits::is_always_equal;
+        using propagate_on_container_copy_assignment =
+            typename traits::propagate_on_container_copy_assignment;
+        using propagate_on_container_move_assignment =
+            typename traits::propagate_on_container_move_assignment;
+        using propagate_on_container_swap =
+            typename traits::propagate_on_container_swap;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = thread_local_caching_allocator<
+                typename traits::template rebind_alloc<U>, CacheSize>;
+        };
+
+    private:
+        static constexpr bool use_cache = is_always_equal::value &&
+            std::is_default_constructible<Allocator>::value && CacheSize != 0;
+
+        struct cache
+        {
+            std::size_t size = 0;
+            std::size_t capacity = 0;
+            pointer blocks[CacheSize == 0 ? 1 : CacheSize] = {};
+        };
+
+        struct cache_cleanup
+        {
+            cache& c;
+
+            ~cache_cleanup()
+            {
+                Allocator alloc;
+                while (c.size != 0)
+                {
+                    traits::deallocate(alloc, c.blocks[--c.size], 1);
+                }
+
+                // don't cache anything anymore, objects may still be
+                // released while other thread-local objects are destroyed
+                c.capacity = 0;
+            }
+        };
+
+        // The cache itself is trivially destructible, it stays accessible
+        // (as an empty cache) while the remaining thread-local objects are
+        // destroyed.
+        static cache& get_cache() noexcept
+        {
+            static thread_local cache c;
+            static thread_local bool initialized = false;
+            if (PIKA_UNLIKELY(!initialized))
+            {
+                initialized = true;
+                static thread_local cache_cleanup cleanup{c};
+                c.capacity = CacheSize;
+            }
+            return c;
+        }
+
+    public:
+        thread_local_caching_allocator() = default;
+
+        explicit thread_local_caching_allocator(Allocator const& alloc)
+          : alloc(alloc)
+        {
+        }
+
+        template <typename Allocator_>
+        thread_local_caching_allocator(
+            thread_local_caching_allocator<Allocator_, CacheSize> const& other)
+          : alloc(other.alloc)
+        {
+        }
+
+        PIKA_NODISCARD pointer allocate(size_type n)
+        {
+            if constexpr (use_cache)
+            {
+                if (n == 1)
+                {
+                    cache& c = get_cache();
+                    if (c.size != 0)
+                    {
+                        return c.blocks[--c.size];
+                    }
+                }
+            }
+            return traits::allocate(alloc, n);
+        }
+
+        void deallocate(pointer p, size_type n) noexcept
+        {
+            if constexpr (use_cache)
+            {
+                if (n == 1)
+                {
+                    cache& c = get_cache();
+                    if (c.size < c.capacity)
+                    {
+                        c.blocks[c.size++] = p;
+                        return;
+                    }
+                }
+            }
+            traits::deallocate(alloc, p, n);
+        }
+
+        Allocator const& get_allocator() const noexcept
+        {
+            return alloc;
+        }
+
+        friend bool operator==(thread_local_caching_allocator const& lhs,
+            thread_local_caching_allocator const& rhs) noexcept
+        {
+            return lhs.alloc == rhs.alloc;
+        }
+
+        friend bool operator!=(thread_local_caching_allocator const& lhs,
+            thread_local_caching_allocator const& rhs) noexcept
+        {
+            return lhs.alloc != rhs.alloc;
+        }
+
+    private:
+        PIKA_NO_UNIQUE_ADDRESS Allocator alloc;
+    };
+}}    // namespace pika::detail
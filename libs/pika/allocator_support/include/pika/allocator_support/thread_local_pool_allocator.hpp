@@ -0,0 +1,324 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/allocator_support/internal_allocator.hpp>
+#include <pika/concurrency/cache_line_data.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace pika { namespace detail {
+    ///////////////////////////////////////////////////////////////////////////
+    /// A pool of memory blocks of a fixed size with a cache (magazine) per
+    /// thread. Blocks are carved from slabs owned by the cache of a thread,
+    /// and every block remembers the cache it has been carved from.
+    ///
+    /// Blocks released by the owning thread go straight back to its cache.
+    /// Blocks released by any other thread are collected in a small batch
+    /// per releasing thread and are handed back to their owner in a single
+    /// atomic operation once the batch is full (or once a block of another
+    /// owner is released). The owner reclaims all remotely released blocks at
+    /// once when its cache runs empty. Allocating and releasing blocks on the
+    /// same thread therefore touches no shared cache lines.
+    ///
+    /// The cache of an exiting thread is retired and is adopted by the next
+    /// thread needing one. Slabs are never returned to the system.
+    template <std::size_t Size, std::size_t Alignment>
+    class thread_local_pool
+    {
+        static_assert(Alignment <= alignof(std::max_align_t),
+            "thread_local_pool does not support over-aligned types");
+
+        struct cache;
+
+        static constexpr std::size_t round_up(std::size_t n) noexcept
+        {
+            return (n + Alignment - 1) / Alignment * Alignment;
+        }
+
+        // every block is preceded by a pointer to the cache owning it
+        static constexpr std::size_t header_size = round_up(sizeof(cache*));
+        static constexpr std::size_t block_size = header_size +
+            round_up(Size < sizeof(void*) ? sizeof(void*) : Size);
+
+        static constexpr std::size_t blocks_per_slab = 64;
+        static constexpr std::size_t remote_batch_size = 32;
+
+        // released blocks are linked through their first bytes
+        static void*& next(void* p) noexcept
+        {
+            return *static_cast<void**>(p);
+        }
+
+        static cache*& owner(void* p) noexcept
+        {
+            return *reinterpret_cast<cache**>(
+                static_cast<char*>(p) - header_size);
+        }
+
+        struct cache
+        {
+            // accessed by the owning thread only
+            void* free_ = nullptr;
+            char* slab_next_ = nullptr;
+            char* slab_end_ = nullptr;
+            cache* next_retired_ = nullptr;
+
+            // blocks released by other threads
+            char padding_[threads::get_cache_line_size()];
+            std::atomic<void*> remote_free_{nullptr};
+            char padding2_[threads::get_cache_line_size()];
+        };
+
+        // blocks released by the current thread which belong to another cache
+        struct remote_batch
+        {
+            cache* owner_ = nullptr;
+            void* head_ = nullptr;
+            void* tail_ = nullptr;
+            std::size_t count_ = 0;
+        };
+
+        // The per-thread state is trivially destructible, it stays accessible
+        // while the remaining thread-local objects are destroyed.
+        struct thread_state
+        {
+            cache* cache_ = nullptr;
+            remote_batch batch_;
+            bool exited_ = false;
+        };
+
+        struct thread_state_cleanup
+        {
+            thread_state& s;
+
+            ~thread_state_cleanup()
+            {
+                flush(s.batch_);
+                if (s.cache_ != nullptr)
+                {
+                    retire(s.cache_);
+                    s.cache_ = nullptr;
+                }
+
+                // blocks released from now on are handed back right away
+                s.exited_ = true;
+            }
+        };
+
+        static thread_state& get_thread_state() noexcept
+        {
+            static thread_local thread_state s;
+            static thread_local bool initialized = false;
+            if (PIKA_UNLIKELY(!initialized))
+            {
+                initialized = true;
+                static thread_local thread_state_cleanup cleanup{s};
+            }
+            return s;
+        }
+
+        static std::mutex& retired_mutex() noexcept
+        {
+            static std::mutex mtx;
+            return mtx;
+        }
+
+        static cache*& retired_caches() noexcept
+        {
+            static cache* retired = nullptr;
+            return retired;
+        }
+
+        static cache* adopt()
+        {
+            {
+                std::lock_guard<std::mutex> l(retired_mutex());
+                cache*& retired = retired_caches();
+                if (retired != nullptr)
+                {
+                    cache* c = retired;
+                    retired = c->next_retired_;
+                    c->next_retired_ = nullptr;
+                    return c;
+                }
+            }
+            return new cache;
+        }
+
+        static void retire(cache* c)
+        {
+            std::lock_guard<std::mutex> l(retired_mutex());
+            cache*& retired = retired_caches();
+            c->next_retired_ = retired;
+            retired = c;
+        }
+
+        static void push_remote(cache* c, void* head, void* tail) noexcept
+        {
+            void* old_head = c->remote_free_.load(std::memory_order_relaxed);
+            do
+            {
+                next(tail) = old_head;
+            } while (!c->remote_free_.compare_exchange_weak(old_head, head,
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        static void flush(remote_batch& batch) noexcept
+        {
+            if (batch.count_ != 0)
+            {
+                push_remote(batch.owner_, batch.head_, batch.tail_);
+            }
+            batch = remote_batch{};
+        }
+
+        static void* allocate_from(cache* c)
+        {
+            void* p = c->free_;
+            if (p == nullptr &&
+                c->remote_free_.load(std::memory_order_relaxed) != nullptr)
+            {
+                p = c->remote_free_.exchange(nullptr, std::memory_order_acquire);
+            }
+
+            if (p != nullptr)
+            {
+                c->free_ = next(p);
+                return p;
+            }
+
+            if (c->slab_next_ == c->slab_end_)
+            {
+                c->slab_next_ = pika::util::internal_allocator<char>{}.allocate(
+                    blocks_per_slab * block_size);
+                c->slab_end_ = c->slab_next_ + blocks_per_slab * block_size;
+            }
+
+            p = c->slab_next_ + header_size;
+            c->slab_next_ += block_size;
+            owner(p) = c;
+            return p;
+        }
+
+    public:
+        static void* allocate()
+        {
+            thread_state& s = get_thread_state();
+            if (PIKA_UNLIKELY(s.cache_ == nullptr))
+            {
+                if (s.exited_)
+                {
+                    // the thread is exiting, borrow a cache
+                    cache* c = adopt();
+                    void* p = allocate_from(c);
+                    retire(c);
+                    return p;
+                }
+                s.cache_ = adopt();
+            }
+            return allocate_from(s.cache_);
+        }
+
+        static void deallocate(void* p) noexcept
+        {
+            thread_state& s = get_thread_state();
+            cache* c = owner(p);
+            if (c == s.cache_)
+            {
+                next(p) = c->free_;
+                c->free_ = p;
+                return;
+            }
+
+            if (PIKA_UNLIKELY(s.exited_))
+            {
+                push_remote(c, p, p);
+                return;
+            }
+
+            remote_batch& batch = s.batch_;
+            if (batch.owner_ != c)
+            {
+                flush(batch);
+                batch.owner_ = c;
+                batch.tail_ = p;
+            }
+
+            next(p) = batch.head_;
+            batch.head_ = p;
+            if (++batch.count_ == remote_batch_size)
+            {
+                flush(batch);
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An allocator serving requests for single objects from a
+    /// thread_local_pool, see above. All other requests are forwarded to the
+    /// internal allocator.
+    template <typename T>
+    class thread_local_pool_allocator
+    {
+        using pool = thread_local_pool<sizeof(T), alignof(T)>;
+
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = thread_local_pool_allocator<U>;
+        };
+
+        thread_local_pool_allocator() = default;
+
+        template <typename U>
+        thread_local_pool_allocator(
+            thread_local_pool_allocator<U> const&) noexcept
+        {
+        }
+
+        PIKA_NODISCARD T* allocate(std::size_t n)
+        {
+            if (n == 1)
+            {
+                return static_cast<T*>(pool::allocate());
+            }
+            return pika::util::internal_allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            if (n == 1)
+            {
+                pool::deallocate(p);
+                return;
+            }
+            pika::util::internal_allocator<T>{}.deallocate(p, n);
+        }
+
+        friend constexpr bool operator==(thread_local_pool_allocator const&,
+            thread_local_pool_allocator const&) noexcept
+        {
+            return true;
+        }
+
+        friend constexpr bool operator!=(thread_local_pool_allocator const&,
+            thread_local_pool_allocator const&) noexcept
+        {
+            return false;
+        }
+    };
+}}    // namespace pika::detail
@@ -78,4 +78,14 @@ namespace pika { namespace execution { namespace experimental {
       : detail::property_base<get_annotation_t>
     {
     } get_annotation{};
+
+    inline constexpr struct with_bulk_chunking_t final
+      : detail::property_base<with_bulk_chunking_t>
+    {
+    } with_bulk_chunking{};
+
+    inline constexpr struct get_bulk_chunking_t final
+      : detail::property_base<get_bulk_chunking_t>
+    {
+    } get_bulk_chunking{};
 }}}    // namespace pika::execution::experimental
@@ -10,9 +10,11 @@
 #include <pika/concurrency/cache_line_data.hpp>
 #include <pika/datastructures/optional.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <type_traits>
+#include <utility>
 
 namespace pika { namespace concurrency { namespace detail {
     /// \brief A concurrent queue which can only hold contiguous ranges of
@@ -59,6 +61,11 @@ namespace pika { namespace concurrency { namespace detail {
             {
                 return first >= last;
             }
+
+            constexpr T size() noexcept
+            {
+                return empty() ? T(0) : T(last - first);
+            }
         };
 
     public:
@@ -176,11 +183,113 @@ namespace pika { namespace concurrency { namespace detail {
             return pika::util::make_optional(index);
         }
 
+        /// \brief Attempt to pop a range of items from the left of the queue.
+        ///
+        /// Attempt to pop up to max_count items from the left (beginning) of
+        /// the queue. The popped items are returned as a half-open range. If
+        /// no items are left pika::util::nullopt is returned.
+        constexpr pika::util::optional<std::pair<T, T>> pop_left_range(
+            T max_count) noexcept
+        {
+            PIKA_ASSERT(max_count > 0);
+
+            range desired_range{0, 0};
+            T first = 0;
+
+            range expected_range =
+                current_range.data_.load(std::memory_order_relaxed);
+
+            do
+            {
+                if (expected_range.empty())
+                {
+                    return pika::util::nullopt;
+                }
+
+                first = expected_range.first;
+                desired_range = range{
+                    T(first + (std::min)(max_count, expected_range.size())),
+                    expected_range.last};
+            } while (!current_range.data_.compare_exchange_weak(
+                expected_range, desired_range));
+
+            return pika::util::make_optional(
+                std::make_pair(first, desired_range.first));
+        }
+
+        /// \brief Attempt to pop a range of items from the right of the queue.
+        ///
+        /// Attempt to pop up to max_count items from the right (end) of the
+        /// queue. The popped items are returned as a half-open range. If no
+        /// items are left pika::util::nullopt is returned.
+        constexpr pika::util::optional<std::pair<T, T>> pop_right_range(
+            T max_count) noexcept
+        {
+            PIKA_ASSERT(max_count > 0);
+
+            range desired_range{0, 0};
+            T last = 0;
+
+            range expected_range =
+                current_range.data_.load(std::memory_order_relaxed);
+
+            do
+            {
+                if (expected_range.empty())
+                {
+                    return pika::util::nullopt;
+                }
+
+                last = expected_range.last;
+                desired_range = range{expected_range.first,
+                    T(last - (std::min)(max_count, expected_range.size()))};
+            } while (!current_range.data_.compare_exchange_weak(
+                expected_range, desired_range));
+
+            return pika::util::make_optional(
+                std::make_pair(desired_range.last, last));
+        }
+
+        /// \brief Refill an empty queue with the given range.
+        ///
+        /// Unlike reset, this may be called while other threads concurrently
+        /// attempt to pop items from the queue. It is the callees
+        /// responsibility to ensure that no other thread refills or resets
+        /// the queue at the same time. Returns false (and leaves the queue
+        /// unchanged) if the queue was not empty.
+        constexpr bool refill(T first, T last) noexcept
+        {
+            PIKA_ASSERT(first <= last);
+
+            range expected_range =
+                current_range.data_.load(std::memory_order_relaxed);
+
+            do
+            {
+                if (!expected_range.empty())
+                {
+                    return false;
+                }
+            } while (!current_range.data_.compare_exchange_weak(
+                expected_range, range{first, last}));
+
+            return true;
+        }
+
         constexpr bool empty() noexcept
         {
             return current_range.data_.load(std::memory_order_relaxed).empty();
         }
 
+        /// \brief Return the number of items left in the queue.
+        ///
+        /// The returned value is only a snapshot if other threads are
+        /// concurrently accessing the queue.
+        constexpr T size() noexcept
+        {
+            return current_range.data_.load(std::memory_order_relaxed).size();
+        }
+
     private:
         range initial_range;
         pika::util::cache_line_data<std::atomic<range>> current_range;
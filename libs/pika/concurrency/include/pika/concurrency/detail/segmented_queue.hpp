@@ -0,0 +1,291 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//  This work is inspired by the SegQueue of the crossbeam project
+//  (https://github.com/crossbeam-rs/crossbeam).
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/assert.hpp>
+#include <pika/concurrency/cache_line_data.hpp>
+#include <pika/execution_base/this_thread.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace pika { namespace concurrency { namespace detail {
+    /// \brief An unbounded lock-free multi-producer multi-consumer FIFO queue.
+    ///
+    /// The items are stored in a linked list of fixed-size segments. Pushing
+    /// and popping claim a position by incrementing the tail and head index,
+    /// respectively, and then access the slot of that position only. The
+    /// thread claiming the last slot of a segment links in the next segment,
+    /// the segment is freed by whichever thread reads its last item. No
+    /// memory is allocated except for one new segment per segment_size
+    /// pushed items.
+    ///
+    /// Items are popped in the order in which their positions were claimed,
+    /// in particular items pushed by the same thread are popped in the order
+    /// they were pushed. A pop may briefly spin if the item at its position
+    /// has been claimed, but not yet written by a concurrent push.
+    /// Constructing an item must therefore not throw.
+    template <typename T>
+    class segmented_queue
+    {
+    public:
+        // number of items stored in each segment
+        static constexpr std::size_t segment_size = 31;
+
+    private:
+        // The indices advance by one past the last slot of each segment, an
+        // index with that offset marks a segment which is being switched.
+        static constexpr std::size_t lap = segment_size + 1;
+
+        enum slot_state : unsigned
+        {
+            slot_written = 1,
+            slot_read = 2,
+            slot_destroy = 4
+        };
+
+        struct slot
+        {
+            std::atomic<unsigned> state{0};
+            std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+            T* value() noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(&storage));
+            }
+
+            void wait_written() const noexcept
+            {
+                pika::util::yield_while(
+                    [this]() {
+                        return (state.load(std::memory_order_acquire) &
+                                   slot_written) == 0;
+                    },
+                    "segmented_queue::wait_written");
+            }
+        };
+
+        struct segment
+        {
+            std::atomic<segment*> next{nullptr};
+            slot slots[segment_size];
+
+            segment* wait_next() const noexcept
+            {
+                segment* s = nullptr;
+                pika::util::yield_while(
+                    [&]() {
+                        s = next.load(std::memory_order_acquire);
+                        return s == nullptr;
+                    },
+                    "segmented_queue::wait_next");
+                return s;
+            }
+        };
+
+        struct position
+        {
+            std::atomic<std::size_t> index{0};
+            std::atomic<segment*> seg{nullptr};
+        };
+
+        // Frees the segment once all slots starting at start have been read.
+        // If one of them is still being read, its reader takes over.
+        static void destroy(segment* s, std::size_t start) noexcept
+        {
+            // the reader of the last slot started the destruction
+            for (std::size_t i = start; i != segment_size - 1; ++i)
+            {
+                slot& sl = s->slots[i];
+                if ((sl.state.load(std::memory_order_acquire) & slot_read) ==
+                        0 &&
+                    (sl.state.fetch_or(slot_destroy,
+                         std::memory_order_acq_rel) &
+                        slot_read) == 0)
+                {
+                    return;
+                }
+            }
+            delete s;
+        }
+
+    public:
+        segmented_queue()
+        {
+            segment* s = new segment();
+            head_.data_.seg.store(s, std::memory_order_relaxed);
+            tail_.data_.seg.store(s, std::memory_order_relaxed);
+        }
+
+        segmented_queue(segmented_queue const&) = delete;
+        segmented_queue& operator=(segmented_queue const&) = delete;
+
+        ~segmented_queue()
+        {
+            std::size_t head =
+                head_.data_.index.load(std::memory_order_relaxed);
+            std::size_t const tail =
+                tail_.data_.index.load(std::memory_order_relaxed);
+            segment* s = head_.data_.seg.load(std::memory_order_relaxed);
+
+            for (/**/; head != tail; ++head)
+            {
+                std::size_t const offset = head % lap;
+                if (offset < segment_size)
+                {
+                    s->slots[offset].value()->~T();
+                }
+                else
+                {
+                    segment* next = s->next.load(std::memory_order_relaxed);
+                    delete s;
+                    s = next;
+                }
+            }
+            delete s;
+        }
+
+        template <typename... Ts>
+        void push(Ts&&... ts)
+        {
+            std::size_t tail =
+                tail_.data_.index.load(std::memory_order_acquire);
+            segment* s = tail_.data_.seg.load(std::memory_order_acquire);
+            segment* next = nullptr;
+
+            for (std::size_t k = 0;; ++k)
+            {
+                std::size_t const offset = tail % lap;
+
+                // another thread is linking in the next segment
+                if (offset == segment_size)
+                {
+                    pika::execution_base::this_thread::yield_k(
+                        k, "segmented_queue::push");
+                    tail = tail_.data_.index.load(std::memory_order_acquire);
+                    s = tail_.data_.seg.load(std::memory_order_acquire);
+                    continue;
+                }
+
+                // allocate the next segment ahead of claiming the last slot
+                // to keep the time other threads have to wait short
+                if (offset + 1 == segment_size && next == nullptr)
+                {
+                    next = new segment();
+                }
+
+                if (tail_.data_.index.compare_exchange_weak(tail, tail + 1,
+                        std::memory_order_seq_cst, std::memory_order_acquire))
+                {
+                    if (offset + 1 == segment_size)
+                    {
+                        PIKA_ASSERT(next != nullptr);
+                        tail_.data_.seg.store(next, std::memory_order_release);
+                        tail_.data_.index.store(
+                            tail + 2, std::memory_order_release);
+                        s->next.store(next, std::memory_order_release);
+                        next = nullptr;
+                    }
+
+                    slot& sl = s->slots[offset];
+                    new (&sl.storage) T(PIKA_FORWARD(Ts, ts)...);
+                    sl.state.fetch_or(slot_written, std::memory_order_release);
+                    break;
+                }
+
+                s = tail_.data_.seg.load(std::memory_order_acquire);
+            }
+
+            // the preallocated segment was not needed after all
+            delete next;
+        }
+
+        // Moves the first item into value, which can be of any type
+        // assignable from T. Returns false if the queue is empty.
+        template <typename U>
+        bool pop(U& value)
+        {
+            std::size_t head =
+                head_.data_.index.load(std::memory_order_acquire);
+            segment* s = head_.data_.seg.load(std::memory_order_acquire);
+
+            for (std::size_t k = 0;; ++k)
+            {
+                std::size_t const offset = head % lap;
+
+                // another thread is switching to the next segment
+                if (offset == segment_size)
+                {
+                    pika::execution_base::this_thread::yield_k(
+                        k, "segmented_queue::pop");
+                    head = head_.data_.index.load(std::memory_order_acquire);
+                    s = head_.data_.seg.load(std::memory_order_acquire);
+                    continue;
+                }
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (head == tail_.data_.index.load(std::memory_order_relaxed))
+                {
+                    return false;
+                }
+
+                if (head_.data_.index.compare_exchange_weak(head, head + 1,
+                        std::memory_order_seq_cst, std::memory_order_acquire))
+                {
+                    if (offset + 1 == segment_size)
+                    {
+                        segment* next = s->wait_next();
+                        head_.data_.seg.store(next, std::memory_order_release);
+                        head_.data_.index.store(
+                            head + 2, std::memory_order_release);
+                    }
+
+                    slot& sl = s->slots[offset];
+                    sl.wait_written();
+                    value = PIKA_MOVE(*sl.value());
+                    sl.value()->~T();
+
+                    if (offset + 1 == segment_size)
+                    {
+                        destroy(s, 0);
+                    }
+                    else if (sl.state.fetch_or(slot_read,
+                                 std::memory_order_acq_rel) &
+                        slot_destroy)
+                    {
+                        destroy(s, offset + 1);
+                    }
+                    return true;
+                }
+
+                s = head_.data_.seg.load(std::memory_order_acquire);
+            }
+        }
+
+        /// \brief Return whether the queue is empty.
+        ///
+        /// The returned value is only a snapshot if other threads are
+        /// concurrently accessing the queue.
+        bool empty() const noexcept
+        {
+            std::size_t const head =
+                head_.data_.index.load(std::memory_order_seq_cst);
+            return head == tail_.data_.index.load(std::memory_order_seq_cst);
+        }
+
+    private:
+        pika::util::cache_line_data<position> head_;
+        pika::util::cache_line_data<position> tail_;
+    };
+}}}    // namespace pika::concurrency::detail
@@ -21,6 +21,7 @@
 #include <functional>
 #include <iterator>
 #include <random>
+#include <utility>
 #include <vector>
 
 unsigned int seed = std::random_device{}();
@@ -91,11 +92,57 @@ void test_basic()
     }
 }
 
+void test_ranges()
+{
+    {
+        // Popping ranges should give us contiguous, non-overlapping ranges.
+        pika::concurrency::detail::contiguous_index_queue<> q{3, 13};
+        PIKA_TEST_EQ(q.size(), std::uint32_t(10));
+
+        auto r = q.pop_left_range(4);
+        PIKA_TEST(r);
+        PIKA_TEST_EQ(r->first, std::uint32_t(3));
+        PIKA_TEST_EQ(r->second, std::uint32_t(7));
+
+        r = q.pop_right_range(2);
+        PIKA_TEST(r);
+        PIKA_TEST_EQ(r->first, std::uint32_t(11));
+        PIKA_TEST_EQ(r->second, std::uint32_t(13));
+        PIKA_TEST_EQ(q.size(), std::uint32_t(4));
+
+        // Asking for more items than available returns what is left.
+        r = q.pop_left_range(100);
+        PIKA_TEST(r);
+        PIKA_TEST_EQ(r->first, std::uint32_t(7));
+        PIKA_TEST_EQ(r->second, std::uint32_t(11));
+
+        PIKA_TEST(q.empty());
+        PIKA_TEST_EQ(q.size(), std::uint32_t(0));
+        PIKA_TEST(!q.pop_left_range(1));
+        PIKA_TEST(!q.pop_right_range(1));
+    }
+
+    {
+        // Only empty queues can be refilled.
+        pika::concurrency::detail::contiguous_index_queue<> q{0, 2};
+        PIKA_TEST(!q.refill(5, 7));
+        PIKA_TEST_EQ(q.pop_left().value(), std::uint32_t(0));
+        PIKA_TEST_EQ(q.pop_left().value(), std::uint32_t(1));
+
+        PIKA_TEST(q.refill(5, 7));
+        PIKA_TEST_EQ(q.size(), std::uint32_t(2));
+        PIKA_TEST_EQ(q.pop_right().value(), std::uint32_t(6));
+        PIKA_TEST_EQ(q.pop_left().value(), std::uint32_t(5));
+        PIKA_TEST(q.empty());
+    }
+}
+
 enum class pop_mode
 {
     left,
     right,
-    random
+    random,
+    ranges
 };
 
 void test_concurrent_worker(pop_mode m, std::size_t thread_index,
@@ -103,8 +150,10 @@ void test_concurrent_worker(pop_mode m, std::size_t thread_index,
     std::vector<std::uint32_t>& popped_indices)
 {
     pika::optional<std::uint32_t> curr;
+    pika::optional<std::pair<std::uint32_t, std::uint32_t>> curr_range;
     std::mt19937 r(seed + thread_index);
     std::uniform_int_distribution<> d(0, 1);
+    std::uniform_int_distribution<std::uint32_t> count(1, 100);
 
     // Make sure all threads start roughly at the same time.
     b.arrive_and_wait();
@@ -129,6 +178,17 @@ void test_concurrent_worker(pop_mode m, std::size_t thread_index,
             popped_indices.push_back(curr.value());
         }
         break;
+    case pop_mode::ranges:
+        while (d(r) == 0 ? (curr_range = q.pop_left_range(count(r))) :
+                           (curr_range = q.pop_right_range(count(r))))
+        {
+            for (std::uint32_t i = curr_range->first; i != curr_range->second;
+                 ++i)
+            {
+                popped_indices.push_back(i);
+            }
+        }
+        break;
     default:
         PIKA_TEST(false);
     }
@@ -199,9 +259,11 @@ int pika_main(pika::program_options::variables_map& vm)
     }
 
     test_basic();
+    test_ranges();
     test_concurrent(pop_mode::left);
     test_concurrent(pop_mode::right);
     test_concurrent(pop_mode::random);
+    test_concurrent(pop_mode::ranges);
     return pika::finalize();
 }
 
@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (C) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <pika/barrier.hpp>
+#include <pika/concurrency/detail/segmented_queue.hpp>
+#include <pika/future.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/thread.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using queue_type = pika::concurrency::detail::segmented_queue<std::size_t>;
+
+std::atomic<std::size_t> num_alive(0);
+
+struct counted
+{
+    counted()
+    {
+        ++num_alive;
+    }
+    counted(counted&&) noexcept
+    {
+        ++num_alive;
+    }
+    counted& operator=(counted&&) = default;
+    ~counted()
+    {
+        --num_alive;
+    }
+};
+
+void test_basic()
+{
+    {
+        // A default constructed queue should be empty.
+        queue_type q;
+
+        std::size_t value = 0;
+        PIKA_TEST(q.empty());
+        PIKA_TEST(!q.pop(value));
+    }
+
+    {
+        // Items should be popped in order, across several segments.
+        std::size_t const count = 10 * queue_type::segment_size + 3;
+        queue_type q;
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            q.push(i);
+        }
+        PIKA_TEST(!q.empty());
+
+        std::size_t value = 0;
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            PIKA_TEST(q.pop(value));
+            PIKA_TEST_EQ(value, i);
+        }
+
+        PIKA_TEST(q.empty());
+        PIKA_TEST(!q.pop(value));
+    }
+
+    {
+        // Items left in the queue should be destroyed with the queue.
+        {
+            pika::concurrency::detail::segmented_queue<counted> q;
+            for (std::size_t i = 0; i != 3 * queue_type::segment_size; ++i)
+            {
+                q.push();
+            }
+
+            counted c;
+            for (std::size_t i = 0; i != queue_type::segment_size + 1; ++i)
+            {
+                PIKA_TEST(q.pop(c));
+            }
+        }
+        PIKA_TEST_EQ(num_alive.load(), std::size_t(0));
+    }
+
+    {
+        // Move-only items should be supported.
+        pika::concurrency::detail::segmented_queue<std::unique_ptr<int>> q;
+        q.push(std::make_unique<int>(42));
+
+        std::unique_ptr<int> p;
+        PIKA_TEST(q.pop(p));
+        PIKA_TEST_EQ(*p, 42);
+    }
+}
+
+std::size_t const num_items_per_producer = 10000;
+
+void test_concurrent_producer(std::size_t thread_index, pika::barrier<>& b,
+    queue_type& q)
+{
+    b.arrive_and_wait();
+
+    // the producer of each item is item / num_items_per_producer
+    for (std::size_t i = 0; i != num_items_per_producer; ++i)
+    {
+        q.push(thread_index * num_items_per_producer + i);
+    }
+}
+
+void test_concurrent_consumer(std::size_t num_items, pika::barrier<>& b,
+    queue_type& q, std::atomic<std::size_t>& popped,
+    std::vector<std::size_t>& items)
+{
+    b.arrive_and_wait();
+
+    std::size_t value = 0;
+    while (popped < num_items)
+    {
+        if (q.pop(value))
+        {
+            ++popped;
+            items.push_back(value);
+        }
+        else
+        {
+            pika::this_thread::yield();
+        }
+    }
+}
+
+void test_concurrent()
+{
+    std::size_t const num_threads = pika::get_num_worker_threads();
+    // This test should be run on at least two worker threads.
+    PIKA_TEST_LTE(std::size_t(2), num_threads);
+
+    std::size_t const num_producers = num_threads / 2;
+    std::size_t const num_consumers = num_threads - num_producers;
+    std::size_t const num_items = num_producers * num_items_per_producer;
+
+    queue_type q;
+    std::atomic<std::size_t> popped(0);
+    std::vector<std::vector<std::size_t>> items(num_consumers);
+    pika::barrier<> b(num_threads);
+
+    std::vector<pika::future<void>> fs;
+    fs.reserve(num_threads);
+    for (std::size_t i = 0; i != num_producers; ++i)
+    {
+        fs.push_back(pika::async(
+            test_concurrent_producer, i, std::ref(b), std::ref(q)));
+    }
+    for (std::size_t i = 0; i != num_consumers; ++i)
+    {
+        fs.push_back(pika::async(test_concurrent_consumer, num_items,
+            std::ref(b), std::ref(q), std::ref(popped), std::ref(items[i])));
+    }
+
+    pika::wait_all(fs);
+
+    PIKA_TEST(q.empty());
+
+    // All items should have been popped exactly once, and each consumer
+    // should have seen the items of each producer in order.
+    std::vector<bool> seen(num_items, false);
+    for (auto const& consumer_items : items)
+    {
+        std::vector<std::size_t> last(num_producers, 0);
+        std::vector<bool> has_last(num_producers, false);
+        for (std::size_t item : consumer_items)
+        {
+            PIKA_TEST_LT(item, num_items);
+            PIKA_TEST(!seen[item]);
+            seen[item] = true;
+
+            std::size_t const producer = item / num_items_per_producer;
+            if (has_last[producer])
+            {
+                PIKA_TEST_LT(last[producer], item);
+            }
+            last[producer] = item;
+            has_last[producer] = true;
+        }
+    }
+
+    for (bool s : seen)
+    {
+        PIKA_TEST(s);
+    }
+}
+
+int pika_main()
+{
+    test_basic();
+    test_concurrent();
+
+    return pika::finalize();
+}
+
+int main(int argc, char** argv)
+{
+    PIKA_TEST_EQ(pika::init(pika_main, argc, argv), 0);
+    return pika::util::report_errors();
+}
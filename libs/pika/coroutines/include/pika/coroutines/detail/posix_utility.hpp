@@ -46,6 +46,7 @@
  */
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <stdexcept>
 
@@ -77,49 +78,33 @@ namespace pika { namespace threads { namespace coroutines { namespace detail {
 #if defined(PIKA_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) &&    \
     _POSIX_MAPPED_FILES > 0
 
-        inline void* alloc_stack(std::size_t size)
-        {
-            void* real_stack = ::mmap(nullptr, size + EXEC_PAGESIZE,
-                PROT_EXEC | PROT_READ | PROT_WRITE,
-#if defined(__APPLE__)
-                MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
-#elif defined(__FreeBSD__)
-                MAP_PRIVATE | MAP_ANON,
-#else
-                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
-#endif
-                -1, 0);
+        /// Stacks are served from a process-wide cache. Each worker thread
+        /// keeps a small magazine of recently released stacks, magazines are
+        /// refilled from (and drained to) a depot per NUMA domain. New stacks
+        /// are carved from large slabs which hold many stacks (and their
+        /// guard pages), stacks which were used beyond their first page are
+        /// trimmed using madvise when they are released.
+        PIKA_EXPORT void* alloc_stack(std::size_t size);
+        PIKA_EXPORT void free_stack(void* stack, std::size_t size);
 
-            if (real_stack == MAP_FAILED)
-            {
-                char const* error_message =
-                    "mmap() failed to allocate thread stack";
-                if (ENOMEM == errno && use_guard_pages)
-                {
-                    error_message =
-                        "mmap() failed to allocate thread stack due to "
-                        "insufficient resources, increase "
-                        "/proc/sys/vm/max_map_count or add "
-                        "-Ipika.stacks.use_guard_pages=0 to the command line";
-                }
-                throw std::runtime_error(error_message);
-            }
-
-#if defined(PIKA_HAVE_THREAD_GUARD_PAGE)
-            if (use_guard_pages)
-            {
-                // Add a guard page.
-                ::mprotect(real_stack, EXEC_PAGESIZE, PROT_NONE);
+        struct stack_cache_statistics
+        {
+            // allocations served from the magazine of the calling thread
+            std::int64_t magazine_hits = 0;
+            // allocations served from the depot of the NUMA domain
+            std::int64_t depot_hits = 0;
+            // allocations which required mapping new memory
+            std::int64_t misses = 0;
+            // released stacks whose unused pages were returned to the OS
+            std::int64_t trimmed = 0;
+            // stacks unmapped because the depot was full
+            std::int64_t unmapped = 0;
+            // number of mappings created to hold stacks
+            std::int64_t slabs = 0;
+        };
 
-                void** stack = static_cast<void**>(real_stack) +
-                    (EXEC_PAGESIZE / sizeof(void*));
-                return static_cast<void*>(stack);
-            }
-            return real_stack;
-#else
-            return real_stack;
-#endif
-        }
+        PIKA_EXPORT stack_cache_statistics get_stack_cache_statistics(
+            bool reset = false);
 
         inline void watermark_stack(void* stack, std::size_t size)
         {
@@ -143,30 +128,16 @@ namespace pika { namespace threads { namespace coroutines { namespace detail {
                 // We never free up the first page, as it's initialized only when the
                 // stack is created.
                 ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
+
+                // The watermark lives on the first page, restore it to detect
+                // the next time the stack grows past it.
+                *watermark = reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull);
                 return true;
             }
 
             return false;
         }
 
-        inline void free_stack(void* stack, std::size_t size)
-        {
-#if defined(PIKA_HAVE_THREAD_GUARD_PAGE)
-            if (use_guard_pages)
-            {
-                void** real_stack = static_cast<void**>(stack) -
-                    (EXEC_PAGESIZE / sizeof(void*));
-                ::munmap(static_cast<void*>(real_stack), size + EXEC_PAGESIZE);
-            }
-            else
-            {
-                ::munmap(stack, size);
-            }
-#else
-            ::munmap(stack, size);
-#endif
-        }
-
 #else    // non-mmap()
 
         //this should be a fine default.
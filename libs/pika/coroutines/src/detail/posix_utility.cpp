@@ -10,11 +10,416 @@
     defined(__FreeBSD__) || defined(__APPLE__)
 #include <pika/coroutines/detail/posix_utility.hpp>
 
+#if defined(PIKA_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) &&    \
+    _POSIX_MAPPED_FILES > 0
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
 namespace pika { namespace threads { namespace coroutines { namespace detail {
     namespace posix {
         ///////////////////////////////////////////////////////////////////////
         // this global (urghhh) variable is used to control whether guard pages
         // will be used or not
         PIKA_EXPORT bool use_guard_pages = true;
+
+#if defined(PIKA_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) &&    \
+    _POSIX_MAPPED_FILES > 0
+        namespace {
+            // number of NUMA domains with a separate depot, stacks of domains
+            // beyond this number share the depots
+            constexpr std::size_t max_numa_domains = 16;
+
+            // number of stacks a magazine holds per stack size, and number of
+            // different stack sizes a magazine holds stacks for
+            constexpr std::size_t magazine_size = 16;
+            constexpr std::size_t magazine_slots = 4;
+
+            // number of stacks (per stack size) a depot keeps before excess
+            // stacks are unmapped
+            constexpr std::size_t max_depot_size = 1024;
+
+            // new stacks are carved from slabs of up to this many bytes,
+            // each slab is reserved using a single mmap
+            constexpr std::size_t slab_bytes = 16 * 1024 * 1024;
+
+            struct stack_cache_counters
+            {
+                std::atomic<std::int64_t> magazine_hits{0};
+                std::atomic<std::int64_t> depot_hits{0};
+                std::atomic<std::int64_t> misses{0};
+                std::atomic<std::int64_t> trimmed{0};
+                std::atomic<std::int64_t> unmapped{0};
+                std::atomic<std::int64_t> slabs{0};
+            };
+
+            stack_cache_counters& get_counters()
+            {
+                static stack_cache_counters counters;
+                return counters;
+            }
+
+            std::size_t guard_size() noexcept
+            {
+#if defined(PIKA_HAVE_THREAD_GUARD_PAGE)
+                return use_guard_pages ? EXEC_PAGESIZE : 0;
+#else
+                return 0;
+#endif
+            }
+
+            std::size_t current_numa_domain() noexcept
+            {
+#if defined(__linux__) && defined(SYS_getcpu)
+                unsigned cpu = 0;
+                unsigned node = 0;
+                if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+                {
+                    return node % max_numa_domains;
+                }
+#endif
+                return 0;
+            }
+
+            // Reserve the given number of bytes for stacks (including their
+            // guard pages), returns the start of the mapping.
+            char* map_slab(std::size_t bytes)
+            {
+                void* real_stack = ::mmap(nullptr, bytes,
+                    PROT_EXEC | PROT_READ | PROT_WRITE,
+#if defined(__APPLE__)
+                    MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
+#elif defined(__FreeBSD__)
+                    MAP_PRIVATE | MAP_ANON,
+#else
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+#endif
+                    -1, 0);
+
+                if (real_stack == MAP_FAILED)
+                {
+                    char const* error_message =
+                        "mmap() failed to allocate thread stack";
+                    if (ENOMEM == errno && use_guard_pages)
+                    {
+                        error_message =
+                            "mmap() failed to allocate thread stack due to "
+                            "insufficient resources, increase "
+                            "/proc/sys/vm/max_map_count or add "
+                            "-Ipika.stacks.use_guard_pages=0 to the command "
+                            "line";
+                    }
+                    throw std::runtime_error(error_message);
+                }
+                get_counters().slabs.fetch_add(1, std::memory_order_relaxed);
+                return static_cast<char*>(real_stack);
+            }
+
+#if defined(PIKA_HAVE_THREAD_GUARD_PAGE)
+#if defined(__linux__) && !defined(MADV_GUARD_INSTALL)
+#define MADV_GUARD_INSTALL 102
+#endif
+
+            // Turn the given page into a guard page. Protecting a page in the
+            // middle of a slab using mprotect splits the mapping, i.e. every
+            // stack would cost two VMAs. Newer Linux kernels (6.13+) support
+            // installing guard pages without splitting the mapping, use that
+            // if possible. Accessing either kind of guard page raises SIGSEGV.
+            void install_guard_page(char* page) noexcept
+            {
+#if defined(MADV_GUARD_INSTALL)
+                static std::atomic<bool> have_guard_install{true};
+                if (have_guard_install.load(std::memory_order_relaxed))
+                {
+                    if (::madvise(page, EXEC_PAGESIZE, MADV_GUARD_INSTALL) ==
+                        0)
+                    {
+                        return;
+                    }
+                    have_guard_install.store(false, std::memory_order_relaxed);
+                }
+#endif
+                ::mprotect(page, EXEC_PAGESIZE, PROT_NONE);
+            }
+#endif
+
+            // Turn the start of the memory of one stack into the stack itself
+            void* setup_stack(char* real_stack) noexcept
+            {
+#if defined(PIKA_HAVE_THREAD_GUARD_PAGE)
+                if (use_guard_pages)
+                {
+                    // Add a guard page.
+                    install_guard_page(real_stack);
+                    return real_stack + EXEC_PAGESIZE;
+                }
+#endif
+                return real_stack;
+            }
+
+            void unmap_stack(void* stack, std::size_t size) noexcept
+            {
+                std::size_t const guard = guard_size();
+                ::munmap(static_cast<char*>(stack) - guard, size + guard);
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // The depot of a NUMA domain holds the stacks which don't fit into
+            // the magazines of the worker threads anymore.
+            struct alignas(64) stack_depot
+            {
+                struct bucket
+                {
+                    std::size_t size;
+                    std::vector<void*> stacks;
+                };
+
+                std::vector<void*>& get(std::size_t size)
+                {
+                    for (bucket& b : buckets_)
+                    {
+                        if (b.size == size)
+                        {
+                            return b.stacks;
+                        }
+                    }
+                    buckets_.push_back(bucket{size, {}});
+                    return buckets_.back().stacks;
+                }
+
+                std::mutex mtx_;
+                std::vector<bucket> buckets_;
+            };
+
+            stack_depot& get_depot(std::size_t domain)
+            {
+                // The depots are intentionally leaked, stacks may be released
+                // during static destruction.
+                static stack_depot* depots = new stack_depot[max_numa_domains];
+                return depots[domain];
+            }
+
+            // Move stacks to the depot of the current NUMA domain, unmap the
+            // stacks which don't fit into it anymore.
+            void release_to_depot(
+                std::size_t size, void** stacks, std::size_t count)
+            {
+                void* excess[magazine_size + 1];
+                std::size_t num_excess = 0;
+
+                {
+                    stack_depot& d = get_depot(current_numa_domain());
+                    std::lock_guard<std::mutex> l(d.mtx_);
+
+                    std::vector<void*>& v = d.get(size);
+                    std::size_t const fits = v.size() < max_depot_size ?
+                        (std::min)(max_depot_size - v.size(), count) :
+                        0;
+                    v.insert(v.end(), stacks, stacks + fits);
+
+                    for (std::size_t i = fits; i != count; ++i)
+                    {
+                        excess[num_excess++] = stacks[i];
+                    }
+                }
+
+                for (std::size_t i = 0; i != num_excess; ++i)
+                {
+                    unmap_stack(excess[i], size);
+                }
+                get_counters().unmapped.fetch_add(
+                    std::int64_t(num_excess), std::memory_order_relaxed);
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Every (worker) thread caches a small number of stacks for each
+            // of the stack sizes it uses. New stacks are carved from the
+            // current slab of the slot by bumping a pointer.
+            struct stack_magazine
+            {
+                struct slot
+                {
+                    std::size_t size = 0;
+                    std::size_t count = 0;
+                    void* stacks[magazine_size];
+                    char* slab_next = nullptr;
+                    char* slab_end = nullptr;
+                };
+
+                stack_magazine() = default;
+                stack_magazine(stack_magazine const&) = delete;
+                stack_magazine& operator=(stack_magazine const&) = delete;
+
+                ~stack_magazine()
+                {
+                    for (slot& s : slots_)
+                    {
+                        if (s.count != 0)
+                        {
+                            release_to_depot(s.size, s.stacks, s.count);
+                        }
+                        if (s.slab_next != s.slab_end)
+                        {
+                            ::munmap(s.slab_next,
+                                std::size_t(s.slab_end - s.slab_next));
+                        }
+                    }
+                }
+
+                // returns nullptr if all slots are used for other sizes
+                slot* get(std::size_t size) noexcept
+                {
+                    for (slot& s : slots_)
+                    {
+                        if (s.size == size)
+                        {
+                            return &s;
+                        }
+                        if (s.size == 0)
+                        {
+                            s.size = size;
+                            return &s;
+                        }
+                    }
+                    return nullptr;
+                }
+
+                slot slots_[magazine_slots];
+            };
+
+            stack_magazine& get_magazine()
+            {
+                static thread_local stack_magazine magazine;
+                return magazine;
+            }
+        }    // namespace
+
+        ///////////////////////////////////////////////////////////////////////
+        void* alloc_stack(std::size_t size)
+        {
+            stack_cache_counters& counters = get_counters();
+
+#if !defined(PIKA_HAVE_ADDRESS_SANITIZER)
+            stack_magazine::slot* s = get_magazine().get(size);
+            if (s != nullptr && s->count != 0)
+            {
+                counters.magazine_hits.fetch_add(1, std::memory_order_relaxed);
+                return s->stacks[--s->count];
+            }
+
+            // refill the magazine from the depot of this NUMA domain
+            {
+                stack_depot& d = get_depot(current_numa_domain());
+                std::lock_guard<std::mutex> l(d.mtx_);
+
+                std::vector<void*>& v = d.get(size);
+                if (!v.empty())
+                {
+                    void* stack = v.back();
+                    v.pop_back();
+
+                    while (s != nullptr && !v.empty() &&
+                        s->count < magazine_size / 2)
+                    {
+                        s->stacks[s->count++] = v.back();
+                        v.pop_back();
+                    }
+
+                    counters.depot_hits.fetch_add(
+                        1, std::memory_order_relaxed);
+                    return stack;
+                }
+            }
+
+            // carve a new stack from the current slab, reserve a new slab if
+            // the current one is exhausted
+            std::size_t const stride = size + guard_size();
+            char* real_stack = nullptr;
+            if (s == nullptr)
+            {
+                real_stack = map_slab(stride);
+            }
+            else
+            {
+                if (s->slab_next == s->slab_end)
+                {
+                    std::size_t const bytes =
+                        (std::max)(std::size_t(1), slab_bytes / stride) *
+                        stride;
+                    s->slab_next = map_slab(bytes);
+                    s->slab_end = s->slab_next + bytes;
+                }
+                real_stack = s->slab_next;
+                s->slab_next += stride;
+            }
+#else
+            // ASAN gets confused by reusing stacks
+            char* real_stack = map_slab(size + guard_size());
+#endif
+
+            counters.misses.fetch_add(1, std::memory_order_relaxed);
+            return setup_stack(real_stack);
+        }
+
+        void free_stack(void* stack, std::size_t size)
+        {
+#if !defined(PIKA_HAVE_ADDRESS_SANITIZER)
+            // return the pages of deeply used stacks to the OS
+            if (reset_stack(stack, size))
+            {
+                get_counters().trimmed.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            stack_magazine::slot* s = get_magazine().get(size);
+            if (s != nullptr && s->count != magazine_size)
+            {
+                s->stacks[s->count++] = stack;
+                return;
+            }
+
+            // the magazine is full, move half of it to the depot
+            void* stacks[magazine_size / 2 + 1];
+            std::size_t count = 0;
+
+            stacks[count++] = stack;
+            while (s != nullptr && count != magazine_size / 2 + 1)
+            {
+                stacks[count++] = s->stacks[--s->count];
+            }
+            release_to_depot(size, stacks, count);
+#else
+            unmap_stack(stack, size);
+#endif
+        }
+
+        stack_cache_statistics get_stack_cache_statistics(bool reset)
+        {
+            stack_cache_counters& counters = get_counters();
+            auto get = [reset](std::atomic<std::int64_t>& value) {
+                return reset ? value.exchange(0, std::memory_order_relaxed) :
+                               value.load(std::memory_order_relaxed);
+            };
+
+            stack_cache_statistics result;
+            result.magazine_hits = get(counters.magazine_hits);
+            result.depot_hits = get(counters.depot_hits);
+            result.misses = get(counters.misses);
+            result.trimmed = get(counters.trimmed);
+            result.unmapped = get(counters.unmapped);
+            result.slabs = get(counters.slabs);
+            return result;
+        }
+#endif
 }}}}}    // namespace pika::threads::coroutines::detail::posix
 #endif
@@ -7,17 +7,18 @@
 #pragma once
 
 #include <pika/config.hpp>
+#include <pika/assert.hpp>
 #include <pika/concepts/concepts.hpp>
 #include <pika/datastructures/variant.hpp>
 #include <pika/execution/algorithms/detail/partial_algorithm.hpp>
 #include <pika/execution/algorithms/detail/single_result.hpp>
+#include <pika/execution_base/agent_ref.hpp>
 #include <pika/execution_base/operation_state.hpp>
 #include <pika/execution_base/sender.hpp>
+#include <pika/execution_base/this_thread.hpp>
 #include <pika/functional/detail/tag_fallback_invoke.hpp>
-#include <pika/synchronization/condition_variable.hpp>
-#include <pika/synchronization/spinlock.hpp>
+#include <pika/threading_base/thread_data.hpp>
 #include <pika/type_support/pack.hpp>
-#include <pika/type_support/unused.hpp>
 
 #include <atomic>
 #include <exception>
@@ -83,25 +84,88 @@ namespace pika { namespace execution { namespace experimental {
                     predecessor_error_types<pika::variant>,
                     std::exception_ptr>>;
 
-            // We use a spinlock here to allow taking the lock on non-pika threads.
-            using mutex_type = pika::lcos::local::spinlock;
+            // sync_wait may be called on pika threads and on other threads. A
+            // pika thread is suspended until the predecessor sender signals
+            // completion. Other threads block in std::atomic::wait if it is
+            // available, and are suspended through their default execution
+            // agent otherwise.
+            enum class wait_state
+            {
+                empty,
+                waiting,
+                waiting_os_thread,
+                ready
+            };
 
             struct shared_state
             {
-                pika::lcos::local::condition_variable cond_var;
-                mutex_type mtx;
-                std::atomic<bool> set_called = false;
+                std::atomic<wait_state> state{wait_state::empty};
+                pika::execution_base::agent_ref waiter;
                 pika::variant<pika::monostate, error_type, value_type> value;
 
                 void wait()
                 {
-                    if (!set_called)
+                    // the predecessor may have completed synchronously
+                    if (state.load(std::memory_order_acquire) ==
+                        wait_state::ready)
+                    {
+                        return;
+                    }
+
+#if defined(PIKA_HAVE_CXX20_STD_ATOMIC_WAIT)
+                    if (pika::threads::get_self_ptr() == nullptr)
                     {
-                        std::unique_lock<mutex_type> l(mtx);
-                        if (!set_called)
+                        wait_state expected = wait_state::empty;
+                        if (state.compare_exchange_strong(expected,
+                                wait_state::waiting_os_thread,
+                                std::memory_order_acq_rel))
                         {
-                            cond_var.wait(l);
+                            state.wait(wait_state::waiting_os_thread,
+                                std::memory_order_acquire);
                         }
+                        return;
+                    }
+#endif
+
+                    // the agent has to be stored before the waiting state
+                    // is published
+                    waiter = pika::execution_base::this_thread::agent();
+                    wait_state expected = wait_state::empty;
+                    if (state.compare_exchange_strong(expected,
+                            wait_state::waiting, std::memory_order_acq_rel))
+                    {
+                        // only set_ready resumes the waiting thread
+                        waiter.suspend("sync_wait");
+                    }
+                    PIKA_ASSERT(state.load(std::memory_order_acquire) ==
+                        wait_state::ready);
+                }
+
+                // The waiting thread may destroy the shared state as soon as
+                // it has observed the ready state. Only notify_one (which, as
+                // for std::counting_semaphore::release, relies on the address
+                // of the state only) may follow the store of the ready state.
+                void set_ready() noexcept
+                {
+                    switch (state.exchange(
+                        wait_state::ready, std::memory_order_acq_rel))
+                    {
+                    case wait_state::waiting:
+                    {
+                        // the waiting thread stays suspended until it is
+                        // resumed, copy the agent to not touch the shared
+                        // state afterwards
+                        pika::execution_base::agent_ref w = waiter;
+                        w.resume("sync_wait");
+                        break;
+                    }
+#if defined(PIKA_HAVE_CXX20_STD_ATOMIC_WAIT)
+                    case wait_state::waiting_os_thread:
+                        state.notify_one();
+                        break;
+#endif
+                    default:
+                        break;
                     }
                 }
 
@@ -132,28 +196,18 @@ namespace pika { namespace execution { namespace experimental {
 
             shared_state& state;
 
-            void signal_set_called() noexcept
-            {
-                std::unique_lock<mutex_type> l(state.mtx);
-                state.set_called = true;
-                pika::util::ignore_while_checking il(&l);
-                PIKA_UNUSED(il);
-
-                state.cond_var.notify_one();
-            }
-
             template <typename Error>
             friend void tag_invoke(
                 set_error_t, sync_wait_receiver&& r, Error&& error) noexcept
             {
                 r.state.value.template emplace<error_type>(
                     PIKA_FORWARD(Error, error));
-                r.signal_set_called();
+                r.state.set_ready();
             }
 
             friend void tag_invoke(set_done_t, sync_wait_receiver&& r) noexcept
             {
-                r.signal_set_called();
+                r.state.set_ready();
             }
 
             template <typename... Us,
@@ -165,7 +219,7 @@ namespace pika { namespace execution { namespace experimental {
             {
                 r.state.value.template emplace<value_type>(
                     PIKA_FORWARD(Us, us)...);
-                r.signal_set_called();
+                r.state.set_ready();
             }
         };
     }    // namespace detail
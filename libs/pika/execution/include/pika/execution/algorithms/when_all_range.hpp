@@ -0,0 +1,360 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/concepts/concepts.hpp>
+#include <pika/datastructures/optional.hpp>
+#include <pika/datastructures/variant.hpp>
+#include <pika/execution/algorithms/detail/single_result.hpp>
+#include <pika/execution_base/operation_state.hpp>
+#include <pika/execution_base/receiver.hpp>
+#include <pika/execution_base/sender.hpp>
+#include <pika/functional/detail/tag_fallback_invoke.hpp>
+#include <pika/iterator_support/range.hpp>
+#include <pika/iterator_support/traits/is_range.hpp>
+#include <pika/type_support/pack.hpp>
+#include <pika/type_support/unused.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pika { namespace execution { namespace experimental {
+    namespace detail {
+        // This is a receiver to be connected to the ith predecessor sender
+        // passed to when_all_range. When set_value is called, it will store
+        // the value sent at the ith position of the vector holding the values
+        // from all predecessor senders.
+        template <typename OperationState>
+        struct when_all_range_receiver
+        {
+            OperationState& op_state;
+            std::size_t i;
+
+            template <typename Error>
+            friend void tag_invoke(set_error_t, when_all_range_receiver&& r,
+                Error&& error) noexcept
+            {
+                if (!r.op_state.set_done_error_called.exchange(true))
+                {
+                    try
+                    {
+                        r.op_state.error = PIKA_FORWARD(Error, error);
+                    }
+                    catch (...)
+                    {
+                        // NOLINTNEXTLINE(bugprone-throw-keyword-missing)
+                        r.op_state.error = std::current_exception();
+                    }
+                }
+
+                r.op_state.finish();
+            }
+
+            friend void tag_invoke(
+                set_done_t, when_all_range_receiver&& r) noexcept
+            {
+                r.op_state.set_done_error_called = true;
+                r.op_state.finish();
+            };
+
+            template <typename... Ts>
+            friend void tag_invoke(
+                set_value_t, when_all_range_receiver&& r, Ts&&... ts) noexcept
+            {
+                r.op_state.set_value(r.i, PIKA_FORWARD(Ts, ts)...);
+            }
+        };
+
+        template <typename T, template <typename...> class Tuple,
+            template <typename...> class Variant>
+        struct when_all_range_value_types
+        {
+            using type = Variant<Tuple<std::vector<T>>>;
+        };
+
+        template <template <typename...> class Tuple,
+            template <typename...> class Variant>
+        struct when_all_range_value_types<void, Tuple, Variant>
+        {
+            using type = Variant<Tuple<>>;
+        };
+
+        template <typename Range>
+        struct when_all_range_sender
+        {
+            using range_type = std::decay_t<Range>;
+            using sender_type = std::decay_t<
+                typename std::iterator_traits<typename pika::traits::
+                        range_iterator<range_type>::type>::value_type>;
+
+            static_assert(is_sender_v<sender_type>,
+                "when_all_range expects a range of senders");
+
+            range_type senders;
+
+            // The type of the value sent by each predecessor sender, or void
+            // if the predecessors send no value.
+            using result_type = std::decay_t<detail::single_result_t<
+                typename sender_traits<sender_type>::template value_types<
+                    pika::util::pack, pika::util::pack>>>;
+
+            static_assert(std::is_void_v<result_type> ||
+                    std::is_default_constructible_v<result_type>,
+                "when_all_range expects the values sent by the predecessor "
+                "senders to be default constructible");
+
+            // The values sent by all predecessor senders are forwarded as one
+            // vector, in the order of the senders in the range.
+            template <template <typename...> class Tuple,
+                template <typename...> class Variant>
+            using value_types = typename when_all_range_value_types<result_type,
+                Tuple, Variant>::type;
+
+            template <template <typename...> class Variant>
+            using error_types = pika::util::detail::unique_concat_t<
+                typename sender_traits<sender_type>::template error_types<
+                    Variant>,
+                Variant<std::exception_ptr>>;
+
+            static constexpr bool sends_done =
+                sender_traits<sender_type>::sends_done;
+
+            template <typename Receiver, typename SenderRef>
+            struct operation_state
+            {
+                using operation_state_type = std::decay_t<decltype(
+                    pika::execution::experimental::connect(
+                        std::declval<SenderRef>(),
+                        std::declval<
+                            when_all_range_receiver<operation_state>>()))>;
+                using allocator_type = std::allocator<operation_state_type>;
+                using values_type =
+                    std::conditional_t<std::is_void_v<result_type>,
+                        pika::util::unused_type, std::vector<result_type>>;
+
+                PIKA_NO_UNIQUE_ADDRESS std::decay_t<Receiver> receiver;
+                std::size_t num_predecessors;
+
+                // Number of predecessor senders that have not yet called any of
+                // the set signals.
+                std::atomic<std::size_t> predecessors_remaining;
+
+                // The values sent by the predecessor senders are stored here,
+                // the vector is allocated up front and handed to the receiver
+                // without copying.
+                PIKA_NO_UNIQUE_ADDRESS values_type values;
+
+                pika::optional<error_types<pika::variant>> error;
+                std::atomic<bool> set_done_error_called{false};
+
+                // The operation states of all predecessor senders are stored
+                // in one contiguous allocation.
+                PIKA_NO_UNIQUE_ADDRESS allocator_type alloc;
+                operation_state_type* op_states = nullptr;
+
+                template <typename Receiver_, typename Range_>
+                operation_state(Receiver_&& receiver, Range_&& senders)
+                  : receiver(PIKA_FORWARD(Receiver_, receiver))
+                  , num_predecessors(pika::util::size(senders))
+                  , predecessors_remaining(num_predecessors)
+                {
+                    if (num_predecessors == 0)
+                    {
+                        return;
+                    }
+
+                    if constexpr (!std::is_void_v<result_type>)
+                    {
+                        values.resize(num_predecessors);
+                    }
+
+                    op_states = std::allocator_traits<allocator_type>::allocate(
+                        alloc, num_predecessors);
+
+                    std::size_t i = 0;
+                    try
+                    {
+                        for (auto&& sender : senders)
+                        {
+                            ::new (static_cast<void*>(op_states + i))
+                                operation_state_type(
+                                    pika::execution::experimental::connect(
+                                        static_cast<SenderRef>(sender),
+                                        when_all_range_receiver<
+                                            operation_state>{*this, i}));
+                            ++i;
+                        }
+                    }
+                    catch (...)
+                    {
+                        destroy(i);
+                        throw;
+                    }
+                }
+
+                operation_state(operation_state&&) = delete;
+                operation_state& operator=(operation_state&&) = delete;
+                operation_state(operation_state const&) = delete;
+                operation_state& operator=(operation_state const&) = delete;
+
+                ~operation_state()
+                {
+                    if (op_states != nullptr)
+                    {
+                        destroy(num_predecessors);
+                    }
+                }
+
+                void destroy(std::size_t count) noexcept
+                {
+                    for (std::size_t i = 0; i != count; ++i)
+                    {
+                        std::destroy_at(op_states + i);
+                    }
+                    std::allocator_traits<allocator_type>::deallocate(
+                        alloc, op_states, num_predecessors);
+                    op_states = nullptr;
+                }
+
+                void set_value(std::size_t) noexcept
+                {
+                    finish();
+                }
+
+                template <typename T>
+                void set_value(std::size_t i, T&& t) noexcept
+                {
+                    if (!set_done_error_called)
+                    {
+                        try
+                        {
+                            values[i] = PIKA_FORWARD(T, t);
+                        }
+                        catch (...)
+                        {
+                            if (!set_done_error_called.exchange(true))
+                            {
+                                // NOLINTNEXTLINE(bugprone-throw-keyword-missing)
+                                error = std::current_exception();
+                            }
+                        }
+                    }
+
+                    finish();
+                }
+
+                void set_value_helper() noexcept
+                {
+                    if constexpr (std::is_void_v<result_type>)
+                    {
+                        pika::execution::experimental::set_value(
+                            PIKA_MOVE(receiver));
+                    }
+                    else
+                    {
+                        pika::execution::experimental::set_value(
+                            PIKA_MOVE(receiver), PIKA_MOVE(values));
+                    }
+                }
+
+                void finish() noexcept
+                {
+                    if (--predecessors_remaining == 0)
+                    {
+                        if (!set_done_error_called)
+                        {
+                            set_value_helper();
+                        }
+                        else if (error)
+                        {
+                            pika::visit(
+                                [this](auto&& error) {
+                                    pika::execution::experimental::set_error(
+                                        PIKA_MOVE(receiver),
+                                        PIKA_FORWARD(decltype(error), error));
+                                },
+                                PIKA_MOVE(error.value()));
+                        }
+                        else
+                        {
+                            pika::execution::experimental::set_done(
+                                PIKA_MOVE(receiver));
+                        }
+                    }
+                }
+
+                friend void tag_invoke(start_t, operation_state& os) noexcept
+                {
+                    if (os.num_predecessors == 0)
+                    {
+                        os.set_value_helper();
+                        return;
+                    }
+
+                    // The last predecessor to finish may release this
+                    // operation state, it must not be accessed after starting
+                    // the last predecessor.
+                    operation_state_type* const op_states = os.op_states;
+                    std::size_t const num_predecessors = os.num_predecessors;
+                    for (std::size_t i = 0; i != num_predecessors; ++i)
+                    {
+                        pika::execution::experimental::start(op_states[i]);
+                    }
+                }
+            };
+
+            template <typename Receiver>
+            friend operation_state<Receiver, sender_type&&> tag_invoke(
+                connect_t, when_all_range_sender&& s, Receiver&& receiver)
+            {
+                return {PIKA_FORWARD(Receiver, receiver), s.senders};
+            }
+
+            template <typename Receiver>
+            friend operation_state<Receiver, sender_type&> tag_invoke(
+                connect_t, when_all_range_sender& s, Receiver&& receiver)
+            {
+                return {PIKA_FORWARD(Receiver, receiver), s.senders};
+            }
+        };
+    }    // namespace detail
+
+    // when_all_range is a variant of when_all for a range of senders whose
+    // number is only known at runtime. All senders in the range must be of
+    // the same type and send either no value or a single value. The returned
+    // sender sends a vector of all values in the order of the senders in the
+    // range, or no value if the predecessor senders send no value.
+    //
+    // The operation states of all predecessor senders are created in a single
+    // allocation when the sender is connected, the vector of values is
+    // allocated at the same time.
+    inline constexpr struct when_all_range_t final
+      : pika::functional::detail::tag_fallback<when_all_range_t>
+    {
+    private:
+        // clang-format off
+        template <typename Range,
+            PIKA_CONCEPT_REQUIRES_(
+                pika::traits::is_range_v<std::decay_t<Range>>
+            )>
+        // clang-format on
+        friend constexpr PIKA_FORCEINLINE auto tag_fallback_invoke(
+            when_all_range_t, Range&& senders)
+        {
+            return detail::when_all_range_sender<Range>{
+                PIKA_FORWARD(Range, senders)};
+        }
+    } when_all_range{};
+}}}    // namespace pika::execution::experimental
@@ -11,5 +11,6 @@
 #include <pika/execution/executors/auto_chunk_size.hpp>
 #include <pika/execution/executors/dynamic_chunk_size.hpp>
 #include <pika/execution/executors/guided_chunk_size.hpp>
+#include <pika/execution/executors/persistent_affinity_chunk_size.hpp>
 #include <pika/execution/executors/persistent_auto_chunk_size.hpp>
 #include <pika/execution/executors/static_chunk_size.hpp>
@@ -0,0 +1,96 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/persistent_affinity_chunk_size.hpp
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/execution_base/traits/is_executor_parameters.hpp>
+#include <pika/serialization/serialize.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace pika { namespace execution {
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations are divided into a fixed number of equally sized
+    /// chunks per core. Chunk \a i is always scheduled on the worker thread
+    /// \a i modulo the number of cores, such that successive algorithm
+    /// invocations on the same sequence (e.g. the sweeps of an iterative
+    /// solver) process every chunk on the same core and find its data in
+    /// that core's caches.
+    ///
+    /// \note The chunks are scheduled using a thread_schedule_hint. Work
+    ///       stealing is not disabled: a worker thread steals chunks only
+    ///       after it has run out of its own work.
+    ///
+    struct persistent_affinity_chunk_size
+    {
+        /// \cond NOINTERNAL
+        using has_chunk_affinity = std::true_type;
+        /// \endcond
+
+        /// Construct a \a persistent_affinity_chunk_size executor parameters
+        /// object
+        ///
+        /// \note Default constructed \a persistent_affinity_chunk_size
+        ///       executor parameters create one chunk per core.
+        ///
+        constexpr persistent_affinity_chunk_size()
+          : chunks_per_core_(1)
+        {
+        }
+
+        /// Construct a \a persistent_affinity_chunk_size executor parameters
+        /// object
+        ///
+        /// \param chunks_per_core  [in] The number of chunks to create for
+        ///                         every core.
+        ///
+        constexpr explicit persistent_affinity_chunk_size(
+            std::size_t chunks_per_core)
+          : chunks_per_core_(chunks_per_core != 0 ? chunks_per_core : 1)
+        {
+        }
+
+        /// \cond NOINTERNAL
+        template <typename Executor, typename F>
+        std::size_t get_chunk_size(Executor& /* exec */, F&&,
+            std::size_t cores, std::size_t count)
+        {
+            std::size_t const num_chunks = cores * chunks_per_core_;
+            return (count + num_chunks - 1) / num_chunks;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class pika::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive& ar, const unsigned int /* version */)
+        {
+            ar& chunks_per_core_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t chunks_per_core_;
+        /// \endcond
+    };
+}}    // namespace pika::execution
+
+namespace pika { namespace parallel { namespace execution {
+    /// \cond NOINTERNAL
+    template <>
+    struct is_executor_parameters<
+        pika::execution::persistent_affinity_chunk_size> : std::true_type
+    {
+    };
+    /// \endcond
+}}}    // namespace pika::parallel::execution
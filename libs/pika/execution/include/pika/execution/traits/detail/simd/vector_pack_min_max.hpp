@@ -0,0 +1,36 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// make inspect happy: pikainspect:nominmax
+
+#pragma once
+
+#include <pika/config.hpp>
+
+#if defined(PIKA_HAVE_CXX20_EXPERIMENTAL_SIMD)
+#include <experimental/simd>
+
+namespace pika { namespace parallel { namespace traits {
+    ///////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE std::experimental::simd<T, Abi>
+    elementwise_min(std::experimental::simd<T, Abi> const& lhs,
+        std::experimental::simd<T, Abi> const& rhs)
+    {
+        return std::experimental::min(lhs, rhs);
+    }
+
+    ///////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE std::experimental::simd<T, Abi>
+    elementwise_max(std::experimental::simd<T, Abi> const& lhs,
+        std::experimental::simd<T, Abi> const& rhs)
+    {
+        return std::experimental::max(lhs, rhs);
+    }
+}}}    // namespace pika::parallel::traits
+
+#endif
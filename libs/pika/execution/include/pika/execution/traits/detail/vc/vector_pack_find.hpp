@@ -26,6 +26,21 @@ namespace pika { namespace parallel { namespace traits {
         }
         return -1;
     }
+
+    ///////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE int find_last_of(
+        Vc::Mask<T, Abi> const& msk)
+    {
+        for (int i = int(msk.size()) - 1; i >= 0; --i)
+        {
+            if (msk[i])
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
 }}}    // namespace pika::parallel::traits
 
 #endif
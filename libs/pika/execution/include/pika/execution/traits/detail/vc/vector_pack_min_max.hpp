@@ -0,0 +1,35 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// make inspect happy: pikainspect:nominmax
+
+#pragma once
+
+#include <pika/config.hpp>
+
+#if defined(PIKA_HAVE_DATAPAR_VC)
+#include <Vc/Vc>
+#include <Vc/global.h>
+
+namespace pika { namespace parallel { namespace traits {
+    ///////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE Vc::Vector<T, Abi> elementwise_min(
+        Vc::Vector<T, Abi> const& lhs, Vc::Vector<T, Abi> const& rhs)
+    {
+        return Vc::min(lhs, rhs);
+    }
+
+    ///////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    PIKA_HOST_DEVICE PIKA_FORCEINLINE Vc::Vector<T, Abi> elementwise_max(
+        Vc::Vector<T, Abi> const& lhs, Vc::Vector<T, Abi> const& rhs)
+    {
+        return Vc::max(lhs, rhs);
+    }
+}}}    // namespace pika::parallel::traits
+
+#endif
@@ -0,0 +1,18 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+
+#if defined(PIKA_HAVE_DATAPAR)
+
+#if !defined(__CUDACC__)
+#include <pika/execution/traits/detail/simd/vector_pack_min_max.hpp>
+#include <pika/execution/traits/detail/vc/vector_pack_min_max.hpp>
+#endif
+
+#endif
@@ -14,11 +14,80 @@
 #include <exception>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
 namespace ex = pika::execution::experimental;
 
+// Sends x from a separate std::thread, which makes sync_wait wait for the
+// value to arrive
+struct thread_sender
+{
+    int x;
+
+    template <template <class...> class Tuple,
+        template <class...> class Variant>
+    using value_types = Variant<Tuple<int>>;
+
+    template <template <class...> class Variant>
+    using error_types = Variant<std::exception_ptr>;
+
+    static constexpr bool sends_done = false;
+
+    template <typename R>
+    struct operation_state
+    {
+        int x;
+        std::decay_t<R> r;
+        std::thread t;
+
+        ~operation_state()
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+
+        friend void tag_invoke(ex::start_t, operation_state& os) noexcept
+        {
+            os.t = std::thread([&os]() {
+                std::this_thread::yield();
+                ex::set_value(std::move(os.r), os.x);
+            });
+        }
+    };
+
+    template <typename R>
+    friend auto tag_invoke(ex::connect_t, thread_sender&& s, R&& r)
+    {
+        return operation_state<R>{s.x, std::forward<R>(r), std::thread()};
+    }
+};
+
+void test_sync_wait_on_thread()
+{
+    for (int i = 0; i != 100; ++i)
+    {
+        PIKA_TEST_EQ(ex::sync_wait(ex::just(i)), i);
+        PIKA_TEST_EQ(ex::sync_wait(thread_sender{i}), i);
+    }
+
+    bool exception_thrown = false;
+    try
+    {
+        ex::sync_wait(error_sender{});
+        PIKA_TEST(false);
+    }
+    catch (std::runtime_error const& e)
+    {
+        PIKA_TEST_EQ(std::string(e.what()), std::string("error"));
+        exception_thrown = true;
+    }
+    PIKA_TEST(exception_thrown);
+}
+
 // NOTE: This is not a conforming sync_wait implementation. It only exists to
 // check that the tag_invoke overload is called.
 void tag_invoke(ex::sync_wait_t, custom_sender2 s)
@@ -105,6 +174,10 @@ int pika_main()
         PIKA_TEST(exception_thrown);
     }
 
+    // Waiting on a pika thread and on a thread not managed by pika
+    test_sync_wait_on_thread();
+    std::thread(&test_sync_wait_on_thread).join();
+
     return pika::finalize();
 }
 
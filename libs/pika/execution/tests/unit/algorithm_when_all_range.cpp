@@ -0,0 +1,247 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/config.hpp>
+#include <pika/modules/execution.hpp>
+#include <pika/modules/testing.hpp>
+
+#include "algorithm_test_utils.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ex = pika::execution::experimental;
+
+// A sender which sends either its value, an error, or done
+struct int_or_error_sender
+{
+    enum class signal
+    {
+        value,
+        error,
+        done
+    };
+
+    int x;
+    signal s = signal::value;
+
+    template <template <class...> class Tuple,
+        template <class...> class Variant>
+    using value_types = Variant<Tuple<int>>;
+
+    template <template <class...> class Variant>
+    using error_types = Variant<std::exception_ptr>;
+
+    static constexpr bool sends_done = true;
+
+    template <typename R>
+    struct operation_state
+    {
+        std::decay_t<R> r;
+        int x;
+        signal s;
+
+        friend void tag_invoke(ex::start_t, operation_state& os) noexcept
+        {
+            switch (os.s)
+            {
+            case signal::value:
+                ex::set_value(std::move(os.r), os.x);
+                break;
+            case signal::error:
+                ex::set_error(std::move(os.r),
+                    std::make_exception_ptr(std::runtime_error("error")));
+                break;
+            case signal::done:
+                ex::set_done(std::move(os.r));
+                break;
+            }
+        }
+    };
+
+    template <typename R>
+    friend operation_state<R> tag_invoke(
+        ex::connect_t, int_or_error_sender s, R&& r)
+    {
+        return {std::forward<R>(r), s.x, s.s};
+    }
+};
+
+struct done_receiver
+{
+    std::atomic<bool>& set_done_called;
+
+    template <typename E>
+    friend void tag_invoke(ex::set_error_t, done_receiver&&, E&&) noexcept
+    {
+        PIKA_TEST(false);
+    }
+
+    friend void tag_invoke(ex::set_done_t, done_receiver&& r) noexcept
+    {
+        r.set_done_called = true;
+    }
+
+    template <typename... Ts>
+    friend void tag_invoke(ex::set_value_t, done_receiver&&, Ts&&...) noexcept
+    {
+        PIKA_TEST(false);
+    }
+};
+
+// This overload is only used to check dispatching. It is not a useful
+// implementation.
+auto tag_invoke(ex::when_all_range_t, std::vector<custom_sender_tag_invoke> ss)
+{
+    for (auto& s : ss)
+    {
+        s.tag_invoke_overload_called = true;
+    }
+    return ex::when_all_range(std::vector<void_sender>(ss.size()));
+}
+
+int main()
+{
+    // Success path
+    {
+        std::atomic<bool> set_value_called{false};
+        std::vector<int_or_error_sender> ss;
+        for (int i = 0; i != 1000; ++i)
+        {
+            ss.push_back(int_or_error_sender{i});
+        }
+        auto s = ex::when_all_range(std::move(ss));
+        static_assert(std::is_same_v<
+            ex::sender_traits<decltype(s)>::value_types<pika::util::pack,
+                pika::util::pack>,
+            pika::util::pack<pika::util::pack<std::vector<int>>>>);
+        auto f = [](std::vector<int> xs) {
+            PIKA_TEST_EQ(xs.size(), std::size_t(1000));
+            for (int i = 0; i != 1000; ++i)
+            {
+                PIKA_TEST_EQ(xs[i], i);
+            }
+        };
+        auto r = callback_receiver<decltype(f)>{f, set_value_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_value_called);
+    }
+
+    {
+        std::atomic<bool> set_value_called{false};
+        std::vector<decltype(ex::just(std::string()))> ss{
+            ex::just(std::string("hello")), ex::just(std::string("world"))};
+        auto s = ex::when_all_range(ss);
+        auto f = [](std::vector<std::string> xs) {
+            PIKA_TEST_EQ(xs.size(), std::size_t(2));
+            PIKA_TEST_EQ(xs[0], std::string("hello"));
+            PIKA_TEST_EQ(xs[1], std::string("world"));
+        };
+        auto r = callback_receiver<decltype(f)>{f, set_value_called};
+        // Connecting an lvalue sender should leave the senders intact.
+        auto os = ex::connect(s, std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_value_called);
+        PIKA_TEST_EQ(s.senders.size(), std::size_t(2));
+    }
+
+    {
+        std::atomic<bool> set_value_called{false};
+        auto s = ex::when_all_range(std::vector<void_sender>(10));
+        static_assert(std::is_same_v<
+            ex::sender_traits<decltype(s)>::value_types<pika::util::pack,
+                pika::util::pack>,
+            pika::util::pack<pika::util::pack<>>>);
+        auto f = [] {};
+        auto r = callback_receiver<decltype(f)>{f, set_value_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_value_called);
+    }
+
+    // An empty range completes immediately
+    {
+        std::atomic<bool> set_value_called{false};
+        auto s = ex::when_all_range(std::vector<int_or_error_sender>{});
+        auto f = [](std::vector<int> xs) { PIKA_TEST(xs.empty()); };
+        auto r = callback_receiver<decltype(f)>{f, set_value_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_value_called);
+    }
+
+    {
+        std::atomic<bool> set_value_called{false};
+        auto s = ex::when_all_range(std::vector<void_sender>{});
+        auto f = [] {};
+        auto r = callback_receiver<decltype(f)>{f, set_value_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_value_called);
+    }
+
+    // Failure path
+    {
+        std::atomic<bool> set_error_called{false};
+        std::vector<int_or_error_sender> ss(100);
+        ss[42].s = int_or_error_sender::signal::error;
+        auto s = ex::when_all_range(std::move(ss));
+        auto r = error_callback_receiver<decltype(check_exception_ptr)>{
+            check_exception_ptr, set_error_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_error_called);
+    }
+
+    {
+        std::atomic<bool> set_error_called{false};
+        std::vector<int_or_error_sender> ss(100);
+        ss[0].s = int_or_error_sender::signal::error;
+        ss[99].s = int_or_error_sender::signal::done;
+        auto s = ex::when_all_range(std::move(ss));
+        auto r = error_callback_receiver<decltype(check_exception_ptr)>{
+            check_exception_ptr, set_error_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_error_called);
+    }
+
+    // Done path
+    {
+        std::atomic<bool> set_done_called{false};
+        std::vector<int_or_error_sender> ss(100);
+        ss[99].s = int_or_error_sender::signal::done;
+        auto s = ex::when_all_range(std::move(ss));
+        auto r = done_receiver{set_done_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_done_called);
+    }
+
+    // tag_invoke overload
+    {
+        std::atomic<bool> set_value_called{false};
+        std::atomic<bool> tag_invoke_overload_called{false};
+        std::vector<custom_sender_tag_invoke> ss(
+            3, custom_sender_tag_invoke{tag_invoke_overload_called});
+        auto s = ex::when_all_range(std::move(ss));
+        auto f = [] {};
+        auto r = callback_receiver<decltype(f)>{f, set_value_called};
+        auto os = ex::connect(std::move(s), std::move(r));
+        ex::start(os);
+        PIKA_TEST(set_value_called);
+        PIKA_TEST(tag_invoke_overload_called);
+    }
+
+    return pika::util::report_errors();
+}
@@ -137,6 +137,19 @@ void test_persistent_auto_chunk_size()
     }
 }
 
+void test_persistent_affinity_chunk_size()
+{
+    {
+        pika::execution::persistent_affinity_chunk_size pacs;
+        parameters_test(pacs);
+    }
+
+    {
+        pika::execution::persistent_affinity_chunk_size pacs(4);
+        parameters_test(pacs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 struct timer_hooks_parameters
 {
@@ -194,6 +207,7 @@ int pika_main(pika::program_options::variables_map& vm)
     test_guided_chunk_size();
     test_auto_chunk_size();
     test_persistent_auto_chunk_size();
+    test_persistent_affinity_chunk_size();
 
     test_combined_hooks();
 
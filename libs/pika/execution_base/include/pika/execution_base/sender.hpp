@@ -62,6 +62,24 @@ namespace pika { namespace execution { namespace experimental {
     /// The customization is implemented in terms of
     /// `pika::functional::tag_invoke`.
 
+    /// The name schedule_after denotes a customization point object. For some
+    /// subexpressions s and d, the expression schedule_after(s, d) returns a
+    /// sender which completes on the execution context of the scheduler s
+    /// once the duration d has elapsed. The expression is ill-formed unless
+    /// the scheduler customizes it.
+    ///
+    /// The customization is implemented in terms of
+    /// `pika::functional::tag_invoke`.
+
+    /// The name schedule_at denotes a customization point object. For some
+    /// subexpressions s and t, the expression schedule_at(s, t) returns a
+    /// sender which completes on the execution context of the scheduler s
+    /// once the point in time t has been reached. The expression is
+    /// ill-formed unless the scheduler customizes it.
+    ///
+    /// The customization is implemented in terms of
+    /// `pika::functional::tag_invoke`.
+
 #endif
 
     /// A sender is a type that is describing an asynchronous operation. The
@@ -240,6 +258,16 @@ namespace pika { namespace execution { namespace experimental {
     {
     } schedule{};
 
+    PIKA_HOST_DEVICE_INLINE_CONSTEXPR_VARIABLE
+    struct schedule_after_t : pika::functional::tag<schedule_after_t>
+    {
+    } schedule_after{};
+
+    PIKA_HOST_DEVICE_INLINE_CONSTEXPR_VARIABLE
+    struct schedule_at_t : pika::functional::tag<schedule_at_t>
+    {
+    } schedule_at{};
+
     namespace detail {
         template <bool IsSenderReceiver, typename Sender, typename Receiver>
         struct is_sender_to_impl;
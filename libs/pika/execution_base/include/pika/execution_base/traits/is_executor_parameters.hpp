@@ -63,6 +63,32 @@ namespace pika { namespace parallel { namespace execution {
         using type = typename Parameters::has_variable_chunk_size;
     };
 
+    ///////////////////////////////////////////////////////////////////////
+    // If a parameters type exposes 'has_chunk_affinity' aliased to
+    // std::true_type the partitioners schedule the chunk i of every
+    // algorithm invocation on the worker thread i modulo the number of
+    // cores used.
+    template <typename Parameters, typename Enable = void>
+    struct extract_has_chunk_affinity
+    {
+        // by default, the executor decides where the chunks run
+        using type = std::false_type;
+    };
+
+    template <typename Parameters>
+    struct extract_has_chunk_affinity<Parameters,
+        typename pika::util::always_void<
+            typename Parameters::has_chunk_affinity>::type>
+    {
+        using type = typename Parameters::has_chunk_affinity;
+    };
+
+    template <typename Parameters>
+    struct extract_has_chunk_affinity<::std::reference_wrapper<Parameters>>
+      : extract_has_chunk_affinity<Parameters>
+    {
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     namespace detail {
         /// \cond NOINTERNAL
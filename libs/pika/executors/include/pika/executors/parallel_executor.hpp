@@ -162,7 +162,7 @@ namespace pika { namespace execution {
             pika::threads::thread_schedule_hint hint)
         {
             auto exec_with_hint = exec;
-            exec_with_hint.policy_ = hint;
+            exec_with_hint.policy_.set_hint(hint);
             return exec_with_hint;
         }
 
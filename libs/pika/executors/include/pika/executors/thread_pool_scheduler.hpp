@@ -13,9 +13,14 @@
 #include <pika/execution/executors/execution_parameters.hpp>
 #include <pika/execution_base/receiver.hpp>
 #include <pika/execution_base/sender.hpp>
+#include <pika/modules/timing.hpp>
 #include <pika/threading_base/annotated_function.hpp>
+#include <pika/threading_base/detail/timer_wheel.hpp>
 #include <pika/threading_base/register_thread.hpp>
+#include <pika/threading_base/scheduler_base.hpp>
+#include <pika/threading_base/thread_num_tss.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <string>
@@ -23,6 +28,23 @@
 #include <utility>
 
 namespace pika { namespace execution { namespace experimental {
+    /// Selects how bulk operations on a thread_pool_scheduler distribute
+    /// their iterations among the worker threads.
+    enum class bulk_chunking
+    {
+        /// The iterations are split into 4 to 8 equally sized chunks per
+        /// worker thread, idle worker threads steal single chunks from their
+        /// neighbors.
+        fixed,
+        /// The iterations are split into finer chunks. Worker threads take
+        /// batches of chunks whose size adapts to the measured time per
+        /// chunk and decays as the remaining work shrinks. Idle worker
+        /// threads steal half of the remaining chunks of the most loaded
+        /// worker thread, preferring worker threads in the same NUMA domain.
+        /// This works better for loop bodies with irregular costs.
+        adaptive
+    };
+
     struct thread_pool_scheduler
     {
         constexpr thread_pool_scheduler() = default;
@@ -36,7 +58,8 @@ namespace pika { namespace execution { namespace experimental {
         {
             return pool_ == rhs.pool_ && priority_ == rhs.priority_ &&
                 stacksize_ == rhs.stacksize_ &&
-                schedulehint_ == rhs.schedulehint_;
+                schedulehint_ == rhs.schedulehint_ &&
+                bulk_chunking_ == rhs.bulk_chunking_;
         }
 
         bool operator!=(thread_pool_scheduler const& rhs) const noexcept
@@ -50,6 +73,25 @@ namespace pika { namespace execution { namespace experimental {
             return pool_;
         }
 
+        // Timers are registered with the worker given by the scheduling hint,
+        // or with the calling worker thread if it belongs to the same pool.
+        std::size_t get_timer_thread() const
+        {
+            if (schedulehint_.mode ==
+                    pika::threads::thread_schedule_hint_mode::thread &&
+                schedulehint_.hint >= 0)
+            {
+                return std::size_t(schedulehint_.hint);
+            }
+
+            if (pika::get_thread_pool_num() == pool_->get_pool_index())
+            {
+                return pika::get_local_worker_thread_num();
+            }
+
+            return 0;
+        }
+
         // support with_priority property
         friend thread_pool_scheduler tag_invoke(
             pika::execution::experimental::with_priority_t,
@@ -132,6 +174,23 @@ namespace pika { namespace execution { namespace experimental {
             return scheduler.annotation_;
         }
 
+        // support with_bulk_chunking property
+        friend constexpr thread_pool_scheduler tag_invoke(
+            pika::execution::experimental::with_bulk_chunking_t,
+            thread_pool_scheduler const& scheduler, bulk_chunking chunking)
+        {
+            auto sched_with_bulk_chunking = scheduler;
+            sched_with_bulk_chunking.bulk_chunking_ = chunking;
+            return sched_with_bulk_chunking;
+        }
+
+        friend constexpr bulk_chunking tag_invoke(
+            pika::execution::experimental::get_bulk_chunking_t,
+            thread_pool_scheduler const& scheduler) noexcept
+        {
+            return scheduler.bulk_chunking_;
+        }
+
         template <typename F>
         void execute(F&& f) const
         {
@@ -231,6 +290,120 @@ namespace pika { namespace execution { namespace experimental {
         {
             return {sched};
         }
+
+        // The timed operation state registers itself with the timer wheel of
+        // the scheduler of the underlying thread pool. No pika thread is
+        // created before the deadline has expired.
+        template <typename Scheduler, typename Receiver>
+        struct timed_operation_state : pika::threads::detail::timer_entry
+        {
+            PIKA_NO_UNIQUE_ADDRESS std::decay_t<Scheduler> scheduler;
+            PIKA_NO_UNIQUE_ADDRESS std::decay_t<Receiver> receiver;
+
+            template <typename Scheduler_, typename Receiver_>
+            timed_operation_state(Scheduler_&& scheduler, Receiver_&& receiver,
+                std::chrono::steady_clock::time_point deadline)
+              : pika::threads::detail::timer_entry(deadline, &on_expired)
+              , scheduler(PIKA_FORWARD(Scheduler_, scheduler))
+              , receiver(PIKA_FORWARD(Receiver_, receiver))
+            {
+            }
+
+            timed_operation_state(timed_operation_state&&) = delete;
+            timed_operation_state(timed_operation_state const&) = delete;
+            timed_operation_state& operator=(timed_operation_state&&) = delete;
+            timed_operation_state& operator=(
+                timed_operation_state const&) = delete;
+
+            // invoked by the worker thread polling the timer wheel
+            static void on_expired(
+                pika::threads::detail::timer_entry& entry) noexcept
+            {
+                auto& os = static_cast<timed_operation_state&>(entry);
+                pika::detail::try_catch_exception_ptr(
+                    [&]() {
+                        os.scheduler.execute([&os]() mutable {
+                            pika::execution::experimental::set_value(
+                                PIKA_MOVE(os.receiver));
+                        });
+                    },
+                    [&](std::exception_ptr ep) {
+                        pika::execution::experimental::set_error(
+                            PIKA_MOVE(os.receiver), PIKA_MOVE(ep));
+                    });
+            }
+
+            friend void tag_invoke(start_t, timed_operation_state& os) noexcept
+            {
+                pika::detail::try_catch_exception_ptr(
+                    [&]() {
+                        auto* sched =
+                            os.scheduler.get_thread_pool()->get_scheduler();
+                        PIKA_ASSERT(sched != nullptr);
+                        sched->add_timer(os.scheduler.get_timer_thread(), os);
+                    },
+                    [&](std::exception_ptr ep) {
+                        pika::execution::experimental::set_error(
+                            PIKA_MOVE(os.receiver), PIKA_MOVE(ep));
+                    });
+            }
+        };
+
+        template <typename Scheduler>
+        struct timed_sender
+        {
+            PIKA_NO_UNIQUE_ADDRESS std::decay_t<Scheduler> scheduler;
+            std::chrono::steady_clock::time_point deadline;
+
+            template <template <typename...> class Tuple,
+                template <typename...> class Variant>
+            using value_types = Variant<Tuple<>>;
+
+            template <template <typename...> class Variant>
+            using error_types = Variant<std::exception_ptr>;
+
+            static constexpr bool sends_done = false;
+
+            template <typename Receiver>
+            friend timed_operation_state<Scheduler, Receiver> tag_invoke(
+                connect_t, timed_sender&& s, Receiver&& receiver)
+            {
+                return {PIKA_MOVE(s.scheduler),
+                    PIKA_FORWARD(Receiver, receiver), s.deadline};
+            }
+
+            template <typename Receiver>
+            friend timed_operation_state<Scheduler, Receiver> tag_invoke(
+                connect_t, timed_sender& s, Receiver&& receiver)
+            {
+                return {
+                    s.scheduler, PIKA_FORWARD(Receiver, receiver), s.deadline};
+            }
+
+            template <typename CPO,
+                PIKA_CONCEPT_REQUIRES_(std::is_same_v<CPO,
+                    pika::execution::experimental::set_value_t>)>
+            friend constexpr auto tag_invoke(
+                pika::execution::experimental::get_completion_scheduler_t<CPO>,
+                timed_sender const& s)
+            {
+                return s.scheduler;
+            }
+        };
+
+        friend timed_sender<thread_pool_scheduler> tag_invoke(schedule_at_t,
+            thread_pool_scheduler const& sched,
+            pika::chrono::steady_time_point const& abs_time)
+        {
+            return {sched, abs_time.value()};
+        }
+
+        friend timed_sender<thread_pool_scheduler> tag_invoke(schedule_after_t,
+            thread_pool_scheduler const& sched,
+            pika::chrono::steady_duration const& rel_time)
+        {
+            return {sched, rel_time.from_now()};
+        }
         /// \endcond
 
     private:
@@ -243,6 +416,7 @@ namespace pika { namespace execution { namespace experimental {
             pika::threads::thread_stacksize::small_;
         pika::threads::thread_schedule_hint schedulehint_{};
         char const* annotation_ = nullptr;
+        bulk_chunking bulk_chunking_ = bulk_chunking::fixed;
         /// \endcond
     };
 }}}    // namespace pika::execution::experimental
@@ -25,7 +25,9 @@
 #include <pika/iterator_support/traits/is_range.hpp>
 #include <pika/threading_base/annotated_function.hpp>
 #include <pika/threading_base/register_thread.hpp>
+#include <pika/timing/high_resolution_clock.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -52,6 +54,15 @@ namespace pika { namespace execution { namespace experimental {
         /// thread (the completion scheduler is a thread_pool_scheduler;
         /// otherwise the customization defined in this file is not chosen) it
         /// will be reused as one of the worker threads.
+        ///
+        /// With bulk_chunking::adaptive the work is split into finer chunks.
+        /// Each worker thread takes batches of chunks from its own queue,
+        /// sized such that a batch takes roughly target_batch_duration, but
+        /// never more than half of what is left in the queue. Idle worker
+        /// threads steal half of the chunks of the most loaded queue,
+        /// preferring queues of worker threads in the same NUMA domain, and
+        /// put them into their own (empty) queue where they can be stolen
+        /// again (lazy binary splitting).
         template <typename Sender, typename Shape, typename F>
         class thread_pool_bulk_sender
         {
@@ -63,6 +74,14 @@ namespace pika { namespace execution { namespace experimental {
 
             using size_type = decltype(pika::util::size(shape));
 
+            // Maximum number of chunks per worker thread with adaptive
+            // chunking
+            static constexpr std::uint32_t max_adaptive_chunks = 64;
+
+            // Time (in nanoseconds) a batch of chunks should take with
+            // adaptive chunking
+            static constexpr std::uint64_t target_batch_duration = 50000;
+
         public:
             template <typename Sender_, typename Shape_, typename F_>
             thread_pool_bulk_sender(thread_pool_scheduler&& scheduler,
@@ -167,10 +186,18 @@ namespace pika { namespace execution { namespace experimental {
                         void do_work_chunk(
                             Ts& ts, std::uint32_t const index) const
                         {
-                            auto const i_begin = static_cast<size_type>(index) *
+                            do_work_chunks(ts, index, index + 1);
+                        }
+
+                        // Perform the work in the chunks [first, last).
+                        template <typename Ts>
+                        void do_work_chunks(Ts& ts, std::uint32_t const first,
+                            std::uint32_t const last) const
+                        {
+                            auto const i_begin = static_cast<size_type>(first) *
                                 task_f->chunk_size;
                             auto const i_end =
-                                (std::min)(static_cast<size_type>(index + 1) *
+                                (std::min)(static_cast<size_type>(last) *
                                         task_f->chunk_size,
                                     task_f->n);
                             auto it = pika::util::begin(op_state->shape);
@@ -193,6 +220,12 @@ namespace pika { namespace execution { namespace experimental {
                                 std::decay_t<Ts>, pika::monostate>>>
                         void operator()(Ts& ts) const
                         {
+                            if (op_state->chunking == bulk_chunking::adaptive)
+                            {
+                                do_work_adaptive(ts);
+                                return;
+                            }
+
                             auto& local_queue =
                                 op_state->queues[task_f->worker_thread].data_;
 
@@ -221,6 +254,123 @@ namespace pika { namespace execution { namespace experimental {
                                 }
                             }
                         }
+
+                        // Compute the size of the next batch of chunks from
+                        // the time it took to process the previous batch.
+                        // The batch size grows at most by a factor of two
+                        // at a time.
+                        static std::uint32_t next_batch_size(
+                            std::uint32_t const done,
+                            std::uint64_t const elapsed) noexcept
+                        {
+                            std::uint64_t const per_chunk =
+                                (std::max)(elapsed / done, std::uint64_t(1));
+                            std::uint64_t const batch_size =
+                                (std::max)(target_batch_duration / per_chunk,
+                                    std::uint64_t(1));
+                            return static_cast<std::uint32_t>((std::min)(
+                                batch_size, std::uint64_t(2) * done));
+                        }
+
+                        // Steal half of the chunks of the most loaded queue
+                        // and put them into the (empty) local queue. Queues
+                        // of worker threads in the same NUMA domain are
+                        // considered first. Returns false if there was
+                        // nothing left to steal.
+                        template <typename Queue>
+                        bool steal(Queue& local_queue) const
+                        {
+                            std::size_t const num_worker_threads =
+                                op_state->num_worker_threads;
+                            std::size_t const local_domain =
+                                op_state->numa_domains[task_f->worker_thread];
+
+                            for (bool const same_domain : {true, false})
+                            {
+                                while (true)
+                                {
+                                    std::size_t victim = num_worker_threads;
+                                    std::uint32_t victim_size = 0;
+                                    for (std::uint32_t offset = 1;
+                                         offset < num_worker_threads; ++offset)
+                                    {
+                                        std::size_t const neighbor =
+                                            (task_f->worker_thread + offset) %
+                                            num_worker_threads;
+                                        if ((op_state->numa_domains[neighbor] ==
+                                                local_domain) != same_domain)
+                                        {
+                                            continue;
+                                        }
+
+                                        std::uint32_t const size =
+                                            op_state->queues[neighbor]
+                                                .data_.size();
+                                        if (size > victim_size)
+                                        {
+                                            victim = neighbor;
+                                            victim_size = size;
+                                        }
+                                    }
+
+                                    if (victim == num_worker_threads)
+                                    {
+                                        break;
+                                    }
+
+                                    auto range = op_state->queues[victim]
+                                                     .data_.pop_right_range(
+                                                         (victim_size + 1) / 2);
+                                    if (range)
+                                    {
+                                        [[maybe_unused]] bool const refilled =
+                                            local_queue.refill(
+                                                range->first, range->second);
+                                        PIKA_ASSERT(refilled);
+                                        return true;
+                                    }
+
+                                    // The victim was drained in the meantime,
+                                    // look for another one.
+                                }
+                            }
+                            return false;
+                        }
+
+                        // Process the local queue in batches whose size
+                        // adapts to the time spent per chunk, then steal
+                        // from other queues until no work is left.
+                        template <typename Ts>
+                        void do_work_adaptive(Ts& ts) const
+                        {
+                            auto& local_queue =
+                                op_state->queues[task_f->worker_thread].data_;
+
+                            std::uint32_t batch_size = 1;
+                            do
+                            {
+                                pika::util::optional<
+                                    std::pair<std::uint32_t, std::uint32_t>>
+                                    range;
+                                while ((range = local_queue.pop_left_range(
+                                            (std::min)(batch_size,
+                                                (std::max)(
+                                                    local_queue.size() / 2,
+                                                    std::uint32_t(1))))))
+                                {
+                                    std::uint64_t const start =
+                                        pika::chrono::high_resolution_clock::
+                                            now();
+                                    do_work_chunks(
+                                        ts, range->first, range->second);
+                                    batch_size = next_batch_size(
+                                        range->second - range->first,
+                                        pika::chrono::high_resolution_clock::
+                                                now() -
+                                            start);
+                                }
+                            } while (steal(local_queue));
+                        }
                     };
 
                     struct set_value_end_loop_visitor
@@ -324,13 +474,14 @@ namespace pika { namespace execution { namespace experimental {
 
                     // Compute a chunk size given a number of worker threads and
                     // a total number of items n. Returns a power-of-2 chunk
-                    // size that produces at most 8 and at least 4 chunks per
-                    // worker thread.
+                    // size that produces at most max_chunks and at least
+                    // max_chunks / 2 chunks per worker thread.
                     static constexpr std::uint32_t get_chunk_size(
-                        std::uint32_t const num_threads, size_type const n)
+                        std::uint32_t const num_threads, size_type const n,
+                        std::uint32_t const max_chunks = 8)
                     {
                         std::uint32_t chunk_size = 1;
-                        while (chunk_size * num_threads * 8 < n)
+                        while (chunk_size * num_threads * max_chunks < n)
                         {
                             chunk_size *= 2;
                         }
@@ -434,11 +585,31 @@ namespace pika { namespace execution { namespace experimental {
                         }
 
                         // Calculate chunk size and number of chunks
+                        bool const adaptive =
+                            r.op_state->chunking == bulk_chunking::adaptive;
                         auto const chunk_size =
-                            get_chunk_size(r.op_state->num_worker_threads, n);
+                            get_chunk_size(r.op_state->num_worker_threads, n,
+                                adaptive ? max_adaptive_chunks : 8);
                         auto const num_chunks =
                             (n + chunk_size - 1) / chunk_size;
 
+                        // Look up the NUMA domains of the worker threads for
+                        // the victim selection
+                        if (adaptive && r.op_state->numa_domains.empty())
+                        {
+                            auto* pool =
+                                r.op_state->scheduler.get_thread_pool();
+                            r.op_state->numa_domains.reserve(
+                                r.op_state->num_worker_threads);
+                            for (std::size_t worker_thread = 0;
+                                 worker_thread < r.op_state->num_worker_threads;
+                                 ++worker_thread)
+                            {
+                                r.op_state->numa_domains.push_back(
+                                    pool->get_numa_domain(worker_thread));
+                            }
+                        }
+
                         // Store sent values in the operation state
                         r.op_state->ts.template emplace<pika::tuple<Ts...>>(
                             PIKA_FORWARD(Ts, ts)...);
@@ -480,12 +651,16 @@ namespace pika { namespace execution { namespace experimental {
                         bulk_receiver>;
 
                 thread_pool_scheduler scheduler;
+                bulk_chunking chunking =
+                    pika::execution::experimental::get_bulk_chunking(
+                        scheduler);
                 operation_state_type op_state;
                 std::size_t num_worker_threads =
                     scheduler.get_thread_pool()->get_os_thread_count();
                 std::vector<pika::util::cache_aligned_data<
                     pika::concurrency::detail::contiguous_index_queue<>>>
                     queues{num_worker_threads};
+                std::vector<std::size_t> numa_domains;
                 PIKA_NO_UNIQUE_ADDRESS std::decay_t<Shape> shape;
                 PIKA_NO_UNIQUE_ADDRESS std::decay_t<F> f;
                 PIKA_NO_UNIQUE_ADDRESS std::decay_t<Receiver> receiver;
@@ -7,6 +7,7 @@
 #include <pika/condition_variable.hpp>
 #include <pika/execution.hpp>
 #include <pika/functional.hpp>
+#include <pika/future.hpp>
 #include <pika/init.hpp>
 #include <pika/modules/testing.hpp>
 #include <pika/mutex.hpp>
@@ -1694,6 +1695,64 @@ void test_bulk()
     }
 }
 
+void test_bulk_adaptive()
+{
+    ex::thread_pool_scheduler sched =
+        ex::with_bulk_chunking(ex::thread_pool_scheduler{},
+            ex::bulk_chunking::adaptive);
+    PIKA_TEST(ex::get_bulk_chunking(sched) == ex::bulk_chunking::adaptive);
+    PIKA_TEST(ex::get_bulk_chunking(ex::thread_pool_scheduler{}) ==
+        ex::bulk_chunking::fixed);
+
+    std::vector<int> const ns = {0, 1, 10, 43, 10007};
+
+    for (int n : ns)
+    {
+        std::vector<std::atomic<int>> v(n);
+        for (auto& i : v)
+        {
+            i = 0;
+        }
+
+        // make the cost of the loop body depend on the index
+        ex::schedule(sched) | ex::bulk(n, [&](int i) {
+            if (i % 97 == 0)
+            {
+                pika::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            ++v[i];
+        }) | ex::sync_wait();
+
+        for (int i = 0; i < n; ++i)
+        {
+            PIKA_TEST_EQ(v[i].load(), 1);
+        }
+    }
+
+    for (auto n : ns)
+    {
+        int const i_fail = 3;
+        bool const expect_exception = n > i_fail;
+
+        try
+        {
+            ex::transfer_just(sched) | ex::bulk(n, [](int i) {
+                if (i == i_fail)
+                {
+                    throw std::runtime_error("error");
+                }
+            }) | ex::sync_wait();
+
+            PIKA_TEST(!expect_exception);
+        }
+        catch (std::runtime_error const& e)
+        {
+            PIKA_TEST(expect_exception);
+            PIKA_TEST_EQ(std::string(e.what()), std::string("error"));
+        }
+    }
+}
+
 void test_completion_scheduler()
 {
     {
@@ -1766,6 +1825,99 @@ void test_completion_scheduler()
     }
 }
 
+void test_schedule_after_at()
+{
+    ex::thread_pool_scheduler sched{};
+
+    {
+        pika::thread::id parent_id = pika::this_thread::get_id();
+
+        auto const start = std::chrono::steady_clock::now();
+        ex::schedule_after(sched, std::chrono::milliseconds(10)) |
+            ex::then([parent_id]() {
+                PIKA_TEST_NEQ(parent_id, pika::this_thread::get_id());
+            }) |
+            ex::sync_wait();
+        PIKA_TEST(std::chrono::steady_clock::now() - start >=
+            std::chrono::milliseconds(10));
+    }
+
+    {
+        auto const deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+        ex::schedule_at(sched, deadline) | ex::sync_wait();
+        PIKA_TEST(std::chrono::steady_clock::now() >= deadline);
+    }
+
+    {
+        // deadlines in the past complete immediately
+        ex::schedule_at(sched,
+            std::chrono::steady_clock::now() - std::chrono::seconds(1)) |
+            ex::sync_wait();
+        ex::schedule_after(sched, std::chrono::milliseconds(0)) |
+            ex::sync_wait();
+    }
+
+    {
+        // timeouts composed with when_all complete after the longest delay
+        auto const start = std::chrono::steady_clock::now();
+        auto result =
+            ex::when_all(ex::schedule_after(sched, std::chrono::milliseconds(5)) |
+                    ex::then([] { return 1; }),
+                ex::schedule_after(sched, std::chrono::milliseconds(20)) |
+                    ex::then([] { return 2; })) |
+            ex::then([](int x, int y) { return x + y; }) | ex::sync_wait();
+        PIKA_TEST_EQ(result, 3);
+        PIKA_TEST(std::chrono::steady_clock::now() - start >=
+            std::chrono::milliseconds(20));
+    }
+
+    {
+        // retry with backoff after an error
+        std::atomic<int> attempts{0};
+        auto attempt = [&]() {
+            if (++attempts < 2)
+            {
+                throw std::runtime_error("error");
+            }
+            return 42;
+        };
+
+        auto result = ex::schedule(sched) | ex::then(attempt) |
+            ex::let_error([&](std::exception_ptr&) {
+                return ex::schedule_after(sched, std::chrono::milliseconds(1)) |
+                    ex::then(attempt);
+            }) |
+            ex::sync_wait();
+        PIKA_TEST_EQ(result, 42);
+        PIKA_TEST_EQ(attempts.load(), 2);
+    }
+
+    {
+        // many concurrent timers
+        std::atomic<std::size_t> count{0};
+        std::vector<pika::future<void>> futures;
+        for (std::size_t i = 0; i != 100; ++i)
+        {
+            futures.push_back(ex::make_future(
+                ex::schedule_after(sched, std::chrono::microseconds(100 * i)) |
+                ex::then([&count]() { ++count; })));
+        }
+        pika::wait_all(futures);
+        PIKA_TEST_EQ(count.load(), std::size_t(100));
+    }
+
+    {
+        auto sender = ex::schedule_after(sched, std::chrono::milliseconds(1));
+        auto completion_scheduler =
+            ex::get_completion_scheduler<ex::set_value_t>(sender);
+        static_assert(
+            std::is_same_v<std::decay_t<decltype(completion_scheduler)>,
+                ex::thread_pool_scheduler>,
+            "the completion scheduler should be a thread_pool_scheduler");
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int pika_main()
 {
@@ -1795,7 +1947,9 @@ int pika_main()
     test_let_error();
     test_detach();
     test_bulk();
+    test_bulk_adaptive();
     test_completion_scheduler();
+    test_schedule_after_at();
 
     return pika::finalize();
 }
@@ -10,7 +10,6 @@
 #include <pika/assert.hpp>
 #include <pika/async_base/launch_policy.hpp>
 #include <pika/coroutines/detail/get_stack_pointer.hpp>
-#include <pika/datastructures/detail/small_vector.hpp>
 #include <pika/errors/try_catch_exception_ptr.hpp>
 #include <pika/functional/function.hpp>
 #include <pika/futures/future_fwd.hpp>
@@ -79,14 +78,29 @@ namespace pika { namespace lcos { namespace detail {
 
     public:
         using completed_callback_type = util::unique_function_nonser<void()>;
-        using completed_callback_vector_type =
-            pika::detail::small_vector<completed_callback_type, 1>;
+
+        /// A node of the intrusive list of callbacks which are invoked once a
+        /// shared state becomes ready. The node is owned by whoever linked it
+        /// into the list. Exactly one of on_completed or on_discarded is
+        /// called for each linked node, the latter only if the shared state
+        /// is reset or destroyed before it became ready.
+        struct completed_callback_node
+        {
+            virtual void on_completed() = 0;
+            virtual void on_discarded() noexcept = 0;
+
+            completed_callback_node* next_ = nullptr;
+
+        protected:
+            ~completed_callback_node() = default;
+        };
 
         using has_future_data_refcnt_base = void;
 
         virtual ~future_data_refcnt_base();
 
         virtual void set_on_completed(completed_callback_type) = 0;
+        virtual void set_on_completed(completed_callback_node* node) = 0;
 
         virtual bool requires_delete() noexcept
         {
@@ -215,17 +229,25 @@ namespace pika { namespace lcos { namespace detail {
 
         future_data_base() noexcept
           : state_(empty)
+          , has_waiters_(false)
+          , on_completed_(nullptr)
+          , on_completed_inline_(false)
+          , on_completed_inline_used_(false)
         {
         }
 
         explicit future_data_base(init_no_addref no_addref) noexcept
           : future_data_refcnt_base(no_addref)
           , state_(empty)
+          , has_waiters_(false)
+          , on_completed_(nullptr)
+          , on_completed_inline_(false)
+          , on_completed_inline_used_(false)
         {
         }
 
+        using future_data_refcnt_base::completed_callback_node;
         using future_data_refcnt_base::completed_callback_type;
-        using future_data_refcnt_base::completed_callback_vector_type;
         using result_type = util::unused_type;
         using init_no_addref = future_data_refcnt_base::init_no_addref;
 
@@ -283,7 +305,7 @@ namespace pika { namespace lcos { namespace detail {
         static void run_on_completed(
             completed_callback_type&& on_completed) noexcept;
         static void run_on_completed(
-            completed_callback_vector_type&& on_completed) noexcept;
+            completed_callback_node* on_completed) noexcept;
 
         // make sure continuation invocation does not recurse deeper than
         // allowed
@@ -295,6 +317,11 @@ namespace pika { namespace lcos { namespace detail {
         /// immediately.
         void set_on_completed(completed_callback_type data_sink) override;
 
+        /// Link the given callback node into the list of callbacks to invoke
+        /// when the future becomes ready. If the future is ready the node will
+        /// be invoked immediately. This does not allocate any memory.
+        void set_on_completed(completed_callback_node* node) override;
+
         virtual state wait(error_code& ec = throws);
 
         virtual pika::future_status wait_until(
@@ -323,9 +350,58 @@ namespace pika { namespace lcos { namespace detail {
         }
 
     protected:
+        // Wake up the threads waiting for the future and invoke all
+        // registered callbacks, called once after the state has been made
+        // ready.
+        void handle_ready();
+
+        // Release all registered callbacks without invoking them.
+        void discard_on_completed() noexcept;
+
+        // Callback node holding an arbitrary function. The node for the first
+        // such callback is stored in place, all others are allocated.
+        struct completed_callback_function final : completed_callback_node
+        {
+            explicit completed_callback_function(bool allocated) noexcept
+              : allocated_(allocated)
+            {
+            }
+
+            void on_completed() override
+            {
+                completed_callback_type f = PIKA_MOVE(f_);
+                f_.reset();
+                if (allocated_)
+                {
+                    delete this;
+                }
+
+                pika::scoped_annotation annotate(f);
+                f();
+            }
+
+            void on_discarded() noexcept override
+            {
+                if (allocated_)
+                {
+                    delete this;
+                }
+                else
+                {
+                    f_.reset();
+                }
+            }
+
+            completed_callback_type f_;
+            bool allocated_;
+        };
+
         mutable mutex_type mtx_;
         std::atomic<state> state_;    // current state
-        completed_callback_vector_type on_completed_;
+        std::atomic<bool> has_waiters_;
+        std::atomic<completed_callback_node*> on_completed_;
+        completed_callback_function on_completed_inline_;
+        std::atomic<bool> on_completed_inline_used_;
         local::detail::condition_variable cond_;    // threads waiting in read
     };
 
@@ -356,8 +432,8 @@ namespace pika { namespace lcos { namespace detail {
         using init_no_addref = typename base_type::init_no_addref;
         using completed_callback_type =
             typename base_type::completed_callback_type;
-        using completed_callback_vector_type =
-            typename base_type::completed_callback_vector_type;
+        using completed_callback_node =
+            typename base_type::completed_callback_node;
 
     protected:
         using mutex_type = typename base_type::mutex_type;
@@ -445,50 +521,23 @@ namespace pika { namespace lcos { namespace detail {
             result_type* value_ptr = reinterpret_cast<result_type*>(&storage_);
             construct(value_ptr, PIKA_FORWARD(Ts, ts)...);
 
-            // At this point the lock needs to be acquired to safely access the
-            // registered continuations
-            std::unique_lock<mutex_type> l(mtx_);
-
-            // handle all threads waiting for the future to become ready
-            auto on_completed = PIKA_MOVE(on_completed_);
-            on_completed_.clear();
-
             // The value has been set, changing the state to 'value' at this
             // point signals to all other threads that this future is ready.
+            // No lock is needed here, see handle_ready.
             state expected = empty;
-            if (!state_.compare_exchange_strong(
-                    expected, value, std::memory_order_release))
+            if (!state_.compare_exchange_strong(expected, value))
             {
                 // this future should be 'empty' still (it can't be made ready
                 // more than once).
-                l.unlock();
                 PIKA_THROW_EXCEPTION(promise_already_satisfied,
                     "future_data_base::set_value",
                     "data has already been set for this future");
                 return;
             }
 
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (
-                cond_.notify_one(PIKA_MOVE(l), threads::thread_priority::boost))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
-            }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (!on_completed.empty())
-            {
-                handle_on_completed(PIKA_MOVE(on_completed));
-            }
+            // wake up waiting threads and invoke the callback (continuation)
+            // functions
+            handle_ready();
         }
 
         void set_exception(std::exception_ptr data) override
@@ -504,50 +553,23 @@ namespace pika { namespace lcos { namespace detail {
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*) exception_ptr) std::exception_ptr(PIKA_MOVE(data));
 
-            // At this point the lock needs to be acquired to safely access the
-            // registered continuations
-            std::unique_lock<mutex_type> l(mtx_);
-
-            // handle all threads waiting for the future to become ready
-            auto on_completed = PIKA_MOVE(on_completed_);
-            on_completed_.clear();
-
             // The value has been set, changing the state to 'exception' at this
             // point signals to all other threads that this future is ready.
+            // No lock is needed here, see handle_ready.
             state expected = empty;
-            if (!state_.compare_exchange_strong(
-                    expected, exception, std::memory_order_release))
+            if (!state_.compare_exchange_strong(expected, exception))
             {
                 // this future should be 'empty' still (it can't be made ready
                 // more than once).
-                l.unlock();
                 PIKA_THROW_EXCEPTION(promise_already_satisfied,
                     "future_data_base::set_exception",
                     "data has already been set for this future");
                 return;
             }
 
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (
-                cond_.notify_one(PIKA_MOVE(l), threads::thread_priority::boost))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
-            }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (!on_completed.empty())
-            {
-                handle_on_completed(PIKA_MOVE(on_completed));
-            }
+            // wake up waiting threads and invoke the callback (continuation)
+            // functions
+            handle_ready();
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -615,7 +637,7 @@ namespace pika { namespace lcos { namespace detail {
                 break;
             }
 
-            on_completed_.clear();
+            discard_on_completed();
         }
 
         std::exception_ptr get_exception_ptr() const override
@@ -626,7 +648,6 @@ namespace pika { namespace lcos { namespace detail {
 
     protected:
         using base_type::mtx_;
-        using base_type::on_completed_;
         using base_type::state_;
 
     private:
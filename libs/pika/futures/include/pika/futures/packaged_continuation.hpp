@@ -122,7 +122,9 @@ namespace pika { namespace lcos { namespace detail {
 
     ///////////////////////////////////////////////////////////////////////////
     template <typename Future, typename F, typename ContResult>
-    class continuation : public detail::future_data<ContResult>
+    class continuation
+      : public detail::future_data<ContResult>
+      , private future_data_refcnt_base::completed_callback_node
     {
     private:
         using base_type = future_data<ContResult>;
@@ -130,6 +132,19 @@ namespace pika { namespace lcos { namespace detail {
         using mutex_type = typename base_type::mutex_type;
         using result_type = typename base_type::result_type;
 
+        using completed_callback_node =
+            future_data_refcnt_base::completed_callback_node;
+        using attached_state_ptr =
+            traits::detail::shared_state_ptr_for_t<Future>;
+
+        // Continuations spawned through a stateless spawner link themselves
+        // into the list of callbacks of the future they are attached to,
+        // which avoids allocating a separate callback for each continuation.
+        template <typename Spawner>
+        static constexpr bool is_intrusive_spawner_v =
+            std::is_empty_v<std::decay_t<Spawner>> &&
+            std::is_default_constructible_v<std::decay_t<Spawner>>;
+
     protected:
         using base_type::mtx_;
 
@@ -393,19 +408,27 @@ namespace pika { namespace lcos { namespace detail {
             }
 
             ptr->execute_deferred();
-            ptr->set_on_completed(
-                [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
-                    policy = PIKA_FORWARD(Policy, policy),
-                    &spawner]() mutable -> void {
-                    if (pika::detail::has_async_policy(policy))
-                    {
-                        this_->async(PIKA_MOVE(state), spawner);
-                    }
-                    else
-                    {
-                        this_->run(PIKA_MOVE(state));
-                    }
-                });
+            if constexpr (is_intrusive_spawner_v<Spawner>)
+            {
+                link_attached<Spawner, true>(PIKA_MOVE(this_), PIKA_MOVE(state),
+                    pika::detail::has_async_policy(policy));
+            }
+            else
+            {
+                ptr->set_on_completed(
+                    [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
+                        policy = PIKA_FORWARD(Policy, policy),
+                        &spawner]() mutable -> void {
+                        if (pika::detail::has_async_policy(policy))
+                        {
+                            this_->async(PIKA_MOVE(state), spawner);
+                        }
+                        else
+                        {
+                            this_->run(PIKA_MOVE(state));
+                        }
+                    });
+            }
         }
 
         template <typename Spawner, typename Policy>
@@ -429,19 +452,27 @@ namespace pika { namespace lcos { namespace detail {
             }
 
             ptr->execute_deferred();
-            ptr->set_on_completed(
-                [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
-                    policy = PIKA_FORWARD(Policy, policy),
-                    spawner = PIKA_MOVE(spawner)]() mutable -> void {
-                    if (pika::detail::has_async_policy(policy))
-                    {
-                        this_->async(PIKA_MOVE(state), PIKA_MOVE(spawner));
-                    }
-                    else
-                    {
-                        this_->run(PIKA_MOVE(state));
-                    }
-                });
+            if constexpr (is_intrusive_spawner_v<Spawner>)
+            {
+                link_attached<Spawner, true>(PIKA_MOVE(this_), PIKA_MOVE(state),
+                    pika::detail::has_async_policy(policy));
+            }
+            else
+            {
+                ptr->set_on_completed(
+                    [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
+                        policy = PIKA_FORWARD(Policy, policy),
+                        spawner = PIKA_MOVE(spawner)]() mutable -> void {
+                        if (pika::detail::has_async_policy(policy))
+                        {
+                            this_->async(PIKA_MOVE(state), PIKA_MOVE(spawner));
+                        }
+                        else
+                        {
+                            this_->run(PIKA_MOVE(state));
+                        }
+                    });
+            }
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -466,19 +497,27 @@ namespace pika { namespace lcos { namespace detail {
             }
 
             ptr->execute_deferred();
-            ptr->set_on_completed(
-                [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
-                    policy = PIKA_FORWARD(Policy, policy),
-                    &spawner]() mutable -> void {
-                    if (pika::detail::has_async_policy(policy))
-                    {
-                        this_->async_nounwrap(PIKA_MOVE(state), spawner);
-                    }
-                    else
-                    {
-                        this_->run_nounwrap(PIKA_MOVE(state));
-                    }
-                });
+            if constexpr (is_intrusive_spawner_v<Spawner>)
+            {
+                link_attached<Spawner, false>(PIKA_MOVE(this_), PIKA_MOVE(state),
+                    pika::detail::has_async_policy(policy));
+            }
+            else
+            {
+                ptr->set_on_completed(
+                    [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
+                        policy = PIKA_FORWARD(Policy, policy),
+                        &spawner]() mutable -> void {
+                        if (pika::detail::has_async_policy(policy))
+                        {
+                            this_->async_nounwrap(PIKA_MOVE(state), spawner);
+                        }
+                        else
+                        {
+                            this_->run_nounwrap(PIKA_MOVE(state));
+                        }
+                    });
+            }
         }
 
         template <typename Spawner, typename Policy>
@@ -502,26 +541,98 @@ namespace pika { namespace lcos { namespace detail {
             }
 
             ptr->execute_deferred();
-            ptr->set_on_completed(
-                [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
-                    policy = PIKA_FORWARD(Policy, policy),
-                    spawner = PIKA_MOVE(spawner)]() mutable -> void {
-                    if (pika::detail::has_async_policy(policy))
-                    {
-                        this_->async_nounwrap(
-                            PIKA_MOVE(state), PIKA_MOVE(spawner));
-                    }
-                    else
-                    {
-                        this_->run_nounwrap(PIKA_MOVE(state));
-                    }
-                });
+            if constexpr (is_intrusive_spawner_v<Spawner>)
+            {
+                link_attached<Spawner, false>(PIKA_MOVE(this_), PIKA_MOVE(state),
+                    pika::detail::has_async_policy(policy));
+            }
+            else
+            {
+                ptr->set_on_completed(
+                    [this_ = PIKA_MOVE(this_), state = PIKA_MOVE(state),
+                        policy = PIKA_FORWARD(Policy, policy),
+                        spawner = PIKA_MOVE(spawner)]() mutable -> void {
+                        if (pika::detail::has_async_policy(policy))
+                        {
+                            this_->async_nounwrap(
+                                PIKA_MOVE(state), PIKA_MOVE(spawner));
+                        }
+                        else
+                        {
+                            this_->run_nounwrap(PIKA_MOVE(state));
+                        }
+                    });
+            }
+        }
+
+    private:
+        template <typename Spawner, bool Unwrap>
+        static void run_attached(
+            continuation& cont, attached_state_ptr&& state, bool async)
+        {
+            if (async)
+            {
+                if constexpr (Unwrap)
+                {
+                    cont.async(PIKA_MOVE(state), std::decay_t<Spawner>{});
+                }
+                else
+                {
+                    cont.async_nounwrap(
+                        PIKA_MOVE(state), std::decay_t<Spawner>{});
+                }
+            }
+            else
+            {
+                if constexpr (Unwrap)
+                {
+                    cont.run(PIKA_MOVE(state));
+                }
+                else
+                {
+                    cont.run_nounwrap(PIKA_MOVE(state));
+                }
+            }
+        }
+
+        template <typename Spawner, bool Unwrap>
+        void link_attached(pika::intrusive_ptr<continuation>&& this_,
+            attached_state_ptr&& state, bool async)
+        {
+            auto* ptr = state.get();
+
+            attached_state_ = PIKA_MOVE(state);
+            attached_run_ = &run_attached<Spawner, Unwrap>;
+            attached_async_ = async;
+
+            // the reference to this continuation is released once the
+            // callback has been invoked (or discarded)
+            this_.detach();
+            ptr->set_on_completed(static_cast<completed_callback_node*>(this));
+        }
+
+        void on_completed() override
+        {
+            pika::intrusive_ptr<continuation> this_(this, false);
+            attached_run_(*this, PIKA_MOVE(attached_state_), attached_async_);
+        }
+
+        void on_discarded() noexcept override
+        {
+            pika::intrusive_ptr<continuation> this_(this, false);
+            attached_state_.reset();
         }
 
     protected:
         bool started_;
         threads::thread_id_type id_;
         std::decay_t<F> f_;
+
+    private:
+        attached_state_ptr attached_state_;
+        void (*attached_run_)(continuation&, attached_state_ptr&&, bool) =
+            nullptr;
+        bool attached_async_ = false;
     };
 
     template <typename Allocator, typename Future, typename F,
@@ -12,13 +12,13 @@
 #include <pika/async_base/launch_policy.hpp>
 #include <pika/errors/try_catch_exception_ptr.hpp>
 #include <pika/execution_base/this_thread.hpp>
-#include <pika/functional/deferred_call.hpp>
 #include <pika/functional/unique_function.hpp>
 #include <pika/futures/futures_factory.hpp>
 #include <pika/modules/errors.hpp>
 #include <pika/modules/memory.hpp>
 #include <pika/threading_base/annotated_function.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <exception>
 #include <functional>
@@ -87,8 +87,27 @@ namespace pika { namespace lcos { namespace detail {
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    future_data_base<traits::detail::future_data_void>::~future_data_base() =
-        default;
+    namespace {
+        // Marks the callback list of a shared state which has become ready,
+        // no further callbacks can be linked into such a list.
+        struct closed_callback_list final
+          : future_data_refcnt_base::completed_callback_node
+        {
+            void on_completed() override {}
+            void on_discarded() noexcept override {}
+        };
+
+        closed_callback_list closed_list;
+
+        future_data_refcnt_base::completed_callback_node* const
+            closed_on_completed = &closed_list;
+    }    // namespace
+
+    ///////////////////////////////////////////////////////////////////////////
+    future_data_base<traits::detail::future_data_void>::~future_data_base()
+    {
+        discard_on_completed();
+    }
 
     static util::unused_type unused_;
 
@@ -154,6 +173,20 @@ namespace pika { namespace lcos { namespace detail {
         return nullptr;
     }
 
+    // If a completion handler throws an exception, there's nothing we can
+    // do, report the exception and terminate.
+    static void report_on_completed_error(std::exception_ptr&& ep) noexcept
+    {
+        if (run_on_completed_error_handler)
+        {
+            run_on_completed_error_handler(PIKA_MOVE(ep));
+        }
+        else
+        {
+            std::terminate();
+        }
+    }
+
     // deferred execution of a given continuation
     void future_data_base<traits::detail::future_data_void>::run_on_completed(
         completed_callback_type&& on_completed) noexcept
@@ -164,25 +197,23 @@ namespace pika { namespace lcos { namespace detail {
                 on_completed();
             },
             [&](std::exception_ptr ep) {
-                // If the completion handler throws an exception, there's nothing
-                // we can do, report the exception and terminate.
-                if (run_on_completed_error_handler)
-                {
-                    run_on_completed_error_handler(PIKA_MOVE(ep));
-                }
-                else
-                {
-                    std::terminate();
-                }
+                report_on_completed_error(PIKA_MOVE(ep));
             });
     }
 
     void future_data_base<traits::detail::future_data_void>::run_on_completed(
-        completed_callback_vector_type&& on_completed) noexcept
+        completed_callback_node* on_completed) noexcept
     {
-        for (auto&& func : on_completed)
+        while (on_completed != nullptr)
         {
-            run_on_completed(PIKA_MOVE(func));
+            // the node may go away while being invoked
+            completed_callback_node* next = on_completed->next_;
+            pika::detail::try_catch_exception_ptr(
+                [&]() { on_completed->on_completed(); },
+                [&](std::exception_ptr ep) {
+                    report_on_completed_error(PIKA_MOVE(ep));
+                });
+            on_completed = next;
         }
     }
 
@@ -215,10 +246,11 @@ namespace pika { namespace lcos { namespace detail {
 
             pika::detail::try_catch_exception_ptr(
                 [&]() {
-                    constexpr void (*p)(Callback &&) =
-                        &future_data_base::run_on_completed;
-                    run_on_completed_on_new_thread(util::deferred_call(
-                        p, PIKA_FORWARD(Callback, on_completed)));
+                    run_on_completed_on_new_thread(
+                        [on_completed = PIKA_FORWARD(
+                             Callback, on_completed)]() mutable {
+                            run_on_completed(PIKA_MOVE(on_completed));
+                        });
                 },
                 [&](std::exception_ptr ep) {
                     // If an exception while creating the new task or inside the
@@ -236,14 +268,8 @@ namespace pika { namespace lcos { namespace detail {
         }
     }
 
-    // We need only one explicit instantiation here as the second version
-    // (single callback) is implicitly instantiated below.
-    using completed_callback_vector_type =
-        future_data_refcnt_base::completed_callback_vector_type;
-
-    template PIKA_EXPORT void
-    future_data_base<traits::detail::future_data_void>::handle_on_completed<
-        completed_callback_vector_type>(completed_callback_vector_type&&);
+    // Both versions (single callback and list of callback nodes) are
+    // implicitly instantiated below.
 
     /// Set the callback which needs to be invoked when the future becomes
     /// ready. If the future is ready the function will be invoked
@@ -258,22 +284,118 @@ namespace pika { namespace lcos { namespace detail {
         {
             // invoke the callback (continuation) function right away
             handle_on_completed(PIKA_MOVE(data_sink));
+            return;
+        }
+
+        // The first callback is stored in place, most futures have at most
+        // one callback attached.
+        completed_callback_function* node = nullptr;
+        if (!on_completed_inline_used_.exchange(
+                true, std::memory_order_relaxed))
+        {
+            node = &on_completed_inline_;
         }
         else
         {
-            std::unique_lock l(mtx_);
-            if (is_ready())
+            node = new completed_callback_function(true);
+        }
+        node->f_ = PIKA_MOVE(data_sink);
+
+        set_on_completed(static_cast<completed_callback_node*>(node));
+    }
+
+    void future_data_base<traits::detail::future_data_void>::set_on_completed(
+        completed_callback_node* node)
+    {
+        PIKA_ASSERT(node != nullptr);
+
+        if (!is_ready())
+        {
+            completed_callback_node* head =
+                on_completed_.load(std::memory_order_acquire);
+            while (head != closed_on_completed)
             {
-                l.unlock();
+                node->next_ = head;
+                if (on_completed_.compare_exchange_weak(head, node,
+                        std::memory_order_release, std::memory_order_acquire))
+                {
+                    return;
+                }
+            }
+        }
 
-                // invoke the callback (continuation) function
-                handle_on_completed(PIKA_MOVE(data_sink));
+        // the future has become ready, invoke the callback right away
+        node->next_ = nullptr;
+        handle_on_completed(node);
+    }
+
+    void future_data_base<traits::detail::future_data_void>::handle_ready()
+    {
+        // Waiting threads announce themselves before re-checking the state
+        // while holding the lock (see wait), the lock needs to be acquired
+        // only if there may be such threads. Both the state and the flag are
+        // accessed with sequentially consistent ordering, either the waiting
+        // thread sees the new state or this thread sees the flag.
+        if (has_waiters_.load())
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // Note: we use notify_one repeatedly instead of notify_all as we
+            //       know: a) that most of the time we have at most one thread
+            //       waiting on the future (most futures are not shared), and
+            //       b) our implementation of condition_variable::notify_one
+            //       relinquishes the lock before resuming the waiting thread
+            //       which avoids suspension of this thread when it tries to
+            //       re-lock the mutex while exiting from condition_variable::wait
+            while (
+                cond_.notify_one(PIKA_MOVE(l), threads::thread_priority::boost))
+            {
+                l = std::unique_lock<mutex_type>(mtx_);
             }
-            else
+
+            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
+            //       it unlocked when returning.
+        }
+
+        // Close the list of callbacks, callbacks registered from now on are
+        // invoked right away.
+        completed_callback_node* on_completed =
+            on_completed_.exchange(closed_on_completed, std::memory_order_acq_rel);
+        if (on_completed == nullptr)
+        {
+            return;
+        }
+
+        // The callbacks have been pushed onto the front of the list, invoke
+        // them in the order they have been registered.
+        completed_callback_node* reversed = nullptr;
+        while (on_completed != nullptr)
+        {
+            completed_callback_node* next = on_completed->next_;
+            on_completed->next_ = reversed;
+            reversed = on_completed;
+            on_completed = next;
+        }
+
+        // invoke the callback (continuation) functions
+        handle_on_completed(reversed);
+    }
+
+    void future_data_base<
+        traits::detail::future_data_void>::discard_on_completed() noexcept
+    {
+        completed_callback_node* on_completed =
+            on_completed_.exchange(nullptr, std::memory_order_acquire);
+        if (on_completed != closed_on_completed)
+        {
+            while (on_completed != nullptr)
             {
-                on_completed_.push_back(PIKA_MOVE(data_sink));
+                completed_callback_node* next = on_completed->next_;
+                on_completed->on_discarded();
+                on_completed = next;
             }
         }
+        on_completed_inline_used_.store(false, std::memory_order_relaxed);
     }
 
     future_data_base<traits::detail::future_data_void>::state
@@ -284,7 +406,11 @@ namespace pika { namespace lcos { namespace detail {
         if (s == empty)
         {
             std::unique_lock l(mtx_);
-            s = state_.load(std::memory_order_relaxed);
+
+            // announce this thread before re-checking the state, see
+            // handle_ready
+            has_waiters_.store(true);
+            s = state_.load();
             if (s == empty)
             {
                 cond_.wait(l, "future_data_base::wait", ec);
@@ -313,7 +439,11 @@ namespace pika { namespace lcos { namespace detail {
         if (state_.load(std::memory_order_acquire) == empty)
         {
             std::unique_lock l(mtx_);
-            if (state_.load(std::memory_order_relaxed) == empty)
+
+            // announce this thread before re-checking the state, see
+            // handle_ready
+            has_waiters_.store(true);
+            if (state_.load() == empty)
             {
                 threads::thread_restart_state const reason = cond_.wait_until(
                     l, abs_time, "future_data_base::wait_until", ec);
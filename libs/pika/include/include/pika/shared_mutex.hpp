@@ -10,6 +10,7 @@
 #include <pika/synchronization/shared_mutex.hpp>
 
 namespace pika {
+    using pika::lcos::local::reader_biased_shared_mutex;
     using pika::lcos::local::shared_mutex;
     using pika::lcos::local::upgrade_lock;
     using pika::lcos::local::upgrade_to_unique_lock;
@@ -9,8 +9,18 @@
 #include <pika/config.hpp>
 #include <pika/assert.hpp>
 #include <pika/async_base/launch_policy.hpp>
+#include <pika/concurrency/cache_line_data.hpp>
+#include <pika/concurrency/detail/segmented_queue.hpp>
+#include <pika/datastructures/optional.hpp>
+#include <pika/errors/try_catch_exception_ptr.hpp>
+#include <pika/execution_base/agent_ref.hpp>
+#include <pika/execution_base/receiver.hpp>
+#include <pika/execution_base/sender.hpp>
+#include <pika/execution_base/this_thread.hpp>
+#include <pika/futures/detail/future_data.hpp>
 #include <pika/futures/future.hpp>
 #include <pika/futures/packaged_task.hpp>
+#include <pika/futures/traits/future_access.hpp>
 #include <pika/iterator_support/iterator_facade.hpp>
 #include <pika/lcos/receive_buffer.hpp>
 #include <pika/lock_registration/detail/register_locks.hpp>
@@ -23,16 +33,138 @@
 #include <pika/thread_support/unlock_guard.hpp>
 #include <pika/type_support/unused.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <exception>
 #include <iterator>
 #include <mutex>
+#include <type_traits>
 #include <utility>
 
 namespace pika { namespace lcos { namespace local {
     ///////////////////////////////////////////////////////////////////////////
     namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // A receiver parked in a channel until a value is available. The
+        // channel calls exactly one of set_value and set_error, the waiter
+        // has to stay alive until then.
+        template <typename T>
+        struct channel_waiter
+        {
+            virtual void set_value(T&& t) = 0;
+            virtual void set_error(std::exception_ptr e) = 0;
+
+        protected:
+            ~channel_waiter() = default;
+        };
+
+        // Suspends the calling thread until the waiter has been completed.
+        template <typename T>
+        class channel_sync_waiter final : public channel_waiter<T>
+        {
+            enum class wait_state
+            {
+                empty,
+                waiting,
+                ready
+            };
+
+        public:
+            channel_sync_waiter()
+              : state_(wait_state::empty)
+              , agent_(pika::execution_base::this_thread::agent())
+            {
+            }
+
+            void set_value(T&& t) override
+            {
+                value_ = PIKA_MOVE(t);
+                set_ready();
+            }
+
+            void set_error(std::exception_ptr e) override
+            {
+                error_ = PIKA_MOVE(e);
+                set_ready();
+            }
+
+            T get(error_code& ec)
+            {
+                wait_state expected = wait_state::empty;
+                if (state_.compare_exchange_strong(
+                        expected, wait_state::waiting))
+                {
+                    agent_.suspend("pika::lcos::local::channel::get");
+                }
+                PIKA_ASSERT(state_.load(std::memory_order_acquire) ==
+                    wait_state::ready);
+
+                if (error_)
+                {
+                    if (&ec == &throws)
+                    {
+                        std::rethrow_exception(error_);
+                    }
+                    ec = make_error_code(error_);
+                    return T();
+                }
+                return PIKA_MOVE(*value_);
+            }
+
+        private:
+            void set_ready()
+            {
+                // the waiting thread may return as soon as the state is
+                // ready, the agent has to be copied before
+                pika::execution_base::agent_ref agent = agent_;
+                if (state_.exchange(wait_state::ready) == wait_state::waiting)
+                {
+                    agent.resume("pika::lcos::local::channel::get");
+                }
+            }
+
+            std::atomic<wait_state> state_;
+            pika::execution_base::agent_ref agent_;
+            pika::util::optional<T> value_;
+            std::exception_ptr error_;
+        };
+
+        // The shared state of a future returned by channel::get. It holds one
+        // reference on behalf of the channel while it is parked.
+        template <typename T>
+        class channel_future_waiter final
+          : public pika::lcos::detail::future_data<T>
+          , public channel_waiter<T>
+        {
+            using base_type = pika::lcos::detail::future_data<T>;
+
+        public:
+            channel_future_waiter()
+              : base_type(typename base_type::init_no_addref{})
+            {
+            }
+
+            void set_value(T&& t) override
+            {
+                base_type::set_value(PIKA_MOVE(t));
+                release();
+            }
+
+            void set_error(std::exception_ptr e) override
+            {
+                base_type::set_exception(PIKA_MOVE(e));
+                release();
+            }
+
+        private:
+            void release() noexcept
+            {
+                using pika::lcos::detail::intrusive_ptr_release;
+                intrusive_ptr_release(this);
+            }
+        };
+
         ///////////////////////////////////////////////////////////////////////
         template <typename T>
         struct channel_impl_base
@@ -51,6 +183,36 @@ namespace pika { namespace lcos { namespace local {
             virtual pika::future<void> set(std::size_t generation, T&& t) = 0;
             virtual std::size_t close(bool force_delete_entries = false) = 0;
 
+            // Parks the waiter until the value of the given generation is
+            // available. By default the waiter is completed once the future
+            // returned by get becomes ready.
+            virtual void receive(std::size_t generation, channel_waiter<T>& w,
+                bool blocking = false)
+            {
+                auto state = pika::traits::detail::get_shared_state(
+                    get(generation, blocking));
+                state->set_on_completed([state, &w]() {
+                    if (state->has_exception())
+                    {
+                        w.set_error(state->get_exception_ptr());
+                    }
+                    else
+                    {
+                        w.set_value(PIKA_MOVE(*state->get_result()));
+                    }
+                });
+            }
+
+            virtual T get_sync(std::size_t generation, error_code& ec)
+            {
+                return get(generation, true).get(ec);
+            }
+
+            virtual void set_sync(std::size_t generation, T&& t)
+            {
+                set(generation, PIKA_MOVE(t)).get();
+            }
+
             virtual bool requires_delete() noexcept
             {
                 return 0 == release();
@@ -94,107 +256,94 @@ namespace pika { namespace lcos { namespace local {
         }
 
         ///////////////////////////////////////////////////////////////////////
+        // The values set without an explicit generation are handed over
+        // through two lock-free queues, one holding values and one holding
+        // parked receivers. The balance of values over receivers decides
+        // which of the queues an operation uses: a set which finds receivers
+        // waiting completes the oldest of them directly, a get which finds
+        // values takes the oldest of those. Receivers are parked without
+        // allocating, as a suspended thread (get(launch::sync)) or as the
+        // operation state of a sender (async_get). Values with an explicit
+        // generation are matched by generation in a separate buffer which is
+        // protected by a spinlock.
         template <typename T>
         class unlimited_channel : public channel_impl_base<T>
         {
             using mutex_type = pika::lcos::local::spinlock;
+            using waiter_type = channel_waiter<T>;
 
         public:
             PIKA_NON_COPYABLE(unlimited_channel);
 
         public:
             unlimited_channel()
-              : get_generation_(0)
-              , set_generation_(0)
-              , closed_(false)
+              : closed_(false)
+            {
+                balance_.data_.store(0, std::memory_order_relaxed);
+            }
+
+            ~unlimited_channel()
             {
+                // futures and senders may still wait for a value once all
+                // channel objects are gone
+                if (balance_.data_.load(std::memory_order_relaxed) < 0)
+                {
+                    cancel_waiting(PIKA_GET_EXCEPTION(pika::broken_promise,
+                        "pika::lcos::local::channel::~channel",
+                        "the channel was destroyed while waiting on this "
+                        "entry"));
+                }
             }
 
         protected:
             pika::future<T> get(std::size_t generation, bool blocking)
             {
-                std::unique_lock<mutex_type> l(mtx_);
-
-                if (buffer_.empty())
+                if (generation != std::size_t(-1))
                 {
-                    if (closed_)
-                    {
-                        l.unlock();
-                        return pika::make_exceptional_future<T>(
-                            PIKA_GET_EXCEPTION(pika::invalid_status,
-                                "pika::lcos::local::channel::get",
-                                "this channel is empty and was closed"));
-                    }
-
-                    if (blocking && this->use_count() == 1)
-                    {
-                        l.unlock();
-                        return pika::make_exceptional_future<T>(
-                            PIKA_GET_EXCEPTION(pika::invalid_status,
-                                "pika::lcos::local::channel::get",
-                                "this channel is empty and is not accessible "
-                                "by any other thread causing a deadlock"));
-                    }
+                    return get_generation(generation, blocking);
                 }
 
-                ++get_generation_;
-                if (generation == std::size_t(-1))
-                    generation = get_generation_;
-
-                if (closed_)
+                if (try_reserve_value())
                 {
-                    // the requested item must be available, otherwise this
-                    // would create a deadlock
-                    pika::future<T> f;
-                    if (!buffer_.try_receive(generation, &f))
-                    {
-                        l.unlock();
-                        return pika::make_exceptional_future<T>(
-                            PIKA_GET_EXCEPTION(pika::invalid_status,
-                                "pika::lcos::local::channel::get",
-                                "this channel is closed and the requested value"
-                                "has not been received yet"));
-                    }
-                    return f;
+                    return pika::make_ready_future(take_value());
                 }
 
-                return buffer_.receive(generation);
+                pika::intrusive_ptr<channel_future_waiter<T>> w(
+                    new channel_future_waiter<T>(), false);
+                pika::future<T> f =
+                    pika::traits::future_access<pika::future<T>>::create(w);
+                receive(generation, *w.detach(), blocking);
+                return f;
             }
 
             bool try_get(std::size_t generation, pika::future<T>* f = nullptr)
             {
-                std::lock_guard<mutex_type> l(mtx_);
+                if (generation != std::size_t(-1))
+                {
+                    return try_get_generation(generation, f);
+                }
 
-                if (buffer_.empty() && closed_)
+                if (closed_ && balance_.data_.load() <= 0)
+                {
                     return false;
-
-                ++get_generation_;
-                if (generation == std::size_t(-1))
-                    generation = get_generation_;
+                }
 
                 if (f != nullptr)
-                    *f = buffer_.receive(generation);
-
+                {
+                    *f = get(generation, false);
+                }
                 return true;
             }
 
             pika::future<void> set(std::size_t generation, T&& t)
             {
-                std::unique_lock<mutex_type> l(mtx_);
-                if (closed_)
+                if (!push(generation, PIKA_MOVE(t)))
                 {
-                    l.unlock();
                     return pika::make_exceptional_future<void>(
                         PIKA_GET_EXCEPTION(pika::invalid_status,
                             "pika::lcos::local::channel::set",
                             "attempting to write to a closed channel"));
                 }
-
-                ++set_generation_;
-                if (generation == std::size_t(-1))
-                    generation = set_generation_;
-
-                buffer_.store_received(generation, PIKA_MOVE(t), &l);
                 return pika::make_ready_future();
             }
 
@@ -212,9 +361,6 @@ namespace pika { namespace lcos { namespace local {
 
                 closed_ = true;
 
-                if (buffer_.empty())
-                    return 0;
-
                 std::exception_ptr e;
 
                 {
@@ -227,15 +373,237 @@ namespace pika { namespace lcos { namespace local {
                 // all pending requests which can't be satisfied have to be
                 // canceled at this point, force deleting possibly waiting
                 // requests
-                return buffer_.cancel_waiting(e, force_delete_entries);
+                std::size_t count = 0;
+                if (!buffer_.empty())
+                {
+                    count = buffer_.cancel_waiting(e, force_delete_entries);
+                }
+                l.unlock();
+
+                return count + cancel_waiting(e);
+            }
+
+            void receive(std::size_t generation, waiter_type& w,
+                bool blocking = false)
+            {
+                if (generation != std::size_t(-1))
+                {
+                    channel_impl_base<T>::receive(generation, w, blocking);
+                    return;
+                }
+
+                if (balance_.data_.load() <= 0)
+                {
+                    if (closed_)
+                    {
+                        w.set_error(PIKA_GET_EXCEPTION(pika::invalid_status,
+                            "pika::lcos::local::channel::get",
+                            "this channel is empty and was closed"));
+                        return;
+                    }
+
+                    if (blocking && this->use_count() == 1)
+                    {
+                        w.set_error(PIKA_GET_EXCEPTION(pika::invalid_status,
+                            "pika::lcos::local::channel::get",
+                            "this channel is empty and is not accessible "
+                            "by any other thread causing a deadlock"));
+                        return;
+                    }
+                }
+
+                if (balance_.data_.fetch_sub(1) > 0)
+                {
+                    w.set_value(take_value());
+                    return;
+                }
+
+                waiters_.push(&w);
+
+                // the channel may have been closed without seeing this
+                // receiver
+                if (closed_)
+                {
+                    cancel_waiting(PIKA_GET_EXCEPTION(pika::future_cancelled,
+                        pika::lightweight, "pika::lcos::local::close",
+                        "canceled waiting on this entry"));
+                }
+            }
+
+            T get_sync(std::size_t generation, error_code& ec)
+            {
+                if (generation == std::size_t(-1) && try_reserve_value())
+                {
+                    return take_value();
+                }
+
+                channel_sync_waiter<T> w;
+                receive(generation, w, true);
+                return w.get(ec);
+            }
+
+            void set_sync(std::size_t generation, T&& t)
+            {
+                if (!push(generation, PIKA_MOVE(t)))
+                {
+                    PIKA_THROW_EXCEPTION(pika::invalid_status,
+                        "pika::lcos::local::channel::set",
+                        "attempting to write to a closed channel");
+                }
             }
 
         private:
+            // Returns false if the channel was closed.
+            bool push(std::size_t generation, T&& t)
+            {
+                if (generation != std::size_t(-1))
+                {
+                    std::unique_lock<mutex_type> l(mtx_);
+                    if (closed_)
+                    {
+                        return false;
+                    }
+
+                    buffer_.store_received(generation, PIKA_MOVE(t), &l);
+                    return true;
+                }
+
+                if (closed_)
+                {
+                    return false;
+                }
+
+                if (balance_.data_.fetch_add(1) < 0)
+                {
+                    take_waiter()->set_value(PIKA_MOVE(t));
+                }
+                else
+                {
+                    values_.push(PIKA_MOVE(t));
+                }
+                return true;
+            }
+
+            bool try_reserve_value() noexcept
+            {
+                std::ptrdiff_t count =
+                    balance_.data_.load(std::memory_order_relaxed);
+                while (count > 0)
+                {
+                    if (balance_.data_.compare_exchange_weak(count, count - 1))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // The value or the waiter was reserved through balance_ already,
+            // but it may not have been pushed yet.
+            T take_value()
+            {
+                pika::util::optional<T> value;
+                pika::util::yield_while([&]() { return !values_.pop(value); },
+                    "pika::lcos::local::channel::get");
+                return PIKA_MOVE(*value);
+            }
+
+            waiter_type* take_waiter()
+            {
+                waiter_type* w = nullptr;
+                pika::util::yield_while([&]() { return !waiters_.pop(w); },
+                    "pika::lcos::local::channel::set");
+                return w;
+            }
+
+            // Completes all parked receivers with the given error, returns
+            // their number.
+            std::size_t cancel_waiting(std::exception_ptr const& e)
+            {
+                std::size_t count = 0;
+                std::ptrdiff_t balance = balance_.data_.load();
+                while (balance < 0)
+                {
+                    if (balance_.data_.compare_exchange_weak(
+                            balance, balance + 1))
+                    {
+                        take_waiter()->set_error(e);
+                        ++count;
+                        balance = balance_.data_.load();
+                    }
+                }
+                return count;
+            }
+
+            pika::future<T> get_generation(
+                std::size_t generation, bool blocking)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+
+                if (buffer_.empty())
+                {
+                    if (closed_)
+                    {
+                        l.unlock();
+                        return pika::make_exceptional_future<T>(
+                            PIKA_GET_EXCEPTION(pika::invalid_status,
+                                "pika::lcos::local::channel::get",
+                                "this channel is empty and was closed"));
+                    }
+
+                    if (blocking && this->use_count() == 1)
+                    {
+                        l.unlock();
+                        return pika::make_exceptional_future<T>(
+                            PIKA_GET_EXCEPTION(pika::invalid_status,
+                                "pika::lcos::local::channel::get",
+                                "this channel is empty and is not accessible "
+                                "by any other thread causing a deadlock"));
+                    }
+                }
+
+                if (closed_)
+                {
+                    // the requested item must be available, otherwise this
+                    // would create a deadlock
+                    pika::future<T> f;
+                    if (!buffer_.try_receive(generation, &f))
+                    {
+                        l.unlock();
+                        return pika::make_exceptional_future<T>(
+                            PIKA_GET_EXCEPTION(pika::invalid_status,
+                                "pika::lcos::local::channel::get",
+                                "this channel is closed and the requested value"
+                                "has not been received yet"));
+                    }
+                    return f;
+                }
+
+                return buffer_.receive(generation);
+            }
+
+            bool try_get_generation(
+                std::size_t generation, pika::future<T>* f)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                if (buffer_.empty() && closed_)
+                    return false;
+
+                if (f != nullptr)
+                    *f = buffer_.receive(generation);
+
+                return true;
+            }
+
+            // number of values minus the number of parked receivers
+            pika::util::cache_line_data<std::atomic<std::ptrdiff_t>> balance_;
+            pika::concurrency::detail::segmented_queue<T> values_;
+            pika::concurrency::detail::segmented_queue<waiter_type*> waiters_;
+
             mutable mutex_type mtx_;
             receive_buffer<T, no_mutex> buffer_;
-            std::size_t get_generation_;
-            std::size_t set_generation_;
-            bool closed_;
+            std::atomic<bool> closed_;
         };
 
         ///////////////////////////////////////////////////////////////////////
@@ -538,6 +906,186 @@ namespace pika { namespace lcos { namespace local {
             bool closed_;
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        // The sender returned by channel::async_get. Its operation state is
+        // parked in the channel until a value is available, the receiver is
+        // then completed on the thread setting the value.
+        template <typename T>
+        struct channel_get_sender
+        {
+            pika::intrusive_ptr<channel_impl_base<T>> channel;
+            std::size_t generation;
+
+            template <template <typename...> class Tuple,
+                template <typename...> class Variant>
+            using value_types =
+                std::conditional_t<std::is_same_v<T, util::unused_type>,
+                    Variant<Tuple<>>, Variant<Tuple<T>>>;
+
+            template <template <typename...> class Variant>
+            using error_types = Variant<std::exception_ptr>;
+
+            static constexpr bool sends_done = false;
+
+            template <typename Receiver>
+            struct operation_state final : channel_waiter<T>
+            {
+                PIKA_NO_UNIQUE_ADDRESS std::decay_t<Receiver> receiver;
+                pika::intrusive_ptr<channel_impl_base<T>> channel;
+                std::size_t generation;
+
+                template <typename Receiver_>
+                operation_state(Receiver_&& receiver,
+                    pika::intrusive_ptr<channel_impl_base<T>> channel,
+                    std::size_t generation)
+                  : receiver(PIKA_FORWARD(Receiver_, receiver))
+                  , channel(PIKA_MOVE(channel))
+                  , generation(generation)
+                {
+                }
+
+                operation_state(operation_state&&) = delete;
+                operation_state& operator=(operation_state&&) = delete;
+                operation_state(operation_state const&) = delete;
+                operation_state& operator=(operation_state const&) = delete;
+
+                void set_value(T&& t) override
+                {
+                    pika::detail::try_catch_exception_ptr(
+                        [&]() {
+                            if constexpr (std::is_same_v<T, util::unused_type>)
+                            {
+                                PIKA_UNUSED(t);
+                                pika::execution::experimental::set_value(
+                                    PIKA_MOVE(receiver));
+                            }
+                            else
+                            {
+                                pika::execution::experimental::set_value(
+                                    PIKA_MOVE(receiver), PIKA_MOVE(t));
+                            }
+                        },
+                        [&](std::exception_ptr ep) {
+                            pika::execution::experimental::set_error(
+                                PIKA_MOVE(receiver), PIKA_MOVE(ep));
+                        });
+                }
+
+                void set_error(std::exception_ptr e) override
+                {
+                    pika::execution::experimental::set_error(
+                        PIKA_MOVE(receiver), PIKA_MOVE(e));
+                }
+
+                friend void tag_invoke(pika::execution::experimental::start_t,
+                    operation_state& os) noexcept
+                {
+                    pika::detail::try_catch_exception_ptr(
+                        [&]() { os.channel->receive(os.generation, os); },
+                        [&](std::exception_ptr ep) {
+                            os.set_error(PIKA_MOVE(ep));
+                        });
+                }
+            };
+
+            template <typename Receiver>
+            friend operation_state<Receiver> tag_invoke(
+                pika::execution::experimental::connect_t,
+                channel_get_sender&& s, Receiver&& receiver)
+            {
+                return {PIKA_FORWARD(Receiver, receiver), PIKA_MOVE(s.channel),
+                    s.generation};
+            }
+
+            template <typename Receiver>
+            friend operation_state<Receiver> tag_invoke(
+                pika::execution::experimental::connect_t,
+                channel_get_sender& s, Receiver&& receiver)
+            {
+                return {
+                    PIKA_FORWARD(Receiver, receiver), s.channel, s.generation};
+            }
+        };
+
+        // The sender returned by channel::async_set. The value is set when
+        // the operation is started, which completes a receiver parked in the
+        // channel right away.
+        template <typename T>
+        struct channel_set_sender
+        {
+            pika::intrusive_ptr<channel_impl_base<T>> channel;
+            T value;
+            std::size_t generation;
+
+            template <template <typename...> class Tuple,
+                template <typename...> class Variant>
+            using value_types = Variant<Tuple<>>;
+
+            template <template <typename...> class Variant>
+            using error_types = Variant<std::exception_ptr>;
+
+            static constexpr bool sends_done = false;
+
+            template <typename Receiver>
+            struct operation_state
+            {
+                PIKA_NO_UNIQUE_ADDRESS std::decay_t<Receiver> receiver;
+                pika::intrusive_ptr<channel_impl_base<T>> channel;
+                T value;
+                std::size_t generation;
+
+                template <typename Receiver_>
+                operation_state(Receiver_&& receiver,
+                    pika::intrusive_ptr<channel_impl_base<T>> channel,
+                    T value, std::size_t generation)
+                  : receiver(PIKA_FORWARD(Receiver_, receiver))
+                  , channel(PIKA_MOVE(channel))
+                  , value(PIKA_MOVE(value))
+                  , generation(generation)
+                {
+                }
+
+                operation_state(operation_state&&) = delete;
+                operation_state& operator=(operation_state&&) = delete;
+                operation_state(operation_state const&) = delete;
+                operation_state& operator=(operation_state const&) = delete;
+
+                friend void tag_invoke(pika::execution::experimental::start_t,
+                    operation_state& os) noexcept
+                {
+                    pika::detail::try_catch_exception_ptr(
+                        [&]() {
+                            os.channel->set_sync(
+                                os.generation, PIKA_MOVE(os.value));
+                            pika::execution::experimental::set_value(
+                                PIKA_MOVE(os.receiver));
+                        },
+                        [&](std::exception_ptr ep) {
+                            pika::execution::experimental::set_error(
+                                PIKA_MOVE(os.receiver), PIKA_MOVE(ep));
+                        });
+                }
+            };
+
+            template <typename Receiver>
+            friend operation_state<Receiver> tag_invoke(
+                pika::execution::experimental::connect_t,
+                channel_set_sender&& s, Receiver&& receiver)
+            {
+                return {PIKA_FORWARD(Receiver, receiver), PIKA_MOVE(s.channel),
+                    PIKA_MOVE(s.value), s.generation};
+            }
+
+            template <typename Receiver>
+            friend operation_state<Receiver> tag_invoke(
+                pika::execution::experimental::connect_t,
+                channel_set_sender& s, Receiver&& receiver)
+            {
+                return {PIKA_FORWARD(Receiver, receiver), s.channel, s.value,
+                    s.generation};
+            }
+        };
+
         ///////////////////////////////////////////////////////////////////////
         template <typename T>
         class channel_base;
@@ -716,23 +1264,31 @@ namespace pika { namespace lcos { namespace local {
             T get(launch::sync_policy, std::size_t generation = std::size_t(-1),
                 error_code& ec = throws) const
             {
-                return channel_->get(generation, true).get(ec);
+                return channel_->get_sync(generation, ec);
             }
             T get(launch::sync_policy, error_code& ec,
                 std::size_t generation = std::size_t(-1)) const
             {
-                return channel_->get(generation, true).get(ec);
+                return channel_->get_sync(generation, ec);
+            }
+
+            // Returns a sender which sends the next value (or the value of
+            // the given generation) once it is available.
+            channel_get_sender<T> async_get(
+                std::size_t generation = std::size_t(-1)) const
+            {
+                return {channel_, generation};
             }
 
             ///////////////////////////////////////////////////////////////////
             void set(T val, std::size_t generation = std::size_t(-1))
             {
-                channel_->set(generation, PIKA_MOVE(val)).get();
+                channel_->set_sync(generation, PIKA_MOVE(val));
             }
             void set(launch::sync_policy, T val,
                 std::size_t generation = std::size_t(-1))
             {
-                channel_->set(generation, PIKA_MOVE(val)).get();
+                channel_->set_sync(generation, PIKA_MOVE(val));
             }
             pika::future<void> set(launch::async_policy, T val,
                 std::size_t generation = std::size_t(-1))
@@ -740,6 +1296,13 @@ namespace pika { namespace lcos { namespace local {
                 return channel_->set(generation, PIKA_MOVE(val));
             }
 
+            // Returns a sender which sets the value once it is started.
+            channel_set_sender<T> async_set(
+                T val, std::size_t generation = std::size_t(-1))
+            {
+                return {channel_, PIKA_MOVE(val), generation};
+            }
+
             std::size_t close(bool force_delete_entries = false)
             {
                 return channel_->close(force_delete_entries);
@@ -799,6 +1362,8 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_get;
+        using base_type::async_set;
         using base_type::begin;
         using base_type::close;
         using base_type::end;
@@ -826,6 +1391,8 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_get;
+        using base_type::async_set;
         using base_type::begin;
         using base_type::close;
         using base_type::end;
@@ -854,6 +1421,7 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_get;
         using base_type::begin;
         using base_type::end;
         using base_type::get;
@@ -876,6 +1444,7 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_set;
         using base_type::close;
         using base_type::set;
     };
@@ -998,23 +1567,29 @@ namespace pika { namespace lcos { namespace local {
                 std::size_t generation = std::size_t(-1),
                 error_code& ec = throws) const
             {
-                channel_->get(generation, true).get(ec);
+                channel_->get_sync(generation, ec);
             }
             void get(launch::sync_policy, error_code& ec,
                 std::size_t generation = std::size_t(-1)) const
             {
-                channel_->get(generation, true).get(ec);
+                channel_->get_sync(generation, ec);
+            }
+
+            channel_get_sender<util::unused_type> async_get(
+                std::size_t generation = std::size_t(-1)) const
+            {
+                return {channel_, generation};
             }
 
             ///////////////////////////////////////////////////////////////////////
             void set(std::size_t generation = std::size_t(-1))
             {
-                channel_->set(generation, pika::util::unused_type()).get();
+                channel_->set_sync(generation, pika::util::unused_type());
             }
             void set(
                 launch::sync_policy, std::size_t generation = std::size_t(-1))
             {
-                channel_->set(generation, pika::util::unused_type()).get();
+                channel_->set_sync(generation, pika::util::unused_type());
             }
             pika::future<void> set(
                 launch::async_policy, std::size_t generation = std::size_t(-1))
@@ -1022,6 +1597,12 @@ namespace pika { namespace lcos { namespace local {
                 return channel_->set(generation, pika::util::unused_type());
             }
 
+            channel_set_sender<util::unused_type> async_set(
+                std::size_t generation = std::size_t(-1))
+            {
+                return {channel_, pika::util::unused_type(), generation};
+            }
+
             std::size_t close(bool force_delete_entries = false)
             {
                 return channel_->close(force_delete_entries);
@@ -1081,6 +1662,8 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_get;
+        using base_type::async_set;
         using base_type::begin;
         using base_type::close;
         using base_type::end;
@@ -1107,6 +1690,8 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_get;
+        using base_type::async_set;
         using base_type::begin;
         using base_type::close;
         using base_type::end;
@@ -1135,6 +1720,7 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_get;
         using base_type::begin;
         using base_type::end;
         using base_type::get;
@@ -1157,6 +1743,7 @@ namespace pika { namespace lcos { namespace local {
         {
         }
 
+        using base_type::async_set;
         using base_type::close;
         using base_type::set;
     };
@@ -4,15 +4,20 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <pika/execution.hpp>
 #include <pika/future.hpp>
 #include <pika/init.hpp>
 #include <pika/modules/testing.hpp>
 
 #include <atomic>
+#include <cstddef>
+#include <exception>
 #include <numeric>
 #include <string>
 #include <vector>
 
+namespace ex = pika::execution::experimental;
+
 ///////////////////////////////////////////////////////////////////////////////
 void sum(std::vector<int> const& s, pika::lcos::local::channel<int> c)
 {
@@ -201,6 +206,127 @@ void channel_range_void()
     PIKA_TEST_EQ(received_elements.load(), 3);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void async_get_set()
+{
+    pika::lcos::local::channel<int> c;
+
+    // values set before the receiver arrives
+    ex::sync_wait(c.async_set(42));
+    PIKA_TEST_EQ(ex::sync_wait(c.async_get()), 42);
+
+    // receivers arriving before the values are completed in order
+    std::vector<int> received;
+    ex::start_detached(
+        c.async_get() | ex::then([&](int i) { received.push_back(i); }));
+    ex::start_detached(
+        c.async_get() | ex::then([&](int i) { received.push_back(i); }));
+    PIKA_TEST(received.empty());
+
+    c.set(1);
+    c.set(2);
+    PIKA_TEST_EQ(received.size(), std::size_t(2));
+    PIKA_TEST_EQ(received[0], 1);
+    PIKA_TEST_EQ(received[1], 2);
+
+    // parked receivers are canceled when the channel is closed
+    bool canceled = false;
+    ex::start_detached(c.async_get() | ex::then([](int) { PIKA_TEST(false); }) |
+        ex::let_error([&](std::exception_ptr) {
+            canceled = true;
+            return ex::just();
+        }));
+    PIKA_TEST_EQ(c.close(), std::size_t(1));
+    PIKA_TEST(canceled);
+
+    bool caught_exception = false;
+    try
+    {
+        ex::sync_wait(c.async_set(43));
+        PIKA_TEST(false);
+    }
+    catch (pika::exception const&)
+    {
+        caught_exception = true;
+    }
+    PIKA_TEST(caught_exception);
+}
+
+void async_get_set_void()
+{
+    pika::lcos::local::channel<> c;
+
+    bool received = false;
+    ex::start_detached(c.async_get() | ex::then([&]() { received = true; }));
+    PIKA_TEST(!received);
+
+    ex::sync_wait(c.async_set());
+    PIKA_TEST(received);
+
+    c.set();
+    ex::sync_wait(c.async_get());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void multiple_producers_consumers()
+{
+    std::size_t const num_producers = 4;
+    std::size_t const num_consumers = 4;
+    std::size_t const num_values = 10000;
+
+    pika::lcos::local::channel<std::size_t> c;
+
+    std::vector<pika::future<void>> producers;
+    for (std::size_t p = 0; p != num_producers; ++p)
+    {
+        producers.push_back(pika::async([=]() mutable {
+            for (std::size_t i = 0; i != num_values; ++i)
+            {
+                c.set(p * num_values + i);
+            }
+        }));
+    }
+
+    std::vector<pika::future<std::vector<std::size_t>>> consumers;
+    for (std::size_t i = 0; i != num_consumers; ++i)
+    {
+        consumers.push_back(pika::async([=]() {
+            std::vector<std::size_t> values;
+            values.reserve(num_producers * num_values / num_consumers);
+            while (values.size() != num_producers * num_values / num_consumers)
+            {
+                values.push_back(i % 2 == 0 ? c.get(pika::launch::sync) :
+                                              ex::sync_wait(c.async_get()));
+            }
+            return values;
+        }));
+    }
+
+    pika::wait_all(producers);
+
+    // each value is received once, and the values of each producer are
+    // received in order
+    std::vector<bool> seen(num_producers * num_values, false);
+    for (auto& f : consumers)
+    {
+        std::vector<std::size_t> last(num_producers, 0);
+        for (std::size_t value : f.get())
+        {
+            PIKA_TEST(!seen[value]);
+            seen[value] = true;
+
+            std::size_t const p = value / num_values;
+            PIKA_TEST_LTE(last[p], value);
+            last[p] = value;
+        }
+    }
+
+    for (bool s : seen)
+    {
+        PIKA_TEST(s);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void deadlock_test()
 {
@@ -345,6 +471,9 @@ int pika_main()
     dispatch_work();
     channel_range();
     channel_range_void();
+    async_get_set();
+    async_get_set_void();
+    multiple_producers_consumers();
 
     deadlock_test();
     closed_channel_get();
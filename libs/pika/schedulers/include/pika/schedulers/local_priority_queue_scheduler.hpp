@@ -21,6 +21,7 @@
 #include <pika/threading_base/thread_data.hpp>
 #include <pika/threading_base/thread_num_tss.hpp>
 #include <pika/threading_base/thread_queue_init_parameters.hpp>
+#include <pika/timing/high_resolution_clock.hpp>
 #include <pika/topology/topology.hpp>
 
 #include <atomic>
@@ -124,6 +125,7 @@ namespace pika { namespace threads { namespace policies {
           , queues_(num_queues_)
           , high_priority_queues_(num_queues_)
           , victim_threads_(num_queues_)
+          , steal_seeds_(num_queues_)
         {
             if (!deferred_initialization)
             {
@@ -446,6 +448,58 @@ namespace pika { namespace threads { namespace policies {
             }
             return num_stolen_threads;
         }
+
+        // steal attempts are accounted to the (normal priority) queue of the
+        // worker thread trying to steal
+        std::int64_t get_num_steal_attempts(
+            std::size_t num_thread, bool reset) override
+        {
+            if (num_thread != std::size_t(-1))
+            {
+                return queues_[num_thread].data_->get_num_steal_attempts(
+                    reset);
+            }
+
+            std::int64_t num_steal_attempts = 0;
+            for (std::size_t i = 0; i != num_queues_; ++i)
+            {
+                num_steal_attempts +=
+                    queues_[i].data_->get_num_steal_attempts(reset);
+            }
+            return num_steal_attempts;
+        }
+
+        std::int64_t get_num_failed_steals(
+            std::size_t num_thread, bool reset) override
+        {
+            if (num_thread != std::size_t(-1))
+            {
+                return queues_[num_thread].data_->get_num_failed_steals(reset);
+            }
+
+            std::int64_t num_failed_steals = 0;
+            for (std::size_t i = 0; i != num_queues_; ++i)
+            {
+                num_failed_steals +=
+                    queues_[i].data_->get_num_failed_steals(reset);
+            }
+            return num_failed_steals;
+        }
+
+        std::int64_t get_steal_time(std::size_t num_thread, bool reset) override
+        {
+            if (num_thread != std::size_t(-1))
+            {
+                return queues_[num_thread].data_->get_steal_time(reset);
+            }
+
+            std::int64_t steal_time = 0;
+            for (std::size_t i = 0; i != num_queues_; ++i)
+            {
+                steal_time += queues_[i].data_->get_steal_time(reset);
+            }
+            return steal_time;
+        }
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -638,28 +692,49 @@ namespace pika { namespace threads { namespace policies {
 
             if (enable_stealing)
             {
-                for (std::size_t idx : victim_threads_[num_thread].data_)
-                {
+                steal_attempt attempt(this_queue);
+
+                auto steal = [&](std::size_t idx) {
                     PIKA_ASSERT(idx != num_thread);
 
                     if (idx < num_high_priority_queues_ &&
-                        num_thread < num_high_priority_queues_)
+                        num_thread < num_high_priority_queues_ &&
+                        steal_pending(high_priority_queues_[idx].data_,
+                            this_high_priority_queue, thrd, running))
                     {
-                        thread_queue_type* q = high_priority_queues_[idx].data_;
-                        if (q->get_next_thread(thrd, running, true))
+                        return true;
+                    }
+
+                    return steal_pending(
+                        queues_[idx].data_, this_queue, thrd, running);
+                };
+
+                std::size_t const victim =
+                    select_victim(num_thread, [&](std::size_t idx) {
+                        std::int64_t length =
+                            queues_[idx].data_->get_pending_queue_length(
+                                std::memory_order_relaxed);
+                        if (idx < num_high_priority_queues_ &&
+                            num_thread < num_high_priority_queues_)
                         {
-                            q->increment_num_stolen_from_pending();
-                            this_high_priority_queue
-                                ->increment_num_stolen_to_pending();
-                            return true;
+                            length += high_priority_queues_[idx]
+                                          .data_->get_pending_queue_length(
+                                              std::memory_order_relaxed);
                         }
-                    }
+                        return length;
+                    });
 
-                    if (queues_[idx].data_->get_next_thread(
-                            thrd, running, true))
+                if (victim != std::size_t(-1) && steal(victim))
+                {
+                    attempt.succeeded();
+                    return true;
+                }
+
+                for (std::size_t idx : victim_threads_[num_thread].data_)
+                {
+                    if (idx != victim && steal(idx))
                     {
-                        queues_[idx].data_->increment_num_stolen_from_pending();
-                        this_queue->increment_num_stolen_to_pending();
+                        attempt.succeeded();
                         return true;
                     }
                 }
@@ -1134,8 +1209,9 @@ namespace pika { namespace threads { namespace policies {
 
             if (enable_stealing)
             {
-                for (std::size_t idx : victim_threads_[num_thread].data_)
-                {
+                steal_attempt attempt(this_queue);
+
+                auto steal = [&](std::size_t idx) {
                     PIKA_ASSERT(idx != num_thread);
 
                     if (idx < num_high_priority_queues_ &&
@@ -1151,7 +1227,7 @@ namespace pika { namespace threads { namespace policies {
                             q->increment_num_stolen_from_staged(added);
                             this_high_priority_queue
                                 ->increment_num_stolen_to_staged(added);
-                            return result;
+                            return true;
                         }
                     }
 
@@ -1164,6 +1240,37 @@ namespace pika { namespace threads { namespace policies {
                         queues_[idx].data_->increment_num_stolen_from_staged(
                             added);
                         this_queue->increment_num_stolen_to_staged(added);
+                        return true;
+                    }
+                    return false;
+                };
+
+                std::size_t const victim =
+                    select_victim(num_thread, [&](std::size_t idx) {
+                        std::int64_t length =
+                            queues_[idx].data_->get_staged_queue_length(
+                                std::memory_order_relaxed);
+                        if (idx < num_high_priority_queues_ &&
+                            num_thread < num_high_priority_queues_)
+                        {
+                            length += high_priority_queues_[idx]
+                                          .data_->get_staged_queue_length(
+                                              std::memory_order_relaxed);
+                        }
+                        return length;
+                    });
+
+                if (victim != std::size_t(-1) && steal(victim))
+                {
+                    attempt.succeeded();
+                    return result;
+                }
+
+                for (std::size_t idx : victim_threads_[num_thread].data_)
+                {
+                    if (idx != victim && steal(idx))
+                    {
+                        attempt.succeeded();
                         return result;
                     }
                 }
@@ -1259,6 +1366,10 @@ namespace pika { namespace threads { namespace policies {
                 core_masks[i] = topo.get_core_affinity_mask(num_pu);
             }
 
+            // any non-zero value will do as the seed of the victim selection
+            steal_seeds_[num_thread].data_ =
+                0x9e3779b97f4a7c15ull * (num_thread + 1);
+
             // iterate over the number of threads again to determine where to
             // steal from
             std::ptrdiff_t radius =
@@ -1368,6 +1479,105 @@ namespace pika { namespace threads { namespace policies {
             curr_queue_.store(0, std::memory_order_release);
         }
 
+    protected:
+#ifdef PIKA_HAVE_THREAD_STEALING_COUNTS
+        // Accounts an attempt to steal work, its duration, and whether it
+        // failed to the queue of the worker thread trying to steal.
+        class steal_attempt
+        {
+        public:
+            explicit steal_attempt(thread_queue_type* queue) noexcept
+              : queue_(queue)
+              , start_(pika::chrono::high_resolution_clock::now())
+            {
+            }
+
+            ~steal_attempt()
+            {
+                queue_->increment_num_steal_attempts();
+                queue_->increment_steal_time(static_cast<std::int64_t>(
+                    pika::chrono::high_resolution_clock::now() - start_));
+                if (!succeeded_)
+                {
+                    queue_->increment_num_failed_steals();
+                }
+            }
+
+            void succeeded() noexcept
+            {
+                succeeded_ = true;
+            }
+
+        private:
+            thread_queue_type* queue_;
+            std::uint64_t start_;
+            bool succeeded_ = false;
+        };
+#else
+        struct steal_attempt
+        {
+            constexpr explicit steal_attempt(thread_queue_type*) noexcept {}
+            constexpr void succeeded() noexcept {}
+        };
+#endif
+
+        // Picks two of the victims of num_thread at random and returns the
+        // one with more work as reported by length, or std::size_t(-1) if
+        // neither has any work. Choosing the better of two random victims
+        // spreads the thieves over the busy queues instead of having all of
+        // them hit the same neighbor first.
+        template <typename F>
+        std::size_t select_victim(std::size_t num_thread, F&& length)
+        {
+            std::vector<std::size_t> const& victims =
+                victim_threads_[num_thread].data_;
+            if (victims.empty())
+            {
+                return std::size_t(-1);
+            }
+
+            // xorshift64*
+            std::uint64_t& seed = steal_seeds_[num_thread].data_;
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            std::uint64_t const r = seed * 0x2545f4914f6cdd1dull;
+
+            std::size_t first = victims[(r & 0xffffffff) % victims.size()];
+            std::size_t second = victims[(r >> 32) % victims.size()];
+
+            std::int64_t first_length = length(first);
+            if (first != second)
+            {
+                std::int64_t const second_length = length(second);
+                if (second_length > first_length)
+                {
+                    first = second;
+                    first_length = second_length;
+                }
+            }
+            return first_length > 0 ? first : std::size_t(-1);
+        }
+
+        // Steals a thread to run from victim and moves up to half of the
+        // pending threads left in victim to queue, which saves the thief from
+        // having to come back for more right away.
+        static bool steal_pending(thread_queue_type* victim,
+            thread_queue_type* queue, threads::thread_id_ref_type& thrd,
+            bool running)
+        {
+            if (!victim->get_next_thread(thrd, running, true))
+            {
+                return false;
+            }
+
+            std::size_t const stolen =
+                1 + queue->steal_half_work_items_from(victim);
+            victim->increment_num_stolen_from_pending(stolen);
+            queue->increment_num_stolen_to_pending(stolen);
+            return true;
+        }
+
     protected:
         std::atomic<std::size_t> curr_queue_;
 
@@ -1383,6 +1593,7 @@ namespace pika { namespace threads { namespace policies {
             high_priority_queues_;
         std::vector<util::cache_line_data<std::vector<std::size_t>>>
             victim_threads_;
+        std::vector<util::cache_line_data<std::uint64_t>> steal_seeds_;
     };
 }}}    // namespace pika::threads::policies
 
@@ -9,6 +9,7 @@
 
 #include <pika/config.hpp>
 #include <pika/allocator_support/internal_allocator.hpp>
+#include <pika/allocator_support/thread_local_pool_allocator.hpp>
 #include <pika/assert.hpp>
 #include <pika/concurrency/cache_line_data.hpp>
 #include <pika/datastructures/tuple.hpp>
@@ -20,6 +21,7 @@
 #include <pika/schedulers/maintain_queue_wait_times.hpp>
 #include <pika/schedulers/queue_helpers.hpp>
 #include <pika/thread_support/unlock_guard.hpp>
+#include <pika/threading_base/detail/thread_list.hpp>
 #include <pika/threading_base/scheduler_base.hpp>
 #include <pika/threading_base/thread_data.hpp>
 #include <pika/threading_base/thread_data_stackful.hpp>
@@ -41,7 +43,6 @@
 #include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -87,10 +88,9 @@ namespace pika { namespace threads { namespace policies {
         // we use a simple mutex to protect the data members for now
         using mutex_type = Mutex;
 
-        // this is the type of a map holding all threads (except depleted ones)
-        using thread_map_type = std::unordered_set<thread_id_type,
-            std::hash<thread_id_type>, std::equal_to<thread_id_type>,
-            util::internal_allocator<thread_id_type>>;
+        // this is the type of a map holding all threads (except depleted ones),
+        // threads are linked intrusively, no allocation is necessary
+        using thread_map_type = threads::detail::thread_list;
 
         using thread_heap_type = std::vector<thread_id_type,
             util::internal_allocator<thread_id_type>>;
@@ -197,7 +197,7 @@ namespace pika { namespace threads { namespace policies {
             }
         }
 
-        static util::internal_allocator<task_description>
+        static pika::detail::thread_local_pool_allocator<task_description>
             task_description_alloc_;
 
         ///////////////////////////////////////////////////////////////////////
@@ -237,19 +237,7 @@ namespace pika { namespace threads { namespace policies {
                 task_description_alloc_.deallocate(task, 1);
 
                 // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thrd.noref());
-
-                if (PIKA_UNLIKELY(!p.second))
-                {
-                    --addfrom->new_tasks_count_.data_;
-                    lk.unlock();
-                    PIKA_THROW_EXCEPTION(pika::out_of_memory,
-                        "thread_queue::add_new",
-                        "Couldn't add new thread to the thread map");
-                    return 0;
-                }
-
+                thread_map_.insert(thrd.noref());
                 ++thread_map_count_;
 
                 // Decrement only after thread_map_count_ has been incremented
@@ -328,31 +316,47 @@ namespace pika { namespace threads { namespace policies {
             std::ptrdiff_t stacksize =
                 get_thread_id_data(thrd)->get_stack_size();
 
+            thread_heap_type* heap = nullptr;
             if (stacksize == parameters_.small_stacksize_)
             {
-                thread_heap_small_.push_back(thrd);
+                heap = &thread_heap_small_;
             }
             else if (stacksize == parameters_.medium_stacksize_)
             {
-                thread_heap_medium_.push_back(thrd);
+                heap = &thread_heap_medium_;
             }
             else if (stacksize == parameters_.large_stacksize_)
             {
-                thread_heap_large_.push_back(thrd);
+                heap = &thread_heap_large_;
             }
             else if (stacksize == parameters_.huge_stacksize_)
             {
-                thread_heap_huge_.push_back(thrd);
+                heap = &thread_heap_huge_;
             }
             else if (stacksize == parameters_.nostack_stacksize_)
             {
-                thread_heap_nostack_.push_back(thrd);
+                heap = &thread_heap_nostack_;
             }
             else
             {
                 PIKA_ASSERT_MSG(
                     false, util::format("Invalid stack size {1}", stacksize));
+                return;
+            }
+
+            // Don't keep more thread objects around than the queue is
+            // expected to run concurrently. Destroying the surplus returns
+            // its stack to the process-wide stack cache, where it can be
+            // picked up by the other queues.
+            if (parameters_.max_thread_count_ != 0 &&
+                static_cast<std::int64_t>(heap->size()) >=
+                    parameters_.max_thread_count_)
+            {
+                deallocate(get_thread_id_data(thrd));
+                return;
             }
+
+            heap->push_back(thrd);
         }
 
     public:
@@ -380,9 +384,9 @@ namespace pika { namespace threads { namespace policies {
                     --terminated_items_count_;
 
                     // this thread has to be in this map
-                    PIKA_ASSERT(thread_map_.find(tid) != thread_map_.end());
+                    PIKA_ASSERT(thread_map_.contains(tid));
 
-                    if (thread_map_.erase(tid) != 0)
+                    if (thread_map_.erase(tid))
                     {
                         recycle_thread(tid);
                         --thread_map_count_;
@@ -409,9 +413,9 @@ namespace pika { namespace threads { namespace policies {
 
                     // this thread has to be in this map, except if it has changed
                     // its priority, then it could be elsewhere
-                    PIKA_ASSERT(thread_map_.find(tid) != thread_map_.end());
+                    PIKA_ASSERT(thread_map_.contains(tid));
 
-                    if (thread_map_.erase(tid) != 0)
+                    if (thread_map_.erase(tid))
                     {
                         recycle_thread(tid);
                         --thread_map_count_;
@@ -479,6 +483,9 @@ namespace pika { namespace threads { namespace policies {
           , stolen_from_staged_(0)
           , stolen_to_pending_(0)
           , stolen_to_staged_(0)
+          , steal_attempts_(0)
+          , failed_steals_(0)
+          , steal_time_(0)
 #endif
         {
             new_tasks_count_.data_ = 0;
@@ -621,6 +628,36 @@ namespace pika { namespace threads { namespace policies {
         {
             stolen_to_staged_.fetch_add(num, std::memory_order_relaxed);
         }
+
+        std::int64_t get_num_steal_attempts(bool reset)
+        {
+            return util::get_and_reset_value(steal_attempts_, reset);
+        }
+
+        void increment_num_steal_attempts(std::size_t num = 1)
+        {
+            steal_attempts_.fetch_add(num, std::memory_order_relaxed);
+        }
+
+        std::int64_t get_num_failed_steals(bool reset)
+        {
+            return util::get_and_reset_value(failed_steals_, reset);
+        }
+
+        void increment_num_failed_steals(std::size_t num = 1)
+        {
+            failed_steals_.fetch_add(num, std::memory_order_relaxed);
+        }
+
+        std::int64_t get_steal_time(bool reset)
+        {
+            return util::get_and_reset_value(steal_time_, reset);
+        }
+
+        void increment_steal_time(std::int64_t time)
+        {
+            steal_time_.fetch_add(time, std::memory_order_relaxed);
+        }
 #else
         constexpr void increment_num_pending_misses(std::size_t /* num */ = 1)
         {
@@ -643,6 +680,13 @@ namespace pika { namespace threads { namespace policies {
         constexpr void increment_num_stolen_to_staged(std::size_t /* num */ = 1)
         {
         }
+        constexpr void increment_num_steal_attempts(std::size_t /* num */ = 1)
+        {
+        }
+        constexpr void increment_num_failed_steals(std::size_t /* num */ = 1)
+        {
+        }
+        constexpr void increment_steal_time(std::int64_t /* time */) {}
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -678,22 +722,11 @@ namespace pika { namespace threads { namespace policies {
                     create_thread_object(thrd, data, lk);
 
                     // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thrd.noref());
-
-                    if (PIKA_UNLIKELY(!p.second))
-                    {
-                        lk.unlock();
-                        PIKA_THROWS_IF(ec, pika::out_of_memory,
-                            "thread_queue::create_thread",
-                            "Couldn't add new thread to the map of threads");
-                        return;
-                    }
+                    thread_map_.insert(thrd.noref());
                     ++thread_map_count_;
 
                     // this thread has to be in the map now
-                    PIKA_ASSERT(
-                        thread_map_.find(thrd.noref()) != thread_map_.end());
+                    PIKA_ASSERT(thread_map_.contains(thrd.noref()));
                     PIKA_ASSERT(
                         &get_thread_id_data(thrd)->get_queue<thread_queue>() ==
                         this);
@@ -774,6 +807,38 @@ namespace pika { namespace threads { namespace policies {
             }
         }
 
+        /// Move up to half of the pending threads of victim to this queue,
+        /// returns the number of threads moved
+        std::size_t steal_half_work_items_from(thread_queue* victim)
+        {
+            std::int64_t count = victim->work_items_count_.data_.load(
+                                     std::memory_order_relaxed) /
+                2;
+
+            std::size_t moved = 0;
+            thread_description_ptr trd;
+            while (count-- > 0 && victim->work_items_.pop(trd, true))
+            {
+                --victim->work_items_count_.data_;
+
+#ifdef PIKA_HAVE_THREAD_QUEUE_WAITTIME
+                if (get_maintain_queue_wait_times_enabled())
+                {
+                    std::uint64_t now =
+                        pika::chrono::high_resolution_clock::now();
+                    victim->work_items_wait_ += now - trd->waittime;
+                    ++victim->work_items_wait_count_;
+                    trd->waittime = now;
+                }
+#endif
+
+                ++work_items_count_.data_;
+                work_items_.push(trd);
+                ++moved;
+            }
+            return moved;
+        }
+
         void move_task_items_from(thread_queue* src, std::int64_t count)
         {
             task_description* task = nullptr;
@@ -918,9 +983,9 @@ namespace pika { namespace threads { namespace policies {
         void abort_all_suspended_threads()
         {
             std::lock_guard<mutex_type> lk(mtx_);
-            thread_map_type::iterator end = thread_map_.end();
-            for (thread_map_type::iterator it = thread_map_.begin(); it != end;
-                 ++it)
+            thread_map_type::const_iterator end = thread_map_.end();
+            for (thread_map_type::const_iterator it = thread_map_.begin();
+                 it != end; ++it)
             {
                 auto thrd = get_thread_id_data(*it);
                 if (thrd->get_state().state() ==
@@ -1218,6 +1283,13 @@ namespace pika { namespace threads { namespace policies {
         std::atomic<std::int64_t> stolen_to_pending_;
         // count of new_tasks stolen to this queue from other queues
         std::atomic<std::int64_t> stolen_to_staged_;
+
+        // # of times our associated worker-thread tried to steal work
+        std::atomic<std::int64_t> steal_attempts_;
+        // # of those attempts which didn't find any work
+        std::atomic<std::int64_t> failed_steals_;
+        // time spent in those attempts [ns]
+        std::atomic<std::int64_t> steal_time_;
 #endif
         // count of new tasks to run, separate to new cache line to avoid false
         // sharing
@@ -1230,8 +1302,8 @@ namespace pika { namespace threads { namespace policies {
     ///////////////////////////////////////////////////////////////////////////
     template <typename Mutex, typename PendingQueuing, typename StagedQueuing,
         typename TerminatedQueuing>
-    util::internal_allocator<typename thread_queue<Mutex, PendingQueuing,
-        StagedQueuing, TerminatedQueuing>::task_description>
+    pika::detail::thread_local_pool_allocator<typename thread_queue<Mutex,
+        PendingQueuing, StagedQueuing, TerminatedQueuing>::task_description>
         thread_queue<Mutex, PendingQueuing, StagedQueuing,
             TerminatedQueuing>::task_description_alloc_;
 }}}    // namespace pika::threads::policies
@@ -7,18 +7,16 @@
 #pragma once
 
 #include <pika/allocator_support/internal_allocator.hpp>
+#include <pika/allocator_support/thread_local_caching_allocator.hpp>
 #include <pika/assert.hpp>
-#include <pika/datastructures/detail/small_vector.hpp>
 #include <pika/datastructures/optional.hpp>
 #include <pika/execution_base/operation_state.hpp>
 #include <pika/execution_base/receiver.hpp>
 #include <pika/execution_base/sender.hpp>
-#include <pika/functional/unique_function.hpp>
-#include <pika/synchronization/mutex.hpp>
 
+#include <atomic>
 #include <exception>
 #include <memory>
-#include <mutex>
 #include <type_traits>
 #include <utility>
 
@@ -30,18 +28,83 @@ namespace pika { namespace experimental {
             readwrite
         };
 
+        template <typename T>
+        struct async_rw_mutex_shared_state;
+
+        // Operation states waiting for access link themselves into an
+        // intrusive list in the shared state of the previous access. The
+        // continuation is called with the next shared state once all
+        // references to the previous shared state have been released.
+        template <typename T>
+        struct async_rw_mutex_operation_state_base
+        {
+            using shared_state_ptr_type =
+                std::shared_ptr<async_rw_mutex_shared_state<T>>;
+
+            async_rw_mutex_operation_state_base* next = nullptr;
+
+            virtual void continuation(shared_state_ptr_type state) noexcept = 0;
+
+        protected:
+            ~async_rw_mutex_operation_state_base() = default;
+        };
+
+        // Lock-free list of the operation states waiting for a shared state
+        // to be released. Operation states are only added while a reference
+        // to the shared state is held, and the list is only traversed once
+        // the last reference has been released, so traversal never races
+        // with insertion.
+        template <typename T>
+        class async_rw_mutex_operation_state_list
+        {
+        public:
+            using operation_state_type = async_rw_mutex_operation_state_base<T>;
+            using shared_state_ptr_type =
+                typename operation_state_type::shared_state_ptr_type;
+
+            bool empty() const noexcept
+            {
+                return head.load(std::memory_order_relaxed) == nullptr;
+            }
+
+            void push(operation_state_type* op_state) noexcept
+            {
+                operation_state_type* old_head =
+                    head.load(std::memory_order_relaxed);
+                do
+                {
+                    op_state->next = old_head;
+                } while (!head.compare_exchange_weak(old_head, op_state,
+                    std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            // Call the continuations of all operation states in the list.
+            // The operation states may be destroyed by their continuation.
+            void trigger(shared_state_ptr_type const& state) noexcept
+            {
+                operation_state_type* op_state =
+                    head.exchange(nullptr, std::memory_order_acquire);
+                while (op_state != nullptr)
+                {
+                    operation_state_type* next = op_state->next;
+                    op_state->continuation(state);
+                    op_state = next;
+                }
+            }
+
+        private:
+            std::atomic<operation_state_type*> head{nullptr};
+        };
+
         template <typename T>
         struct async_rw_mutex_shared_state
         {
             using shared_state_ptr_type =
                 std::shared_ptr<async_rw_mutex_shared_state>;
+            using operation_state_type = async_rw_mutex_operation_state_base<T>;
             pika::util::optional<T> value;
             shared_state_ptr_type next_state;
-            pika::lcos::local::mutex mtx;
-            pika::detail::small_vector<
-                pika::util::unique_function_nonser<void(shared_state_ptr_type)>,
-                1>
-                continuations;
+            async_rw_mutex_operation_state_list<T> continuations;
 
             async_rw_mutex_shared_state() = default;
             async_rw_mutex_shared_state(async_rw_mutex_shared_state&&) = delete;
@@ -70,10 +133,7 @@ namespace pika { namespace experimental {
                     // wrapped value, so we move the value to the next state.
                     next_state->set_value(PIKA_MOVE(value.value()));
 
-                    for (auto& continuation : continuations)
-                    {
-                        continuation(next_state);
-                    }
+                    continuations.trigger(next_state);
                 }
             }
 
@@ -92,11 +152,9 @@ namespace pika { namespace experimental {
                 next_state = PIKA_MOVE(state);
             }
 
-            template <typename F>
-            void add_continuation(F&& continuation)
+            void add_continuation(operation_state_type* op_state) noexcept
             {
-                std::lock_guard<pika::lcos::local::mutex> l(mtx);
-                continuations.emplace_back(PIKA_FORWARD(F, continuation));
+                continuations.push(op_state);
             }
         };
 
@@ -105,12 +163,10 @@ namespace pika { namespace experimental {
         {
             using shared_state_ptr_type =
                 std::shared_ptr<async_rw_mutex_shared_state>;
+            using operation_state_type =
+                async_rw_mutex_operation_state_base<void>;
             shared_state_ptr_type next_state;
-            pika::lcos::local::mutex mtx;
-            pika::detail::small_vector<
-                pika::util::unique_function_nonser<void(shared_state_ptr_type)>,
-                1>
-                continuations;
+            async_rw_mutex_operation_state_list<void> continuations;
 
             async_rw_mutex_shared_state() = default;
             async_rw_mutex_shared_state(async_rw_mutex_shared_state&&) = delete;
@@ -128,10 +184,7 @@ namespace pika { namespace experimental {
                 PIKA_ASSERT((continuations.empty() && !next_state) ||
                     (!continuations.empty() && next_state));
 
-                for (auto& continuation : continuations)
-                {
-                    continuation(next_state);
-                }
+                continuations.trigger(next_state);
             }
 
             void set_next_state(
@@ -142,11 +195,9 @@ namespace pika { namespace experimental {
                 next_state = PIKA_MOVE(state);
             }
 
-            template <typename F>
-            void add_continuation(F&& continuation)
+            void add_continuation(operation_state_type* op_state) noexcept
             {
-                std::lock_guard<pika::lcos::local::mutex> l(mtx);
-                continuations.emplace_back(PIKA_FORWARD(F, continuation));
+                continuations.push(op_state);
             }
         };
 
@@ -329,12 +380,13 @@ namespace pika { namespace experimental {
     //
     // When read-write access is required a sender is created which holds on to
     // the newly created shared state for the read-write access and the previous
-    // state. When the sender is connected to a receiver, a callback is added to
-    // the previous shared state's destructor. The callback holds the new state,
-    // and passes a wrapper holding the shared state to set_value. Once the
-    // receiver which receives the wrapper has let the wrapper go out of scope
-    // (and all other references to the shared state are out of scope), the new
-    // shared state will again trigger its continuations.
+    // state. When the operation state is started, it links itself into the
+    // (lock-free, intrusive) list of continuations of the previous shared
+    // state. When the previous shared state is destroyed it passes a wrapper
+    // holding the new shared state to set_value of each linked operation
+    // state. Once the receiver which receives the wrapper has let the wrapper
+    // go out of scope (and all other references to the shared state are out of
+    // scope), the new shared state will again trigger its continuations.
     //
     // When read-only access is required and the previous access was read-only
     // the procedure is the same as for read-write access. When read-only access
@@ -345,6 +397,10 @@ namespace pika { namespace experimental {
     //
     // The protected value is moved from state to state and is released when the
     // last shared state is destroyed.
+    //
+    // Shared states are allocated through a per-thread cache, so that in a
+    // steady state neither creating shared states nor registering
+    // continuations allocates memory.
 
     template <typename Allocator>
     class async_rw_mutex<void, void, Allocator>
@@ -383,8 +439,7 @@ namespace pika { namespace experimental {
             if (prev_access == detail::async_rw_mutex_access_type::readwrite)
             {
                 prev_state = PIKA_MOVE(state);
-                state = std::allocate_shared<shared_state_type, allocator_type>(
-                    alloc);
+                state = std::allocate_shared<shared_state_type>(alloc);
                 prev_access = detail::async_rw_mutex_access_type::read;
 
                 // Only the first access has no previous shared state. When
@@ -402,8 +457,7 @@ namespace pika { namespace experimental {
         sender<detail::async_rw_mutex_access_type::readwrite> readwrite()
         {
             prev_state = PIKA_MOVE(state);
-            state =
-                std::allocate_shared<shared_state_type, allocator_type>(alloc);
+            state = std::allocate_shared<shared_state_type>(alloc);
             prev_access = detail::async_rw_mutex_access_type::readwrite;
 
             // Only the first access has no previous shared state. When there is
@@ -437,6 +491,7 @@ namespace pika { namespace experimental {
 
             template <typename R>
             struct operation_state
+              : detail::async_rw_mutex_operation_state_base<readwrite_type>
             {
                 std::decay_t<R> r;
                 shared_state_ptr_type prev_state;
@@ -456,6 +511,20 @@ namespace pika { namespace experimental {
                 operation_state(operation_state const&) = delete;
                 operation_state& operator=(operation_state const&) = delete;
 
+                void continuation(shared_state_ptr_type state) noexcept override
+                {
+                    try
+                    {
+                        pika::execution::experimental::set_value(
+                            PIKA_MOVE(r), access_type{PIKA_MOVE(state)});
+                    }
+                    catch (...)
+                    {
+                        pika::execution::experimental::set_error(
+                            PIKA_MOVE(r), std::current_exception());
+                    }
+                }
+
                 friend void tag_invoke(pika::execution::experimental::start_t,
                     operation_state& os) noexcept
                 {
@@ -463,26 +532,9 @@ namespace pika { namespace experimental {
                         "async_rw_lock::sender::operation_state state is "
                         "empty, was the sender already started?");
 
-                    auto continuation =
-                        [r = PIKA_MOVE(os.r)](
-                            shared_state_ptr_type state) mutable {
-                            try
-                            {
-                                pika::execution::experimental::set_value(
-                                    PIKA_MOVE(r),
-                                    access_type{PIKA_MOVE(state)});
-                            }
-                            catch (...)
-                            {
-                                pika::execution::experimental::set_error(
-                                    PIKA_MOVE(r), std::current_exception());
-                            }
-                        };
-
                     if (os.prev_state)
                     {
-                        os.prev_state->add_continuation(
-                            PIKA_MOVE(continuation));
+                        os.prev_state->add_continuation(&os);
 
                         // We release prev_state here to allow continuations to
                         // run. The operation state may otherwise keep it alive
@@ -493,7 +545,7 @@ namespace pika { namespace experimental {
                     {
                         // There is no previous state on the first access. We
                         // can immediately trigger the continuation.
-                        continuation(PIKA_MOVE(os.state));
+                        os.continuation(PIKA_MOVE(os.state));
                     }
                 }
             };
@@ -507,7 +559,9 @@ namespace pika { namespace experimental {
             }
         };
 
-        allocator_type alloc;
+        // Shared states are allocated for every access. They are recycled
+        // through a per-thread cache to avoid going to the allocator.
+        pika::detail::thread_local_caching_allocator<allocator_type> alloc;
 
         detail::async_rw_mutex_access_type prev_access =
             detail::async_rw_mutex_access_type::readwrite;
@@ -563,8 +617,7 @@ namespace pika { namespace experimental {
             if (prev_access == detail::async_rw_mutex_access_type::readwrite)
             {
                 prev_state = PIKA_MOVE(state);
-                state = std::allocate_shared<shared_state_type, allocator_type>(
-                    alloc);
+                state = std::allocate_shared<shared_state_type>(alloc);
                 prev_access = detail::async_rw_mutex_access_type::read;
 
                 // Only the first access has no previous shared state. When
@@ -587,8 +640,7 @@ namespace pika { namespace experimental {
         sender<detail::async_rw_mutex_access_type::readwrite> readwrite()
         {
             prev_state = PIKA_MOVE(state);
-            state =
-                std::allocate_shared<shared_state_type, allocator_type>(alloc);
+            state = std::allocate_shared<shared_state_type>(alloc);
 
             // Only the first access has no previous shared state. When there is
             // a previous state we set the next state so that the value can be
@@ -631,6 +683,7 @@ namespace pika { namespace experimental {
 
             template <typename R>
             struct operation_state
+              : detail::async_rw_mutex_operation_state_base<readwrite_type>
             {
                 std::decay_t<R> r;
                 shared_state_ptr_type prev_state;
@@ -650,6 +703,20 @@ namespace pika { namespace experimental {
                 operation_state(operation_state const&) = delete;
                 operation_state& operator=(operation_state const&) = delete;
 
+                void continuation(shared_state_ptr_type state) noexcept override
+                {
+                    try
+                    {
+                        pika::execution::experimental::set_value(
+                            PIKA_MOVE(r), access_type{PIKA_MOVE(state)});
+                    }
+                    catch (...)
+                    {
+                        pika::execution::experimental::set_error(
+                            PIKA_MOVE(r), std::current_exception());
+                    }
+                }
+
                 friend void tag_invoke(pika::execution::experimental::start_t,
                     operation_state& os) noexcept
                 {
@@ -657,26 +724,9 @@ namespace pika { namespace experimental {
                         "async_rw_lock::sender::operation_state state is "
                         "empty, was the sender already started?");
 
-                    auto continuation =
-                        [r = PIKA_MOVE(os.r)](
-                            shared_state_ptr_type state) mutable {
-                            try
-                            {
-                                pika::execution::experimental::set_value(
-                                    PIKA_MOVE(r),
-                                    access_type{PIKA_MOVE(state)});
-                            }
-                            catch (...)
-                            {
-                                pika::execution::experimental::set_error(
-                                    PIKA_MOVE(r), std::current_exception());
-                            }
-                        };
-
                     if (os.prev_state)
                     {
-                        os.prev_state->add_continuation(
-                            PIKA_MOVE(continuation));
+                        os.prev_state->add_continuation(&os);
                         // We release prev_state here to allow continuations to
                         // run. The operation state may otherwise keep it alive
                         // longer than needed.
@@ -686,7 +736,7 @@ namespace pika { namespace experimental {
                     {
                         // There is no previous state on the first access. We
                         // can immediately trigger the continuation.
-                        continuation(PIKA_MOVE(os.state));
+                        os.continuation(PIKA_MOVE(os.state));
                     }
                 }
             };
@@ -701,7 +751,9 @@ namespace pika { namespace experimental {
         };
 
         value_type value;
-        allocator_type alloc;
+        // Shared states are allocated for every access. They are recycled
+        // through a per-thread cache to avoid going to the allocator.
+        pika::detail::thread_local_caching_allocator<allocator_type> alloc;
 
         detail::async_rw_mutex_access_type prev_access =
             detail::async_rw_mutex_access_type::readwrite;
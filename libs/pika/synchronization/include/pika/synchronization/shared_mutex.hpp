@@ -8,10 +8,18 @@
 #pragma once
 
 #include <pika/config.hpp>
+#include <pika/concurrency/cache_line_data.hpp>
+#include <pika/execution_base/this_thread.hpp>
 #include <pika/synchronization/condition_variable.hpp>
 #include <pika/synchronization/mutex.hpp>
+#include <pika/threading_base/thread_num_tss.hpp>
+#include <pika/topology/topology.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <mutex>
+#include <vector>
 
 namespace pika { namespace lcos { namespace local {
     namespace detail {
@@ -232,7 +240,123 @@ namespace pika { namespace lcos { namespace local {
                 release_waiters();
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // A shared mutex biased towards readers. Instead of a single reader
+        // count protected by a mutex, each worker thread has its own reader
+        // count on a separate cache line, which makes acquiring and releasing
+        // a shared lock a single atomic operation on a cache line that is
+        // normally not touched by other threads. Writers exclude each other
+        // using a mutex, announce themselves to new readers, and wait for the
+        // readers holding a shared lock to drain by summing up all counts,
+        // which makes exclusive locking more expensive than for shared_mutex.
+        //
+        // A pika thread may be resumed on a different worker thread than the
+        // one it acquired its shared lock on, the counts are therefore signed
+        // and only their sum is meaningful. Threads not managed by pika share
+        // the counts of the worker threads. Upgrade locks are not supported.
+        template <typename Mutex = lcos::local::mutex>
+        class reader_biased_shared_mutex
+        {
+        private:
+            using mutex_type = Mutex;
+            using count_type = std::atomic<std::ptrdiff_t>;
+
+            count_type& reader_count() noexcept
+            {
+                return reader_counts_[pika::get_worker_thread_num() %
+                    reader_counts_.size()]
+                    .data_;
+            }
+
+            bool has_readers() const noexcept
+            {
+                std::ptrdiff_t readers = 0;
+                for (auto const& count : reader_counts_)
+                {
+                    readers += count.data_.load(std::memory_order_seq_cst);
+                }
+                return readers != 0;
+            }
+
+        public:
+            reader_biased_shared_mutex()
+              : reader_counts_(
+                    (std::max)(pika::threads::hardware_concurrency(), 1u))
+              , writer_()
+            {
+            }
+
+            reader_biased_shared_mutex(
+                reader_biased_shared_mutex const&) = delete;
+            reader_biased_shared_mutex& operator=(
+                reader_biased_shared_mutex const&) = delete;
+
+            void lock_shared()
+            {
+                if (try_lock_shared())
+                    return;
+
+                // a writer holds state_change as long as it owns the mutex
+                std::lock_guard<mutex_type> l(state_change);
+                reader_count().fetch_add(1, std::memory_order_relaxed);
+            }
+
+            bool try_lock_shared()
+            {
+                // the increment has to be visible to writers before the flag
+                // is checked, which requires sequential consistency for both
+                count_type& count = reader_count();
+                count.fetch_add(1, std::memory_order_seq_cst);
+                if (!writer_.data_.load(std::memory_order_seq_cst))
+                    return true;
+
+                count.fetch_sub(1, std::memory_order_release);
+                return false;
+            }
+
+            void unlock_shared()
+            {
+                reader_count().fetch_sub(1, std::memory_order_release);
+            }
+
+            void lock()
+            {
+                state_change.lock();
+                writer_.data_.store(true, std::memory_order_seq_cst);
+
+                util::yield_while([this] { return has_readers(); },
+                    "pika::lcos::local::reader_biased_shared_mutex::lock");
+            }
+
+            bool try_lock()
+            {
+                if (!state_change.try_lock())
+                    return false;
+
+                writer_.data_.store(true, std::memory_order_seq_cst);
+                if (has_readers())
+                {
+                    writer_.data_.store(false, std::memory_order_relaxed);
+                    state_change.unlock();
+                    return false;
+                }
+                return true;
+            }
+
+            void unlock()
+            {
+                writer_.data_.store(false, std::memory_order_release);
+                state_change.unlock();
+            }
+
+        private:
+            std::vector<util::cache_line_data<count_type>> reader_counts_;
+            util::cache_line_data<std::atomic<bool>> writer_;
+            mutex_type state_change;
+        };
     }    // namespace detail
 
     typedef detail::shared_mutex<> shared_mutex;
+    typedef detail::reader_biased_shared_mutex<> reader_biased_shared_mutex;
 }}}    // namespace pika::lcos::local
@@ -0,0 +1,200 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overhead of chains of accesses to an
+// async_rw_mutex, and counts the number of memory allocations made by the
+// mutex itself per access (using a counting allocator). The chains are
+//
+//   readwrite:  write-after-write
+//   read:       read-after-read (a single write followed by reads)
+//   mixed:      write-after-read (three reads followed by a write)
+
+#include <pika/execution.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/format.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/modules/timing.hpp>
+#include <pika/synchronization/async_rw_mutex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace ex = pika::execution::experimental;
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::int64_t> num_allocations{0};
+
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    counting_allocator() = default;
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        ++num_allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    friend bool operator==(
+        counting_allocator const&, counting_allocator const&) noexcept
+    {
+        return true;
+    }
+
+    friend bool operator!=(
+        counting_allocator const&, counting_allocator const&) noexcept
+    {
+        return false;
+    }
+};
+
+using mutex_type =
+    pika::experimental::async_rw_mutex<std::size_t, std::size_t const,
+        counting_allocator<char>>;
+
+///////////////////////////////////////////////////////////////////////////////
+enum class chain
+{
+    readwrite,
+    read,
+    mixed
+};
+
+char const* get_name(chain c)
+{
+    switch (c)
+    {
+    case chain::readwrite:
+        return "readwrite";
+    case chain::read:
+        return "read";
+    case chain::mixed:
+        return "mixed";
+    }
+    return "unknown";
+}
+
+template <typename Sender>
+void access(Sender&& sender)
+{
+    ex::start_detached(
+        PIKA_FORWARD(Sender, sender) | ex::then([](auto&&) {}));
+}
+
+// Returns the time per access (in seconds) and the number of allocations made
+// by the mutex per access
+std::pair<double, double> run(chain c, std::size_t num_accesses)
+{
+    mutex_type mtx{0};
+
+    // warm up the caches of the mutex
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        access(mtx.readwrite());
+    }
+
+    std::int64_t const allocations_before = num_allocations;
+    pika::chrono::high_resolution_timer t;
+
+    switch (c)
+    {
+    case chain::readwrite:
+        for (std::size_t i = 0; i != num_accesses; ++i)
+        {
+            access(mtx.readwrite());
+        }
+        break;
+    case chain::read:
+        for (std::size_t i = 0; i != num_accesses; ++i)
+        {
+            access(mtx.read());
+        }
+        break;
+    case chain::mixed:
+        for (std::size_t i = 0; i != num_accesses; ++i)
+        {
+            if (i % 4 == 3)
+            {
+                access(mtx.readwrite());
+            }
+            else
+            {
+                access(mtx.read());
+            }
+        }
+        break;
+    }
+
+    // wait for all accesses to finish
+    ex::sync_wait(mtx.readwrite());
+
+    double const elapsed = t.elapsed();
+    std::int64_t const allocations = num_allocations - allocations_before;
+
+    return {elapsed / double(num_accesses),
+        double(allocations) / double(num_accesses)};
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    std::size_t const num_accesses = vm["accesses"].as<std::size_t>();
+
+    std::cout << "Chain,Accesses,Time/Access[s],Allocations/Access"
+              << std::endl;
+
+    for (chain c : {chain::readwrite, chain::read, chain::mixed})
+    {
+        auto const result = run(c, num_accesses);
+
+        pika::util::format_to(std::cout, "{:10},{:10},{:10.12},{:10.4}\n",
+            get_name(c), num_accesses, result.first, result.second)
+            << std::flush;
+
+        pika::util::print_cdash_timing(
+            (std::string("AsyncRWMutexOverhead_") + get_name(c)).c_str(),
+            result.first);
+    }
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = pika::program_options;
+
+    po::options_description cmdline(
+        "usage: " PIKA_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("accesses", po::value<std::size_t>()->default_value(1000000),
+         "number of accesses in each chain (default: 1000000)");
+    // clang-format on
+
+    pika::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    return pika::init(pika_main, argc, argv, init_args);
+}
@@ -0,0 +1,129 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time per lock acquisition of shared_mutex and
+// reader_biased_shared_mutex for a range of read percentages. Each run uses
+// a number of concurrent workers (pika threads) which take turns at
+// acquiring the mutex, the number of workers is doubled from one to the
+// number of worker threads (as given by --pika:threads), but to at most
+// --max-workers.
+
+#include <pika/future.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/format.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/modules/timing.hpp>
+#include <pika/runtime.hpp>
+#include <pika/shared_mutex.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the time per lock acquisition (in seconds)
+template <typename Mutex>
+double run(std::size_t num_workers, std::size_t read_percentage,
+    std::size_t num_accesses)
+{
+    Mutex mtx;
+    std::uint64_t value = 0;
+
+    pika::chrono::high_resolution_timer t;
+
+    std::vector<pika::future<std::uint64_t>> workers;
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i != num_workers; ++i)
+    {
+        workers.push_back(pika::async([&, i]() {
+            std::uint64_t sum = 0;
+            for (std::size_t j = 0; j != num_accesses; ++j)
+            {
+                // spread the writes evenly over the accesses
+                if ((i + j) % 100 >= read_percentage)
+                {
+                    std::unique_lock<Mutex> l(mtx);
+                    ++value;
+                }
+                else
+                {
+                    std::shared_lock<Mutex> l(mtx);
+                    sum += value;
+                }
+            }
+            return sum;
+        }));
+    }
+    pika::wait_all(workers);
+
+    return t.elapsed() / double(num_workers * num_accesses);
+}
+
+template <typename Mutex>
+void run_all(char const* name, std::size_t max_workers,
+    std::size_t num_accesses)
+{
+    for (std::size_t read_percentage : {100, 99, 90, 50})
+    {
+        for (std::size_t num_workers = 1; num_workers <= max_workers;
+             num_workers *= 2)
+        {
+            double const result =
+                run<Mutex>(num_workers, read_percentage, num_accesses);
+
+            pika::util::format_to(std::cout, "{:27},{:5},{:5},{:10.12}\n",
+                name, read_percentage, num_workers, result)
+                << std::flush;
+
+            pika::util::print_cdash_timing(
+                pika::util::format("SharedMutexOverhead_{}_{}_{}", name,
+                    read_percentage, num_workers)
+                    .c_str(),
+                result);
+        }
+    }
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    std::size_t const num_accesses = vm["accesses"].as<std::size_t>();
+    std::size_t const max_workers = (std::min)(
+        vm["max-workers"].as<std::size_t>(), pika::get_num_worker_threads());
+
+    std::cout << "Mutex,Reads[%],Workers,Time/Access[s]" << std::endl;
+
+    run_all<pika::shared_mutex>("shared_mutex", max_workers, num_accesses);
+    run_all<pika::reader_biased_shared_mutex>(
+        "reader_biased_shared_mutex", max_workers, num_accesses);
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = pika::program_options;
+
+    po::options_description cmdline(
+        "usage: " PIKA_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("accesses", po::value<std::size_t>()->default_value(100000),
+         "number of lock acquisitions per worker (default: 100000)")
+        ("max-workers", po::value<std::size_t>()->default_value(128),
+         "largest number of concurrent workers (default: 128)");
+    // clang-format on
+
+    pika::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    return pika::init(pika_main, argc, argv, init_args);
+}
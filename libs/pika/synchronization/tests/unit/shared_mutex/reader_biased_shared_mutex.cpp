@@ -0,0 +1,145 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/future.hpp>
+#include <pika/init.hpp>
+#include <pika/shared_mutex.hpp>
+#include <pika/thread.hpp>
+
+#include <pika/modules/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+using shared_mutex_type = pika::reader_biased_shared_mutex;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_multiple_readers()
+{
+    std::size_t const number_of_threads = 10;
+
+    shared_mutex_type rw_mutex;
+    std::atomic<std::size_t> running(0);
+
+    std::vector<pika::future<void>> readers;
+    for (std::size_t i = 0; i != number_of_threads; ++i)
+    {
+        readers.push_back(pika::async([&]() {
+            std::shared_lock<shared_mutex_type> l(rw_mutex);
+
+            // all readers have to hold the lock at the same time
+            ++running;
+            while (running != number_of_threads)
+            {
+                pika::this_thread::yield();
+            }
+        }));
+    }
+
+    pika::wait_all(readers);
+    PIKA_TEST_EQ(running.load(), number_of_threads);
+}
+
+void test_writer_excludes_readers_and_writers()
+{
+    shared_mutex_type rw_mutex;
+
+    {
+        std::shared_lock<shared_mutex_type> l(rw_mutex);
+        PIKA_TEST(!pika::async([&]() { return rw_mutex.try_lock(); }).get());
+        PIKA_TEST(
+            pika::async([&]() { return rw_mutex.try_lock_shared(); }).get());
+        rw_mutex.unlock_shared();
+    }
+
+    {
+        std::unique_lock<shared_mutex_type> l(rw_mutex);
+        PIKA_TEST(!pika::async([&]() { return rw_mutex.try_lock(); }).get());
+        PIKA_TEST(
+            !pika::async([&]() { return rw_mutex.try_lock_shared(); }).get());
+    }
+
+    PIKA_TEST(rw_mutex.try_lock());
+    rw_mutex.unlock();
+}
+
+void test_readers_see_consistent_writes()
+{
+    std::size_t const number_of_threads = 16;
+    std::size_t const iterations = 10000;
+
+    shared_mutex_type rw_mutex;
+
+    // both values are only modified together under the exclusive lock
+    std::size_t first = 0;
+    std::size_t second = 0;
+    std::atomic<std::size_t> inconsistent(0);
+
+    std::vector<pika::future<void>> threads;
+    for (std::size_t i = 0; i != number_of_threads; ++i)
+    {
+        threads.push_back(pika::async([&, i]() {
+            for (std::size_t j = 0; j != iterations; ++j)
+            {
+                if ((i + j) % 16 == 0)
+                {
+                    std::unique_lock<shared_mutex_type> l(rw_mutex);
+                    ++first;
+                    pika::this_thread::yield();
+                    ++second;
+                }
+                else
+                {
+                    std::shared_lock<shared_mutex_type> l(rw_mutex);
+                    if (first != second)
+                    {
+                        ++inconsistent;
+                    }
+                }
+
+                if (j % 64 == 0)
+                {
+                    pika::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    pika::wait_all(threads);
+
+    PIKA_TEST_EQ(inconsistent.load(), std::size_t(0));
+    PIKA_TEST_EQ(first, number_of_threads * iterations / 16);
+    PIKA_TEST_EQ(second, first);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int pika_main()
+{
+    test_multiple_readers();
+    test_writer_excludes_readers_and_writers();
+    test_readers_see_consistent_writes();
+
+    return pika::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"pika.os_threads=all"};
+
+    // Initialize and run pika
+    pika::init_params init_args;
+    init_args.cfg = cfg;
+    PIKA_TEST_EQ_MSG(pika::init(pika_main, argc, argv, init_args), 0,
+        "pika main exited with non-zero status");
+
+    return pika::util::report_errors();
+}
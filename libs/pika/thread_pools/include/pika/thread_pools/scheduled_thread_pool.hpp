@@ -213,6 +213,23 @@ namespace pika { namespace threads { namespace detail {
         {
             return sched_->Scheduler::get_num_stolen_to_staged(num, reset);
         }
+
+        std::int64_t get_num_steal_attempts(
+            std::size_t num, bool reset) override
+        {
+            return sched_->Scheduler::get_num_steal_attempts(num, reset);
+        }
+
+        std::int64_t get_num_failed_steals(
+            std::size_t num, bool reset) override
+        {
+            return sched_->Scheduler::get_num_failed_steals(num, reset);
+        }
+
+        std::int64_t get_steal_time(std::size_t num, bool reset) override
+        {
+            return sched_->Scheduler::get_steal_time(num, reset);
+        }
 #endif
         std::int64_t get_queue_length(
             std::size_t num_thread, bool /* reset */) override
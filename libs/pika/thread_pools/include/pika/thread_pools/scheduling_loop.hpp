@@ -892,6 +892,8 @@ namespace pika { namespace threads { namespace detail {
                         scheduler.SchedulingPolicy::cleanup_terminated(
                             num_thread, true) &&
                         scheduler.SchedulingPolicy::get_queue_length(
+                            num_thread) == 0 &&
+                        scheduler.SchedulingPolicy::get_timer_count(
                             num_thread) == 0;
 
                     if (this_state.load() == state_pre_sleep)
@@ -1004,6 +1006,13 @@ namespace pika { namespace threads { namespace detail {
                 idle_loop_count = 0;
             }
 
+            // wake up pika threads whose timed suspension has expired
+            if (scheduler.SchedulingPolicy::poll_timers(num_thread) ==
+                policies::detail::polling_status::busy)
+            {
+                idle_loop_count = 0;
+            }
+
             // something went badly wrong, give up
             if (PIKA_UNLIKELY(this_state.load() == state_terminating))
                 break;
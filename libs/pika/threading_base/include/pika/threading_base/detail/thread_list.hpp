@@ -0,0 +1,168 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/assert.hpp>
+#include <pika/threading_base/thread_data.hpp>
+#include <pika/threading_base/threading_base_fwd.hpp>
+
+#include <cstddef>
+#include <iterator>
+
+namespace pika { namespace threads { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An intrusive doubly linked list of threads, used by the thread queues
+    /// to keep track of all threads they own. Threads are linked through the
+    /// hook embedded in thread_data, so neither inserting nor erasing a
+    /// thread allocates memory or hashes the thread id.
+    ///
+    /// The list itself is not thread-safe, synchronization is left to the
+    /// owner (see thread_queue).
+    class thread_list
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = thread_id_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = thread_id_type;
+
+            const_iterator() noexcept = default;
+
+            explicit const_iterator(thread_data* thrd) noexcept
+              : thrd_(thrd)
+            {
+            }
+
+            thread_id_type operator*() const noexcept
+            {
+                PIKA_ASSERT(thrd_ != nullptr);
+                return thread_id_type(thrd_);
+            }
+
+            const_iterator& operator++() noexcept
+            {
+                PIKA_ASSERT(thrd_ != nullptr);
+                thrd_ = thrd_->get_list_hook().next_;
+                return *this;
+            }
+
+            const_iterator operator++(int) noexcept
+            {
+                const_iterator tmp(*this);
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(
+                const_iterator const& lhs, const_iterator const& rhs) noexcept
+            {
+                return lhs.thrd_ == rhs.thrd_;
+            }
+
+            friend bool operator!=(
+                const_iterator const& lhs, const_iterator const& rhs) noexcept
+            {
+                return lhs.thrd_ != rhs.thrd_;
+            }
+
+        private:
+            thread_data* thrd_ = nullptr;
+        };
+
+        using iterator = const_iterator;
+
+        thread_list() noexcept = default;
+
+        thread_list(thread_list const&) = delete;
+        thread_list& operator=(thread_list const&) = delete;
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(head_);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator();
+        }
+
+        /// Return whether the given thread is linked into this list
+        bool contains(thread_id_type const& id) const noexcept
+        {
+            thread_data* thrd = get_thread_id_data(id);
+            return thrd == head_ || thrd->get_list_hook().prev_ != nullptr;
+        }
+
+        /// Add the given thread to the front of the list
+        void insert(thread_id_type const& id) noexcept
+        {
+            thread_data* thrd = get_thread_id_data(id);
+            thread_list_hook& hook = thrd->get_list_hook();
+            PIKA_ASSERT(!contains(id));
+
+            hook.prev_ = nullptr;
+            hook.next_ = head_;
+            if (head_ != nullptr)
+            {
+                head_->get_list_hook().prev_ = thrd;
+            }
+            head_ = thrd;
+            ++size_;
+        }
+
+        /// Remove the given thread from the list, returns false if the thread
+        /// was not linked into it
+        bool erase(thread_id_type const& id) noexcept
+        {
+            if (!contains(id))
+            {
+                return false;
+            }
+
+            thread_data* thrd = get_thread_id_data(id);
+            thread_list_hook& hook = thrd->get_list_hook();
+
+            if (hook.prev_ != nullptr)
+            {
+                hook.prev_->get_list_hook().next_ = hook.next_;
+            }
+            else
+            {
+                head_ = hook.next_;
+            }
+            if (hook.next_ != nullptr)
+            {
+                hook.next_->get_list_hook().prev_ = hook.prev_;
+            }
+
+            hook.next_ = nullptr;
+            hook.prev_ = nullptr;
+            --size_;
+            return true;
+        }
+
+    private:
+        thread_data* head_ = nullptr;
+        std::size_t size_ = 0;
+    };
+}}}    // namespace pika::threads::detail
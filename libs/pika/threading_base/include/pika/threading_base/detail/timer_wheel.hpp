@@ -0,0 +1,406 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <pika/config.hpp>
+#include <pika/assert.hpp>
+#include <pika/threading_base/thread_data.hpp>
+#include <pika/threading_base/threading_base_fwd.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(PIKA_MSVC)
+#include <intrin.h>
+#endif
+
+namespace pika { namespace threads { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A timer_entry describes an action to perform once the given deadline
+    /// has expired: either a pika thread is set back to pending or a callback
+    /// is invoked. Entries are intrusively linked into a timer_wheel, no
+    /// memory is allocated while the entry is armed. The entry has to outlive
+    /// its registration, i.e. it has to be either expired or canceled before
+    /// it is destroyed.
+    struct timer_entry
+    {
+        using callback_type = void (*)(timer_entry&) noexcept;
+
+        // set the given thread to pending once the deadline has expired
+        timer_entry(thread_id_ref_type thrd,
+            std::chrono::steady_clock::time_point deadline,
+            thread_priority priority, bool retry_on_active) noexcept
+          : thrd_(PIKA_MOVE(thrd))
+          , deadline_(deadline)
+          , priority_(priority)
+          , retry_on_active_(retry_on_active)
+        {
+        }
+
+        // invoke the given callback once the deadline has expired, the
+        // callback is invoked on the worker thread polling the timer wheel
+        timer_entry(std::chrono::steady_clock::time_point deadline,
+            callback_type callback) noexcept
+          : deadline_(deadline)
+          , priority_(thread_priority::normal)
+          , retry_on_active_(false)
+          , callback_(callback)
+        {
+        }
+
+        PIKA_NON_COPYABLE(timer_entry);
+
+        bool is_linked() const noexcept
+        {
+            return prev_ != nullptr;
+        }
+
+        thread_id_ref_type thrd_;
+        std::chrono::steady_clock::time_point deadline_;
+        thread_priority priority_;
+        bool retry_on_active_;
+        callback_type callback_ = nullptr;
+
+        // managed by the timer_wheel
+        timer_entry* next_ = nullptr;
+        timer_entry** prev_ = nullptr;
+        std::uint64_t tick_ = 0;
+        std::size_t worker_ = 0;
+        std::uint8_t level_ = 0;
+        std::uint8_t slot_ = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A hierarchical timer wheel (Varghese & Lauck). Each level consists of
+    /// 64 slots, level N covers 64^(N+1) ticks. An entry is stored on the
+    /// lowest level whose slot range still shares its upper bits with the
+    /// current tick. Once the current tick reaches the start of a slot on a
+    /// higher level that slot is cascaded down. Occupancy bitmaps allow
+    /// skipping empty slots, so advancing the wheel over long idle periods
+    /// costs at most one step per occupied slot.
+    ///
+    /// The wheel itself is not thread-safe, synchronization is left to the
+    /// owner (see scheduler_base).
+    class timer_wheel
+    {
+    public:
+        // the resolution of the timer wheel
+        using tick_duration = std::chrono::microseconds;
+
+        static constexpr std::size_t slot_bits = 6;
+        static constexpr std::size_t num_slots = std::size_t(1) << slot_bits;
+        static constexpr std::uint64_t slot_mask = num_slots - 1;
+        static constexpr std::size_t num_levels = 10;
+
+        // largest distance (in ticks) a deadline can be in the future
+        static constexpr std::uint64_t max_ticks =
+            (std::uint64_t(1) << (slot_bits * num_levels)) - 1;
+
+        explicit timer_wheel(std::chrono::steady_clock::time_point now =
+                                 std::chrono::steady_clock::now()) noexcept
+          : current_(to_ticks(now))
+        {
+            for (std::size_t level = 0; level != num_levels; ++level)
+            {
+                occupied_[level] = 0;
+                for (std::size_t slot = 0; slot != num_slots; ++slot)
+                {
+                    slots_[level][slot] = nullptr;
+                }
+            }
+        }
+
+        PIKA_NON_COPYABLE(timer_wheel);
+
+        static std::uint64_t to_ticks(
+            std::chrono::steady_clock::time_point t) noexcept
+        {
+            auto ticks = std::chrono::duration_cast<tick_duration>(
+                t.time_since_epoch())
+                             .count();
+            return ticks < 0 ? 0 : std::uint64_t(ticks);
+        }
+
+        // deadlines are rounded up to make sure no timer fires early
+        static std::uint64_t to_ticks_ceil(
+            std::chrono::steady_clock::time_point t) noexcept
+        {
+            std::uint64_t ticks = to_ticks(t);
+            if (from_ticks(ticks) < t)
+            {
+                ++ticks;
+            }
+            return ticks;
+        }
+
+        static std::chrono::steady_clock::time_point from_ticks(
+            std::uint64_t ticks) noexcept
+        {
+            return std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<
+                    std::chrono::steady_clock::duration>(tick_duration(
+                    std::int64_t((std::min)(ticks, std::uint64_t(
+                        (std::numeric_limits<std::int64_t>::max)()))))));
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// Register the given entry with the timer wheel
+        void insert(timer_entry& e) noexcept
+        {
+            PIKA_ASSERT(!e.is_linked());
+
+            std::uint64_t tick = to_ticks_ceil(e.deadline_);
+            if (tick > current_ + max_ticks)
+            {
+                tick = current_ + max_ticks;
+            }
+            e.tick_ = tick;
+
+            link(e);
+            ++size_;
+        }
+
+        /// Remove the given entry from the timer wheel, returns false if the
+        /// entry was not registered (anymore)
+        bool remove(timer_entry& e) noexcept
+        {
+            if (!e.is_linked())
+            {
+                return false;
+            }
+
+            unlink(e);
+            --size_;
+            return true;
+        }
+
+        /// Advance the wheel up to (and including) the given point in time.
+        /// The function f is invoked for each expired entry after it was
+        /// removed from the wheel. Returns the number of expired entries.
+        template <typename F>
+        std::size_t advance(
+            std::chrono::steady_clock::time_point now_time, F&& f)
+        {
+            std::uint64_t const now = to_ticks(now_time);
+            if (now < current_)
+            {
+                return 0;
+            }
+
+            std::size_t expired = 0;
+
+            while (size_ != 0)
+            {
+                // expire everything that is due in the current level-0 range
+                std::uint64_t const end = (std::min)(now, current_ | slot_mask);
+                expired += expire(current_ & slot_mask, end & slot_mask, f);
+
+                if (end == now)
+                {
+                    break;
+                }
+
+                // level 0 is now empty, skip to the next slot on a higher
+                // level which has to be cascaded
+                std::uint64_t const next = next_cascade_tick();
+                if (next > now)
+                {
+                    break;
+                }
+
+                current_ = next;
+                cascade();
+            }
+
+            if (current_ < now)
+            {
+                current_ = now;
+            }
+            return expired;
+        }
+
+        /// Return a lower bound for the point in time the next entry will
+        /// expire at
+        std::chrono::steady_clock::time_point next_expiry() const noexcept
+        {
+            if (size_ == 0)
+            {
+                return (std::chrono::steady_clock::time_point::max)();
+            }
+
+            std::uint64_t const current_slot = current_ & slot_mask;
+            std::uint64_t const pending =
+                occupied_[0] & (~std::uint64_t(0) << current_slot);
+            if (pending != 0)
+            {
+                return from_ticks(
+                    (current_ & ~slot_mask) | std::uint64_t(ffs(pending)));
+            }
+            return from_ticks(next_cascade_tick());
+        }
+
+    private:
+        static int ffs(std::uint64_t v) noexcept
+        {
+            PIKA_ASSERT(v != 0);
+#if defined(PIKA_MSVC)
+            unsigned long index = 0;
+            _BitScanForward64(&index, v);
+            return int(index);
+#else
+            return __builtin_ctzll(v);
+#endif
+        }
+
+        void link(timer_entry& e) noexcept
+        {
+            // find the lowest level which shares the upper bits with the
+            // current tick, entries that are already due end up in the
+            // current level-0 slot
+            std::size_t level = 0;
+            std::uint64_t slot = current_ & slot_mask;
+            if (e.tick_ > current_)
+            {
+                while (level != num_levels - 1 &&
+                    (e.tick_ >> (slot_bits * (level + 1))) !=
+                        (current_ >> (slot_bits * (level + 1))))
+                {
+                    ++level;
+                }
+                slot = (e.tick_ >> (slot_bits * level)) & slot_mask;
+            }
+
+            e.level_ = std::uint8_t(level);
+            e.slot_ = std::uint8_t(slot);
+
+            timer_entry*& head = slots_[level][slot];
+            e.next_ = head;
+            e.prev_ = &head;
+            if (head != nullptr)
+            {
+                head->prev_ = &e.next_;
+            }
+            head = &e;
+            occupied_[level] |= std::uint64_t(1) << slot;
+        }
+
+        void unlink(timer_entry& e) noexcept
+        {
+            PIKA_ASSERT(e.is_linked());
+
+            *e.prev_ = e.next_;
+            if (e.next_ != nullptr)
+            {
+                e.next_->prev_ = e.prev_;
+            }
+            if (slots_[e.level_][e.slot_] == nullptr)
+            {
+                occupied_[e.level_] &= ~(std::uint64_t(1) << e.slot_);
+            }
+            e.next_ = nullptr;
+            e.prev_ = nullptr;
+        }
+
+        template <typename F>
+        std::size_t expire(std::uint64_t first, std::uint64_t last, F& f)
+        {
+            std::size_t expired = 0;
+
+            std::uint64_t mask = (~std::uint64_t(0) << first) &
+                (~std::uint64_t(0) >> (slot_mask - last));
+            std::uint64_t pending = occupied_[0] & mask;
+            while (pending != 0)
+            {
+                int const slot = ffs(pending);
+                pending &= pending - 1;
+
+                timer_entry* e = slots_[0][slot];
+                slots_[0][slot] = nullptr;
+                occupied_[0] &= ~(std::uint64_t(1) << slot);
+
+                while (e != nullptr)
+                {
+                    timer_entry* next = e->next_;
+                    e->next_ = nullptr;
+                    e->prev_ = nullptr;
+                    --size_;
+                    ++expired;
+
+                    f(*e);
+                    e = next;
+                }
+            }
+            return expired;
+        }
+
+        // Find the first tick beyond the current level-0 range at which a
+        // slot on a higher level has to be cascaded.
+        std::uint64_t next_cascade_tick() const noexcept
+        {
+            for (std::size_t level = 1; level != num_levels; ++level)
+            {
+                std::size_t const shift = slot_bits * level;
+                std::uint64_t const slot = (current_ >> shift) & slot_mask;
+                std::uint64_t const pending = slot == slot_mask ?
+                    0 :
+                    occupied_[level] & (~std::uint64_t(0) << (slot + 1));
+                if (pending != 0)
+                {
+                    std::size_t const upper = shift + slot_bits;
+                    return ((current_ >> upper) << upper) |
+                        (std::uint64_t(ffs(pending)) << shift);
+                }
+            }
+            return (std::numeric_limits<std::uint64_t>::max)();
+        }
+
+        // Redistribute all entries of the slots which start at the current
+        // tick to lower levels.
+        void cascade() noexcept
+        {
+            for (std::size_t level = 1; level != num_levels; ++level)
+            {
+                std::size_t const shift = slot_bits * level;
+                if ((current_ & ((std::uint64_t(1) << shift) - 1)) != 0)
+                {
+                    break;
+                }
+
+                std::uint64_t const slot = (current_ >> shift) & slot_mask;
+                timer_entry* e = slots_[level][slot];
+                slots_[level][slot] = nullptr;
+                occupied_[level] &= ~(std::uint64_t(1) << slot);
+
+                while (e != nullptr)
+                {
+                    timer_entry* next = e->next_;
+                    e->next_ = nullptr;
+                    e->prev_ = nullptr;
+                    link(*e);
+                    e = next;
+                }
+            }
+        }
+
+        std::uint64_t current_;
+        std::size_t size_ = 0;
+        std::uint64_t occupied_[num_levels];
+        timer_entry* slots_[num_levels][num_slots];
+    };
+}}}    // namespace pika::threads::detail
@@ -12,6 +12,8 @@
 #include <pika/functional/function.hpp>
 #include <pika/modules/errors.hpp>
 #include <pika/modules/format.hpp>
+#include <pika/thread_support/spinlock.hpp>
+#include <pika/threading_base/detail/timer_wheel.hpp>
 #include <pika/threading_base/scheduler_mode.hpp>
 #include <pika/threading_base/scheduler_state.hpp>
 #include <pika/threading_base/thread_data.hpp>
@@ -24,6 +26,7 @@
 #endif
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
@@ -96,13 +99,52 @@ namespace pika { namespace threads { namespace policies {
         void idle_callback(std::size_t num_thread);
 
         /// This function gets called by the thread-manager whenever new work
-        /// has been added, allowing the scheduler to reactivate one or more of
-        /// possibly idling OS threads
-        void do_some_work(std::size_t);
+        /// has been added, allowing the scheduler to reactivate one of the
+        /// possibly idling OS threads. The sleeping worker closest to the
+        /// given one is woken up, passing std::size_t(-1) wakes up all of
+        /// them.
+        void do_some_work(std::size_t num_thread);
+
+        /// Return the number of times the given worker thread (or all of
+        /// them for std::size_t(-1)) was woken up from idle backoff by
+        /// do_some_work.
+        std::int64_t get_idle_wakeup_count(
+            std::size_t num_thread, bool reset = false);
 
         virtual void suspend(std::size_t num_thread);
         virtual void resume(std::size_t num_thread);
 
+        ///////////////////////////////////////////////////////////////////////
+        // support for timed suspension of pika threads
+
+        /// Register the given timer entry with the timer wheel of the given
+        /// worker thread. Once the deadline of the entry has expired the
+        /// associated pika thread is set to pending (with
+        /// thread_restart_state::timeout).
+        void add_timer(
+            std::size_t num_thread, threads::detail::timer_entry& entry);
+
+        /// Remove the given timer entry from its timer wheel, returns false
+        /// if the timer has already expired
+        bool cancel_timer(threads::detail::timer_entry& entry);
+
+        /// Expire the timers of the given worker thread whose deadline has
+        /// passed, this function is invoked from the scheduling loop
+        detail::polling_status poll_timers(std::size_t num_thread);
+
+        /// Return a lower bound for the deadline of the next timer registered
+        /// with the given worker thread
+        std::chrono::steady_clock::time_point get_next_timer_deadline(
+            std::size_t num_thread);
+
+        /// Return the number of timers registered with the given worker thread
+        std::size_t get_timer_count(std::size_t num_thread) const
+        {
+            PIKA_ASSERT(num_thread < timers_.size());
+            return timers_[num_thread].data_.count_.load(
+                std::memory_order_relaxed);
+        }
+
         std::size_t select_active_pu(std::unique_lock<pu_mutex_type>& l,
             std::size_t num_thread, bool allow_fallback = false);
 
@@ -188,6 +230,25 @@ namespace pika { namespace threads { namespace policies {
             std::size_t num_thread, bool reset) = 0;
         virtual std::int64_t get_num_stolen_to_staged(
             std::size_t num_thread, bool reset) = 0;
+
+        // The number of attempts to steal work, the number of those which
+        // didn't find any, and the time spent in them [ns]. Schedulers which
+        // don't keep track of their steal attempts report zero.
+        virtual std::int64_t get_num_steal_attempts(
+            std::size_t /* num_thread */, bool /* reset */)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_num_failed_steals(
+            std::size_t /* num_thread */, bool /* reset */)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_steal_time(
+            std::size_t /* num_thread */, bool /* reset */)
+        {
+            return 0;
+        }
 #endif
 
         virtual std::int64_t get_queue_length(
@@ -374,17 +435,49 @@ namespace pika { namespace threads { namespace policies {
         util::cache_line_data<std::atomic<scheduler_mode>> mode_;
 
 #if defined(PIKA_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-        // support for suspension on idle queues
-        pu_mutex_type mtx_;
-        std::condition_variable cond_;
+        // support for suspension on idle queues, every worker thread sleeps
+        // on its own condition variable such that new work wakes up only a
+        // single worker instead of all of them
         struct idle_backoff_data
         {
-            std::uint32_t wait_count_;
-            double max_idle_backoff_time_;
+            std::uint32_t wait_count_ = 0;
+            double max_idle_backoff_time_ = 0.0;
+
+            pu_mutex_type mtx_;
+            std::condition_variable cond_;
+            bool notified_ = false;
+            std::atomic<std::int64_t> wakeups_{0};
         };
         std::vector<util::cache_line_data<idle_backoff_data>> wait_counts_;
+
+        // one bit per sleeping worker thread, a set bit is claimed (cleared)
+        // by the thread waking the worker up
+        std::vector<util::cache_line_data<std::atomic<std::uint64_t>>>
+            idle_masks_;
+        std::atomic<std::size_t> next_wakeup_{0};
+
+        bool wake_idle_worker(std::size_t num_thread);
+        void wake_all_idle_workers();
 #endif
 
+        // support for timed suspension, one timer wheel per worker thread
+        struct expired_timer
+        {
+            thread_id_ref_type thrd_;
+            thread_priority priority_;
+            bool retry_on_active_;
+            threads::detail::timer_entry* entry_;
+        };
+
+        struct timer_queue
+        {
+            pika::util::detail::spinlock mtx_;
+            threads::detail::timer_wheel wheel_;
+            std::atomic<std::size_t> count_{0};
+            std::vector<expired_timer> expired_;
+        };
+        std::vector<util::cache_line_data<timer_queue>> timers_;
+
         // support for suspension of pus
         std::vector<pu_mutex_type> suspend_mtxs_;
         std::vector<std::condition_variable> suspend_conds_;
@@ -57,6 +57,17 @@ namespace pika { namespace threads {
     /// not a pika thread).
     PIKA_EXPORT thread_data* get_self_id_data();
 
+    namespace detail {
+        // Intrusive hook used by the thread queues to link all threads they
+        // own into a list (see detail::thread_list). The hook is protected by
+        // the mutex of the owning queue.
+        struct thread_list_hook
+        {
+            thread_data* next_ = nullptr;
+            thread_data* prev_ = nullptr;
+        };
+    }    // namespace detail
+
     ////////////////////////////////////////////////////////////////////////////
     /// A \a thread is the representation of a ParalleX thread. It's a first
     /// class object in ParalleX. In our implementation this is a user level
@@ -547,6 +558,11 @@ namespace pika { namespace threads {
             return *static_cast<ThreadQueue*>(queue_);
         }
 
+        detail::thread_list_hook& get_list_hook() noexcept
+        {
+            return list_hook_;
+        }
+
         /// \brief Execute the thread function
         ///
         /// \returns        This function returns the thread state the thread
@@ -657,6 +673,7 @@ namespace pika { namespace threads {
         thread_stacksize stacksize_enum_;
 
         void* queue_;
+        detail::thread_list_hook list_hook_;
 
     public:
 #if defined(PIKA_HAVE_APEX)
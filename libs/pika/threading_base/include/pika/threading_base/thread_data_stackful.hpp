@@ -9,7 +9,7 @@
 #pragma once
 
 #include <pika/config.hpp>
-#include <pika/allocator_support/internal_allocator.hpp>
+#include <pika/allocator_support/thread_local_pool_allocator.hpp>
 #include <pika/assert.hpp>
 #include <pika/coroutines/thread_id_type.hpp>
 #include <pika/functional/function.hpp>
@@ -53,7 +53,8 @@ namespace pika { namespace threads {
             return this;
         }
 
-        static util::internal_allocator<thread_data_stackful> thread_alloc_;
+        static pika::detail::thread_local_pool_allocator<thread_data_stackful>
+            thread_alloc_;
 
     public:
         PIKA_FORCEINLINE coroutine_type::result_type call(
@@ -9,7 +9,7 @@
 #pragma once
 
 #include <pika/config.hpp>
-#include <pika/allocator_support/internal_allocator.hpp>
+#include <pika/allocator_support/thread_local_pool_allocator.hpp>
 #include <pika/assert.hpp>
 #include <pika/coroutines/stackless_coroutine.hpp>
 #include <pika/coroutines/thread_enums.hpp>
@@ -52,7 +52,8 @@ namespace pika { namespace threads {
             return this;
         }
 
-        static util::internal_allocator<thread_data_stackless> thread_alloc_;
+        static pika::detail::thread_local_pool_allocator<thread_data_stackless>
+            thread_alloc_;
 
     public:
         stackless_coroutine_type::result_type call()
@@ -266,6 +266,10 @@ namespace pika { namespace threads {
         mask_type get_used_processing_units() const;
         hwloc_bitmap_ptr get_numa_domain_bitmap() const;
 
+        // Return the NUMA domain of the processing unit the given (local)
+        // worker thread is bound to
+        std::size_t get_numa_domain(std::size_t thread_num) const;
+
         // performance counters
 #if defined(PIKA_HAVE_THREAD_CUMULATIVE_COUNTS)
         virtual std::int64_t get_executed_threads(
@@ -428,6 +432,22 @@ namespace pika { namespace threads {
         {
             return 0;
         }
+
+        virtual std::int64_t get_num_steal_attempts(
+            std::size_t /*thread_num*/, bool /*reset*/)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_num_failed_steals(
+            std::size_t /*thread_num*/, bool /*reset*/)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_steal_time(
+            std::size_t /*thread_num*/, bool /*reset*/)
+        {
+            return 0;
+        }
 #endif
 
         virtual std::int64_t get_thread_count(thread_schedule_state /*state*/,
@@ -7,9 +7,11 @@
 #include <pika/config.hpp>
 #include <pika/assert.hpp>
 #include <pika/execution_base/this_thread.hpp>
+#include <pika/threading_base/detail/timer_wheel.hpp>
 #include <pika/threading_base/scheduler_base.hpp>
 #include <pika/threading_base/scheduler_mode.hpp>
 #include <pika/threading_base/scheduler_state.hpp>
+#include <pika/threading_base/set_thread_state.hpp>
 #include <pika/threading_base/thread_init_data.hpp>
 #include <pika/threading_base/thread_pool_base.hpp>
 #if defined(PIKA_HAVE_SCHEDULER_LOCAL_STORAGE)
@@ -38,7 +40,8 @@ namespace pika { namespace threads { namespace policies {
     scheduler_base::scheduler_base(std::size_t num_threads,
         char const* description, thread_queue_init_parameters thread_queue_init,
         scheduler_mode mode)
-      : suspend_mtxs_(num_threads)
+      : timers_(num_threads)
+      , suspend_mtxs_(num_threads)
       , suspend_conds_(num_threads)
       , pu_mtxs_(num_threads)
       , states_(num_threads)
@@ -56,12 +59,18 @@ namespace pika { namespace threads { namespace policies {
 #if defined(PIKA_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         double max_time = thread_queue_init.max_idle_backoff_time_;
 
-        wait_counts_.resize(num_threads);
+        // the parking slots are neither copyable nor movable
+        wait_counts_ = decltype(wait_counts_)(num_threads);
         for (auto&& data : wait_counts_)
         {
             data.data_.wait_count_ = 0;
             data.data_.max_idle_backoff_time_ = max_time;
         }
+        idle_masks_ = decltype(idle_masks_)((num_threads + 63) / 64);
+        for (auto&& mask : idle_masks_)
+        {
+            mask.data_.store(0, std::memory_order_relaxed);
+        }
 #endif
 
         for (std::size_t i = 0; i != num_threads; ++i)
@@ -83,13 +92,47 @@ namespace pika { namespace threads { namespace policies {
             double exponent = (std::min)(double(data.wait_count_),
                 double(std::numeric_limits<double>::max_exponent - 1));
 
-            std::chrono::milliseconds period(std::lround((std::min)(
-                data.max_idle_backoff_time_, std::pow(2.0, exponent))));
+            std::chrono::steady_clock::duration period =
+                std::chrono::milliseconds(std::lround((std::min)(
+                    data.max_idle_backoff_time_, std::pow(2.0, exponent))));
+
+            // don't sleep past the deadline of the next timer of this worker
+            auto const deadline = get_next_timer_deadline(num_thread);
+            if (deadline != (std::chrono::steady_clock::time_point::max)())
+            {
+                auto const now = std::chrono::steady_clock::now();
+                period = deadline <= now ?
+                    std::chrono::steady_clock::duration(0) :
+                    (std::min)(period, deadline - now);
+            }
 
             ++data.wait_count_;
 
-            std::unique_lock<pu_mutex_type> l(mtx_);
-            if (cond_.wait_for(l, period) == std::cv_status::no_timeout)
+            std::atomic<std::uint64_t>& mask =
+                idle_masks_[num_thread / 64].data_;
+            std::uint64_t const bit = std::uint64_t(1) << (num_thread % 64);
+
+            std::unique_lock<pu_mutex_type> l(data.mtx_);
+
+            // Announce that this thread is about to sleep. Work which was
+            // added before the announcement became visible would not wake us
+            // up, so check the queues once more afterwards. Together with the
+            // fence in do_some_work this guarantees that either we see the
+            // new work or the producer sees our bit.
+            mask.fetch_or(bit);
+            if (get_queue_length(num_thread) != 0)
+            {
+                mask.fetch_and(~bit);
+                return;
+            }
+
+            bool const notified = data.cond_.wait_for(
+                l, period, [&data]() { return data.notified_; });
+
+            data.notified_ = false;
+            mask.fetch_and(~bit);
+
+            if (notified)
             {
                 // reset counter if thread was woken up
                 data.wait_count_ = 0;
@@ -100,17 +143,150 @@ namespace pika { namespace threads { namespace policies {
 #endif
     }
 
+#if defined(PIKA_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+    namespace {
+        inline int count_trailing_zeros(std::uint64_t v) noexcept
+        {
+            PIKA_ASSERT(v != 0);
+#if defined(PIKA_MSVC)
+            unsigned long index = 0;
+            _BitScanForward64(&index, v);
+            return int(index);
+#else
+            return __builtin_ctzll(v);
+#endif
+        }
+    }    // namespace
+
+    // Wake up the sleeping worker closest to (and starting at) num_thread,
+    // returns false if no worker is sleeping.
+    bool scheduler_base::wake_idle_worker(std::size_t num_thread)
+    {
+        std::size_t const num_words = idle_masks_.size();
+        if (num_words == 0)
+        {
+            return false;
+        }
+
+        // work without a specific target: spread the wakeups
+        std::size_t const num_workers = wait_counts_.size();
+        if (num_thread >= num_workers)
+        {
+            num_thread = next_wakeup_.fetch_add(1, std::memory_order_relaxed) %
+                num_workers;
+        }
+
+        std::size_t const first_word = num_thread / 64;
+        std::uint64_t const upper = ~std::uint64_t(0) << (num_thread % 64);
+
+        // the first word is visited twice: its upper bits first, its lower
+        // bits after all other words have been scanned
+        std::size_t word = first_word;
+        for (std::size_t i = 0; i <= num_words; ++i)
+        {
+            std::atomic<std::uint64_t>& mask = idle_masks_[word].data_;
+
+            std::uint64_t bits = mask.load(std::memory_order_relaxed);
+            if (i == 0)
+            {
+                bits &= upper;
+            }
+            else if (i == num_words)
+            {
+                bits &= ~upper;
+            }
+
+            while (bits != 0)
+            {
+                std::uint64_t const bit = bits & (~bits + 1);
+
+                // claim the worker, only one thread may wake it up
+                if (mask.fetch_and(~bit, std::memory_order_acq_rel) & bit)
+                {
+                    std::size_t const target =
+                        word * 64 + std::size_t(count_trailing_zeros(bit));
+                    idle_backoff_data& data = wait_counts_[target].data_;
+
+                    ++data.wakeups_;
+                    {
+                        std::lock_guard<pu_mutex_type> l(data.mtx_);
+                        data.notified_ = true;
+                    }
+                    data.cond_.notify_one();
+                    return true;
+                }
+                bits &= bits - 1;
+            }
+
+            word = word + 1 == num_words ? 0 : word + 1;
+        }
+        return false;
+    }
+
+    void scheduler_base::wake_all_idle_workers()
+    {
+        for (std::size_t i = 0; i != wait_counts_.size(); ++i)
+        {
+            idle_backoff_data& data = wait_counts_[i].data_;
+            {
+                std::lock_guard<pu_mutex_type> l(data.mtx_);
+                data.notified_ = true;
+            }
+            data.cond_.notify_one();
+        }
+    }
+#endif
+
     /// This function gets called by the thread-manager whenever new work
-    /// has been added, allowing the scheduler to reactivate one or more of
+    /// has been added, allowing the scheduler to reactivate one of the
     /// possibly idling OS threads
-    void scheduler_base::do_some_work(std::size_t)
+    void scheduler_base::do_some_work(std::size_t num_thread)
     {
 #if defined(PIKA_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         if (mode_.data_.load(std::memory_order_relaxed) &
             policies::enable_idle_backoff)
         {
-            cond_.notify_all();
+            if (num_thread == std::size_t(-1))
+            {
+                // used while stopping and on mode changes, everybody has to
+                // have a look
+                wake_all_idle_workers();
+                return;
+            }
+
+            // pairs with the announcement in idle_callback, the new work has
+            // to be visible before looking for sleeping workers
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            wake_idle_worker(num_thread);
         }
+#else
+        (void) num_thread;
+#endif
+    }
+
+    std::int64_t scheduler_base::get_idle_wakeup_count(
+        std::size_t num_thread, bool reset)
+    {
+#if defined(PIKA_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        if (num_thread == std::size_t(-1))
+        {
+            std::int64_t count = 0;
+            for (std::size_t i = 0; i != wait_counts_.size(); ++i)
+            {
+                count += get_idle_wakeup_count(i, reset);
+            }
+            return count;
+        }
+
+        PIKA_ASSERT(num_thread < wait_counts_.size());
+        std::atomic<std::int64_t>& wakeups =
+            wait_counts_[num_thread].data_.wakeups_;
+        return reset ? wakeups.exchange(0, std::memory_order_relaxed) :
+                       wakeups.load(std::memory_order_relaxed);
+#else
+        (void) num_thread;
+        (void) reset;
+        return 0;
 #endif
     }
 
@@ -148,6 +324,119 @@ namespace pika { namespace threads { namespace policies {
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    void scheduler_base::add_timer(
+        std::size_t num_thread, threads::detail::timer_entry& entry)
+    {
+        if (num_thread >= timers_.size())
+        {
+            num_thread = 0;
+        }
+
+        timer_queue& q = timers_[num_thread].data_;
+        entry.worker_ = num_thread;
+
+        {
+            std::lock_guard<pika::util::detail::spinlock> l(q.mtx_);
+            q.wheel_.insert(entry);
+            q.count_.store(q.wheel_.size(), std::memory_order_relaxed);
+        }
+
+        // make sure the worker doesn't sleep past the new deadline
+        do_some_work(num_thread);
+    }
+
+    bool scheduler_base::cancel_timer(threads::detail::timer_entry& entry)
+    {
+        PIKA_ASSERT(entry.worker_ < timers_.size());
+        timer_queue& q = timers_[entry.worker_].data_;
+
+        std::lock_guard<pika::util::detail::spinlock> l(q.mtx_);
+        bool const removed = q.wheel_.remove(entry);
+        q.count_.store(q.wheel_.size(), std::memory_order_relaxed);
+        return removed;
+    }
+
+    detail::polling_status scheduler_base::poll_timers(std::size_t num_thread)
+    {
+        PIKA_ASSERT(num_thread < timers_.size());
+        timer_queue& q = timers_[num_thread].data_;
+
+        if (q.count_.load(std::memory_order_relaxed) == 0)
+        {
+            return detail::polling_status::idle;
+        }
+
+        {
+            std::unique_lock<pika::util::detail::spinlock> l(
+                q.mtx_, std::try_to_lock);
+            if (!l.owns_lock())
+            {
+                return detail::polling_status::busy;
+            }
+
+            // Entries waking up a thread may go out of scope as soon as the
+            // lock is released, everything needed to fire them is moved out
+            // while holding it. Entries with a callback stay alive until the
+            // callback has been invoked.
+            q.wheel_.advance(std::chrono::steady_clock::now(),
+                [&](threads::detail::timer_entry& e) {
+                    if (e.callback_ != nullptr)
+                    {
+                        q.expired_.push_back(expired_timer{
+                            {}, e.priority_, e.retry_on_active_, &e});
+                    }
+                    else
+                    {
+                        q.expired_.push_back(expired_timer{PIKA_MOVE(e.thrd_),
+                            e.priority_, e.retry_on_active_, nullptr});
+                    }
+                });
+            q.count_.store(q.wheel_.size(), std::memory_order_relaxed);
+        }
+
+        if (q.expired_.empty())
+        {
+            return detail::polling_status::idle;
+        }
+
+        // Only this worker fires the timers of its queue, so expired_ can be
+        // used without holding the lock.
+        for (expired_timer& t : q.expired_)
+        {
+            if (t.entry_ != nullptr)
+            {
+                t.entry_->callback_(*t.entry_);
+                continue;
+            }
+
+            error_code ec(lightweight);    // do not throw
+            threads::detail::set_thread_state(t.thrd_.noref(),
+                thread_schedule_state::pending, thread_restart_state::timeout,
+                t.priority_,
+                thread_schedule_hint(static_cast<std::int16_t>(num_thread)),
+                t.retry_on_active_, ec);
+        }
+        q.expired_.clear();
+
+        return detail::polling_status::busy;
+    }
+
+    std::chrono::steady_clock::time_point
+    scheduler_base::get_next_timer_deadline(std::size_t num_thread)
+    {
+        PIKA_ASSERT(num_thread < timers_.size());
+        timer_queue& q = timers_[num_thread].data_;
+
+        if (q.count_.load(std::memory_order_relaxed) == 0)
+        {
+            return (std::chrono::steady_clock::time_point::max)();
+        }
+
+        std::lock_guard<pika::util::detail::spinlock> l(q.mtx_);
+        return q.wheel_.next_expiry();
+    }
+
     std::size_t scheduler_base::select_active_pu(
         std::unique_lock<pu_mutex_type>& l, std::size_t num_thread,
         bool allow_fallback)
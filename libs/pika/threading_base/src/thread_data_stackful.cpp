@@ -5,14 +5,14 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <pika/config.hpp>
-#include <pika/allocator_support/internal_allocator.hpp>
+#include <pika/allocator_support/thread_local_pool_allocator.hpp>
 #include <pika/modules/logging.hpp>
 #include <pika/threading_base/thread_data.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace pika { namespace threads {
 
-    util::internal_allocator<thread_data_stackful>
+    pika::detail::thread_local_pool_allocator<thread_data_stackful>
         thread_data_stackful::thread_alloc_;
 
     thread_data_stackful::~thread_data_stackful()
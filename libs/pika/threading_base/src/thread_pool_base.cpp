@@ -64,6 +64,13 @@ namespace pika { namespace threads {
         return topo.cpuset_to_nodeset(used_processing_units);
     }
 
+    std::size_t thread_pool_base::get_numa_domain(std::size_t thread_num) const
+    {
+        auto const& topo = create_topology();
+        return topo.get_numa_node_number(
+            affinity_data_.get_pu_num(thread_num + get_thread_offset()));
+    }
+
     std::size_t thread_pool_base::get_active_os_thread_count() const
     {
         std::size_t active_os_thread_count = 0;
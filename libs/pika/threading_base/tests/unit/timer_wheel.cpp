@@ -0,0 +1,141 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <pika/config.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/threading_base/detail/timer_wheel.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+using pika::threads::detail::timer_entry;
+using pika::threads::detail::timer_wheel;
+
+using clock_type = std::chrono::steady_clock;
+
+std::unique_ptr<timer_entry> make_entry(clock_type::time_point deadline)
+{
+    return std::make_unique<timer_entry>(pika::threads::thread_id_ref_type(),
+        deadline, pika::threads::thread_priority::normal, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_expire_in_order()
+{
+    auto const start = timer_wheel::from_ticks(
+        timer_wheel::to_ticks(clock_type::now()));
+    timer_wheel w(start);
+
+    // deadlines spread over several levels of the wheel
+    std::vector<std::chrono::microseconds> const offsets = {
+        std::chrono::microseconds(0), std::chrono::microseconds(5),
+        std::chrono::microseconds(63), std::chrono::microseconds(64),
+        std::chrono::microseconds(1000), std::chrono::microseconds(4097),
+        std::chrono::microseconds(300000), std::chrono::seconds(10),
+        std::chrono::hours(30)};
+
+    std::vector<std::unique_ptr<timer_entry>> entries;
+    for (auto offset : offsets)
+    {
+        entries.push_back(make_entry(start + offset));
+        w.insert(*entries.back());
+    }
+    PIKA_TEST_EQ(w.size(), offsets.size());
+
+    std::size_t expired = 0;
+    for (auto offset : offsets)
+    {
+        // nothing expires before the deadline
+        w.advance(start + offset - std::chrono::microseconds(1),
+            [&](timer_entry&) { PIKA_TEST(false); });
+        PIKA_TEST(w.next_expiry() <= start + offset);
+
+        // exactly one entry expires at the deadline
+        std::size_t count = w.advance(start + offset, [&](timer_entry& e) {
+            PIKA_TEST(e.deadline_ == start + offset);
+            PIKA_TEST(!e.is_linked());
+        });
+        PIKA_TEST_EQ(count, std::size_t(1));
+        ++expired;
+        PIKA_TEST_EQ(w.size(), offsets.size() - expired);
+    }
+
+    PIKA_TEST(w.empty());
+    PIKA_TEST(w.next_expiry() == (clock_type::time_point::max)());
+}
+
+void test_remove()
+{
+    auto const start = timer_wheel::from_ticks(
+        timer_wheel::to_ticks(clock_type::now()));
+    timer_wheel w(start);
+
+    auto e1 = make_entry(start + std::chrono::milliseconds(1));
+    auto e2 = make_entry(start + std::chrono::milliseconds(2));
+    w.insert(*e1);
+    w.insert(*e2);
+
+    PIKA_TEST(w.remove(*e1));
+    PIKA_TEST(!w.remove(*e1));
+    PIKA_TEST_EQ(w.size(), std::size_t(1));
+
+    std::size_t count =
+        w.advance(start + std::chrono::milliseconds(10), [&](timer_entry& e) {
+            PIKA_TEST_EQ(&e, e2.get());
+        });
+    PIKA_TEST_EQ(count, std::size_t(1));
+    PIKA_TEST(!w.remove(*e2));
+    PIKA_TEST(w.empty());
+}
+
+void test_random_deadlines()
+{
+    auto const start = timer_wheel::from_ticks(
+        timer_wheel::to_ticks(clock_type::now()));
+    timer_wheel w(start);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 10000000);
+
+    std::vector<std::unique_ptr<timer_entry>> entries;
+    for (std::size_t i = 0; i != 10000; ++i)
+    {
+        entries.push_back(
+            make_entry(start + std::chrono::microseconds(dist(gen))));
+        w.insert(*entries.back());
+    }
+
+    // remove every third entry
+    for (std::size_t i = 0; i < entries.size(); i += 3)
+    {
+        PIKA_TEST(w.remove(*entries[i]));
+    }
+
+    std::size_t expired = 0;
+    auto now = start;
+    while (!w.empty())
+    {
+        now += std::chrono::microseconds(dist(gen) / 1000);
+        expired += w.advance(now, [&](timer_entry& e) {
+            PIKA_TEST(e.deadline_ <= now);
+            PIKA_TEST(
+                e.deadline_ > now - std::chrono::microseconds(10000 + 1));
+        });
+    }
+    PIKA_TEST_EQ(expired, entries.size() - (entries.size() + 2) / 3);
+}
+
+int main()
+{
+    test_expire_in_order();
+    test_remove();
+    test_random_deadlines();
+
+    return pika::util::report_errors();
+}
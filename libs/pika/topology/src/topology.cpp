@@ -19,6 +19,9 @@
 #include <pika/util/ios_flags_saver.hpp>
 
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -48,7 +51,9 @@
 #include <sys/syscall.h>
 #endif
 
-#if defined(PIKA_HAVE_UNISTD_H)
+#if defined(PIKA_WINDOWS)
+#include <process.h>
+#elif defined(PIKA_HAVE_UNISTD_H)
 #include <unistd.h>
 #endif
 
@@ -133,6 +138,88 @@ namespace pika { namespace threads { namespace detail {
 #endif
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns the value of the given environment variable, or nullptr if the
+    // variable is not set or empty.
+    char const* get_env(char const* name)
+    {
+        char const* value = std::getenv(name);
+        return (value != nullptr && *value != '\0') ? value : nullptr;
+    }
+
+    hwloc_topology_t init_hwloc_topology()
+    {
+        hwloc_topology_t topo = nullptr;
+        int err = hwloc_topology_init(&topo);
+        if (err != 0)
+        {
+            PIKA_THROW_EXCEPTION(no_success, "topology::topology",
+                "Failed to init hwloc topology");
+        }
+
+#if HWLOC_API_VERSION >= 0x00020000
+#if defined(PIKA_TOPOLOGY_HAVE_ADDITIONAL_HWLOC_TESTING)
+        // Enable HWLOC filtering that makes it report no cores. This is purely
+        // an option allowing to test whether things work properly on systems
+        // that may not report cores in the topology at all (e.g. FreeBSD).
+        err = hwloc_topology_set_type_filter(
+            topo, HWLOC_OBJ_CORE, HWLOC_TYPE_FILTER_KEEP_NONE);
+        if (err != 0)
+        {
+            hwloc_topology_destroy(topo);
+            PIKA_THROW_EXCEPTION(no_success, "topology::topology",
+                "Failed to set core filter for hwloc topology");
+        }
+#endif
+#endif
+
+        return topo;
+    }
+
+    // Loads the topology from an XML file previously exported by
+    // export_hwloc_topology_xml. Returns false if the file can't be read.
+    bool load_hwloc_topology_xml(hwloc_topology_t topo, char const* xml_file)
+    {
+        if (!std::ifstream(xml_file))
+        {
+            return false;
+        }
+
+        // hwloc assumes that a topology loaded from XML describes some other
+        // machine and turns binding into a no-op, unless told otherwise.
+        unsigned long flags = HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM;
+#if HWLOC_API_VERSION >= 0x00020000
+        // Restrict the topology to the resources available to this process,
+        // which may be fewer than those of the process which exported it.
+        flags |= HWLOC_TOPOLOGY_FLAG_THISSYSTEM_ALLOWED_RESOURCES;
+#endif
+
+        return hwloc_topology_set_xml(topo, xml_file) == 0 &&
+            hwloc_topology_set_flags(topo, flags) == 0 &&
+            hwloc_topology_load(topo) == 0;
+    }
+
+    // Exports the topology to the given XML file. Failing to do so is not an
+    // error, the topology is simply discovered again by the next process.
+    void export_hwloc_topology_xml(hwloc_topology_t topo, char const* xml_file)
+    {
+        // Many processes may be started at the same time on a node. Each of
+        // them exports to its own file first, and then atomically moves it
+        // into place to not expose partially written files to the others.
+        std::string const tmp_file =
+            pika::util::format("{}.{}", xml_file, getpid());
+
+#if HWLOC_API_VERSION >= 0x00020000
+        int err = hwloc_topology_export_xml(topo, tmp_file.c_str(), 0);
+#else
+        int err = hwloc_topology_export_xml(topo, tmp_file.c_str());
+#endif
+        if (err != 0 || std::rename(tmp_file.c_str(), xml_file) != 0)
+        {
+            std::remove(tmp_file.c_str());
+        }
+    }
+
 }}}    // namespace pika::threads::detail
 
 std::size_t pika::threads::topology::memory_page_size_ =
@@ -207,33 +294,46 @@ namespace pika { namespace threads {
       , use_pus_as_cores_(false)
       , machine_affinity_mask_(0)
     {    // {{{
-        int err = hwloc_topology_init(&topo);
-        if (err != 0)
-        {
-            PIKA_THROW_EXCEPTION(no_success, "topology::topology",
-                "Failed to init hwloc topology");
-        }
+        // The topology is described by a synthetic description, or read from
+        // an XML file cached from a previous run, if given.
+        char const* const synthetic =
+            detail::get_env("PIKA_TOPOLOGY_SYNTHETIC");
+        char const* const xml_file = detail::get_env("PIKA_TOPOLOGY_XML_FILE");
 
-#if HWLOC_API_VERSION >= 0x00020000
-#if defined(PIKA_TOPOLOGY_HAVE_ADDITIONAL_HWLOC_TESTING)
-        // Enable HWLOC filtering that makes it report no cores. This is purely
-        // an option allowing to test whether things work properly on systems
-        // that may not report cores in the topology at all (e.g. FreeBSD).
-        err = hwloc_topology_set_type_filter(
-            topo, HWLOC_OBJ_CORE, HWLOC_TYPE_FILTER_KEEP_NONE);
-        if (err != 0)
+        topo = detail::init_hwloc_topology();
+
+        if (synthetic != nullptr)
         {
-            PIKA_THROW_EXCEPTION(no_success, "topology::topology",
-                "Failed to set core filter for hwloc topology");
+            if (hwloc_topology_set_synthetic(topo, synthetic) != 0 ||
+                hwloc_topology_load(topo) != 0)
+            {
+                PIKA_THROW_EXCEPTION(no_success, "topology::topology",
+                    "Failed to load synthetic hwloc topology \"{}\"",
+                    synthetic);
+            }
         }
-#endif
-#endif
-
-        err = hwloc_topology_load(topo);
-        if (err != 0)
+        else if (xml_file == nullptr ||
+            !detail::load_hwloc_topology_xml(topo, xml_file))
         {
-            PIKA_THROW_EXCEPTION(no_success, "topology::topology",
-                "Failed to load hwloc topology");
+            if (xml_file != nullptr)
+            {
+                // The file is missing or can't be read, a new one is
+                // exported below. A topology which failed to load is not
+                // necessarily reusable, start over.
+                hwloc_topology_destroy(topo);
+                topo = detail::init_hwloc_topology();
+            }
+
+            if (hwloc_topology_load(topo) != 0)
+            {
+                PIKA_THROW_EXCEPTION(no_success, "topology::topology",
+                    "Failed to load hwloc topology");
+            }
+
+            if (xml_file != nullptr)
+            {
+                detail::export_hwloc_topology_xml(topo, xml_file);
+            }
         }
 
         init_num_of_pus();
@@ -0,0 +1,159 @@
+//  Copyright (c) 2021 ETH Zurich
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the fixed and adaptive chunking policies of bulk on
+// the thread_pool_scheduler for loop bodies with uniform and skewed costs:
+//
+//   uniform: every iteration takes the same time
+//   linear:  the cost of an iteration grows linearly with its index
+//   tail:    the last tenth of the iterations is ten times as expensive
+//   spikes:  every 101st iteration is a hundred times as expensive
+
+#include <pika/config.hpp>
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+#include <pika/execution.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/format.hpp>
+#include <pika/modules/program_options.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/modules/timing.hpp>
+#include <pika/runtime.hpp>
+
+#include "worker_timed.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace ex = pika::execution::experimental;
+
+///////////////////////////////////////////////////////////////////////////////
+enum class distribution
+{
+    uniform,
+    linear,
+    tail,
+    spikes
+};
+
+char const* get_name(distribution d)
+{
+    switch (d)
+    {
+    case distribution::uniform:
+        return "uniform";
+    case distribution::linear:
+        return "linear";
+    case distribution::tail:
+        return "tail";
+    case distribution::spikes:
+        return "spikes";
+    }
+    return "unknown";
+}
+
+// The distributions are scaled such that all of them take roughly the same
+// total time.
+std::uint64_t get_delay(distribution d, std::uint64_t delay, std::size_t i,
+    std::size_t n) noexcept
+{
+    switch (d)
+    {
+    case distribution::uniform:
+        return delay;
+    case distribution::linear:
+        return (2 * delay * i) / n;
+    case distribution::tail:
+        return i >= n - n / 10 ? (100 * delay) / 19 : (10 * delay) / 19;
+    case distribution::spikes:
+        return i % 101 == 0 ? 50 * delay : delay / 2;
+    }
+    return delay;
+}
+
+double run(ex::bulk_chunking chunking, distribution d, std::size_t n,
+    std::uint64_t delay, std::size_t repetitions)
+{
+    auto sched =
+        ex::with_bulk_chunking(ex::thread_pool_scheduler{}, chunking);
+
+    pika::chrono::high_resolution_timer t;
+    for (std::size_t r = 0; r != repetitions; ++r)
+    {
+        ex::schedule(sched) | ex::bulk(n, [=](std::size_t i) {
+            worker_timed(get_delay(d, delay, i, n));
+        }) | ex::sync_wait();
+    }
+    return t.elapsed() / double(repetitions);
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    std::size_t const n = vm["iterations"].as<std::size_t>();
+    std::uint64_t const delay = vm["delay"].as<std::uint64_t>();
+    std::size_t const repetitions = vm["repetitions"].as<std::size_t>();
+    bool const header = !vm.count("no-header");
+
+    if (header)
+    {
+        std::cout << "OS_Threads,Iterations,Delay[ns],Distribution,"
+                     "Fixed[s],Adaptive[s],Speedup"
+                  << std::endl;
+    }
+
+    for (distribution d : {distribution::uniform, distribution::linear,
+             distribution::tail, distribution::spikes})
+    {
+        double const fixed =
+            run(ex::bulk_chunking::fixed, d, n, delay, repetitions);
+        double const adaptive =
+            run(ex::bulk_chunking::adaptive, d, n, delay, repetitions);
+
+        pika::util::format_to(std::cout,
+            "{:10},{:10},{:10},{:10},{:10.12},{:10.12},{:10.4}\n",
+            pika::get_num_worker_threads(), n, delay, get_name(d), fixed,
+            adaptive, fixed / adaptive)
+            << std::flush;
+
+        std::string const name = get_name(d);
+        pika::util::print_cdash_timing(
+            ("BulkChunkingFixed_" + name).c_str(), fixed);
+        pika::util::print_cdash_timing(
+            ("BulkChunkingAdaptive_" + name).c_str(), adaptive);
+    }
+
+    return pika::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    namespace po = pika::program_options;
+
+    // Configure application-specific options.
+    po::options_description cmdline(
+        "usage: " PIKA_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("iterations,i", po::value<std::size_t>()->default_value(100000),
+         "number of iterations of each bulk operation (default: 100000)")
+        ("delay,d", po::value<std::uint64_t>()->default_value(1000),
+         "average time spent in each iteration, in nanoseconds "
+         "(default: 1000)")
+        ("repetitions,r", po::value<std::size_t>()->default_value(10),
+         "number of times to repeat each bulk operation (default: 10)")
+        ("no-header,n", "do not print out the csv header row");
+    // clang-format on
+
+    // Initialize and run pika.
+    pika::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    return pika::init(pika_main, argc, argv, init_args);
+}
+#endif
@@ -158,6 +158,32 @@ void measure_function_futures_wait_all(
     print_stats("async", "WaitAll", exec_name(exec), count, duration, csv);
 }
 
+// Time attaching chains of synchronous continuations to futures which are not
+// ready yet, and making them ready
+void measure_function_futures_then_chain(std::uint64_t count, bool csv)
+{
+    constexpr std::uint64_t chain_length = 8;
+
+    // start the clock
+    high_resolution_timer walltime;
+    for (std::uint64_t i = 0; i < count; i += chain_length)
+    {
+        pika::lcos::local::promise<double> p;
+        future<double> f = p.get_future();
+        for (std::uint64_t j = 0; j != chain_length; ++j)
+        {
+            f = f.then(pika::launch::sync,
+                [](future<double>&& r) { return r.get() + null_function(); });
+        }
+        p.set_value(0.0);
+        global_scratch += f.get();
+    }
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+    print_stats("then", "Chain", "sync", count, duration, csv);
+}
+
 template <typename Executor>
 void measure_function_futures_limiting_executor(
     std::uint64_t count, bool csv, Executor exec)
@@ -482,6 +508,7 @@ int pika_main(variables_map& vm)
                 measure_function_futures_limiting_executor(count, csv, par);
                 measure_function_futures_wait_each(count, csv, par);
                 measure_function_futures_wait_all(count, csv, par);
+                measure_function_futures_then_chain(count, csv);
                 measure_function_futures_sliding_semaphore(count, csv, par);
                 measure_function_futures_for_loop(count, csv, par);
                 measure_function_futures_for_loop(count, csv, par_agg);
@@ -0,0 +1,136 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark lets all worker threads of the default pool enter idle
+// backoff and then schedules a single task onto one of them. It measures the
+// time it takes for the task to start running (the wakeup latency) and counts
+// how many worker threads were woken up on its behalf. Every wakeup besides
+// the first one is a wasted wakeup.
+
+#include <pika/config.hpp>
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+#include <pika/execution.hpp>
+#include <pika/future.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/format.hpp>
+#include <pika/modules/program_options.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/modules/timing.hpp>
+#include <pika/runtime.hpp>
+#include <pika/thread.hpp>
+#include <pika/threading_base/scheduler_base.hpp>
+#include <pika/threading_base/thread_pool_base.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int pika_main(pika::program_options::variables_map& vm)
+{
+    std::size_t const num_samples = vm["samples"].as<std::size_t>();
+    std::chrono::milliseconds const idle(vm["idle"].as<std::uint64_t>());
+    bool const header = !vm.count("no-header");
+
+    pika::threads::policies::scheduler_base* scheduler =
+        pika::resource::get_thread_pool(0).get_scheduler();
+    std::size_t const num_threads = pika::get_num_worker_threads();
+
+    if (header)
+    {
+        std::cout << "OS_Threads,Samples,Idle[ms],Mean Latency[s],"
+                     "Median Latency[s],Max Latency[s],"
+                     "Wakeups/Task,Wasted Wakeups/Task"
+                  << std::endl;
+    }
+
+    std::vector<double> latency;
+    latency.reserve(num_samples);
+    std::int64_t wakeups = 0;
+    std::int64_t wasted = 0;
+
+    for (std::size_t k = 0; k != num_samples; ++k)
+    {
+        // give all workers the chance to go to sleep
+        pika::this_thread::sleep_for(idle);
+
+        // target a worker other than the one running this thread if possible
+        std::size_t const target = num_threads == 1 ?
+            0 :
+            (pika::get_worker_thread_num() + 1 + k % (num_threads - 1)) %
+                num_threads;
+        pika::execution::parallel_executor exec{
+            pika::threads::thread_schedule_hint(std::int16_t(target))};
+
+        std::int64_t const before = scheduler->get_idle_wakeup_count(-1);
+        auto const start = std::chrono::steady_clock::now();
+
+        auto result = pika::async(exec, [&]() {
+            return std::make_pair(std::chrono::steady_clock::now(),
+                scheduler->get_idle_wakeup_count(-1));
+        }).get();
+
+        std::int64_t const woken = result.second - before;
+        latency.push_back(
+            std::chrono::duration<double>(result.first - start).count());
+        wakeups += woken;
+        wasted += (std::max)(woken - 1, std::int64_t(0));
+    }
+
+    std::sort(latency.begin(), latency.end());
+    double mean = 0;
+    for (double l : latency)
+    {
+        mean += l;
+    }
+    mean /= double(num_samples);
+
+    double const median = latency[num_samples / 2];
+    double const max = latency.back();
+
+    pika::util::format_to(std::cout,
+        "{:10},{:10},{:10},{:10.12},{:10.12},{:10.12},{:10.12},{:10.12}\n",
+        num_threads, num_samples, idle.count(), mean, median, max,
+        double(wakeups) / double(num_samples),
+        double(wasted) / double(num_samples))
+        << std::flush;
+
+    pika::util::print_cdash_timing("IdleWakeupLatencyMean", mean);
+    pika::util::print_cdash_timing("IdleWakeupLatencyMax", max);
+
+    return pika::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    namespace po = pika::program_options;
+
+    // Configure application-specific options.
+    po::options_description cmdline(
+        "usage: " PIKA_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("samples,s", po::value<std::size_t>()->default_value(100),
+         "number of tasks to wake up idle workers with (default: 100)")
+        ("idle,i", po::value<std::uint64_t>()->default_value(20),
+         "time to let the workers idle before each task, in milliseconds "
+         "(default: 20)")
+        ("no-header,n", "do not print out the csv header row");
+    // clang-format on
+
+    // Initialize and run pika.
+    pika::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    return pika::init(pika_main, argc, argv, init_args);
+}
+#endif
@@ -16,6 +16,7 @@
 #include <pika/execution.hpp>
 #include <pika/init.hpp>
 #include <pika/modules/format.hpp>
+#include <pika/parallel/util/numa_allocator.hpp>
 #include <pika/thread.hpp>
 #include <pika/type_support/unused.hpp>
 #include <pika/version.hpp>
@@ -24,6 +25,7 @@
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -316,12 +318,16 @@ template <typename Policy>
 std::vector<std::vector<double>> run_benchmark(std::size_t warmup_iterations,
     std::size_t iterations, std::size_t size, Policy&& policy)
 {
-    // Allocate our data
-    using vector_type = std::vector<STREAM_TYPE>;
+    // Allocate our data, the pages are placed on the NUMA domains of the
+    // threads which will operate on them using the given policy
+    using allocator_type = pika::parallel::util::numa_allocator<STREAM_TYPE,
+        std::decay_t<Policy>>;
+    using vector_type = std::vector<STREAM_TYPE, allocator_type>;
 
-    vector_type a(size);
-    vector_type b(size);
-    vector_type c(size);
+    allocator_type alloc(policy);
+    vector_type a(size, alloc);
+    vector_type b(size, alloc);
+    vector_type c(size, alloc);
 
     // Initialize arrays
     pika::fill(policy, a.begin(), a.end(), 1.0);
@@ -509,7 +515,7 @@ int pika_main(pika::program_options::variables_map& vm)
 
     if (executor == 0)
     {
-        // Default parallel policy with serial allocator.
+        // Default parallel policy with NUMA aware allocator.
         timing = run_benchmark<>(
             warmup_iterations, iterations, vector_size, pika::execution::par);
     }
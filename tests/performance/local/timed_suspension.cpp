@@ -0,0 +1,130 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark suspends a large number of pika threads concurrently using
+// pika::this_thread::sleep_for and measures how late each of them is woken
+// up by the timer wheel of the scheduler.
+
+#include <pika/config.hpp>
+#if !defined(PIKA_COMPUTE_DEVICE_CODE)
+#include <pika/future.hpp>
+#include <pika/init.hpp>
+#include <pika/modules/format.hpp>
+#include <pika/modules/program_options.hpp>
+#include <pika/modules/testing.hpp>
+#include <pika/modules/timing.hpp>
+#include <pika/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the time (in seconds) the thread woke up after its deadline.
+double sleep_task(std::chrono::microseconds delay)
+{
+    auto const start = std::chrono::steady_clock::now();
+    pika::this_thread::sleep_for(delay);
+    auto const stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(stop - start - delay).count();
+}
+
+int pika_main(pika::program_options::variables_map& vm)
+{
+    std::size_t const num_tasks = vm["tasks"].as<std::size_t>();
+    std::size_t const num_samples = vm["samples"].as<std::size_t>();
+    std::chrono::microseconds const delay(vm["delay"].as<std::uint64_t>());
+    bool const header = !vm.count("no-header");
+
+    if (header)
+    {
+        std::cout << "Tasks,Delay[us],Total Walltime[s],Mean Jitter[s],"
+                     "Median Jitter[s],99th Percentile Jitter[s],"
+                     "Max Jitter[s]"
+                  << std::endl;
+    }
+
+    std::vector<pika::future<double>> tasks;
+    std::vector<double> jitter;
+    tasks.reserve(num_tasks);
+    jitter.reserve(num_tasks);
+
+    for (std::size_t k = 0; k != num_samples; ++k)
+    {
+        tasks.clear();
+        jitter.clear();
+
+        pika::chrono::high_resolution_timer t;
+        for (std::size_t i = 0; i != num_tasks; ++i)
+        {
+            tasks.push_back(pika::async(&sleep_task, delay));
+        }
+        pika::wait_all(tasks);
+        double const elapsed = t.elapsed();
+
+        for (auto& f : tasks)
+        {
+            jitter.push_back(f.get());
+        }
+        std::sort(jitter.begin(), jitter.end());
+
+        double mean = 0;
+        for (double j : jitter)
+        {
+            mean += j;
+        }
+        mean /= double(num_tasks);
+
+        double const median = jitter[num_tasks / 2];
+        double const p99 = jitter[(num_tasks * 99) / 100];
+        double const max = jitter.back();
+
+        // no thread may wake up before its deadline has expired
+        PIKA_TEST_LTE(0.0, jitter.front());
+
+        pika::util::format_to(std::cout,
+            "{:10},{:10},{:10.12},{:10.12},{:10.12},{:10.12},{:10.12}\n",
+            num_tasks, delay.count(), elapsed, mean, median, p99, max)
+            << std::flush;
+
+        pika::util::print_cdash_timing("TimedSuspensionWalltime", elapsed);
+        pika::util::print_cdash_timing("TimedSuspensionJitterP99", p99);
+    }
+
+    return pika::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    namespace po = pika::program_options;
+
+    // Configure application-specific options.
+    po::options_description cmdline(
+        "usage: " PIKA_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("tasks", po::value<std::size_t>()->default_value(100000),
+         "number of pika threads to suspend concurrently (default: 100000)")
+        ("samples,s", po::value<std::size_t>()->default_value(1),
+         "number of times to repeat the benchmark (default: 1)")
+        ("delay,d", po::value<std::uint64_t>()->default_value(10000),
+         "duration each thread sleeps for, in microseconds (default: 10000)")
+        ("no-header,n", "do not print out the csv header row");
+    // clang-format on
+
+    // Initialize and run pika.
+    pika::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    return pika::init(pika_main, argc, argv, init_args);
+}
+#endif
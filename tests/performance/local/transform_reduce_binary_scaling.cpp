@@ -9,6 +9,7 @@
 #include <pika/execution.hpp>
 #include <pika/init.hpp>
 #include <pika/numeric.hpp>
+#include <pika/parallel/datapar.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -48,17 +49,73 @@ float measure_inner_product(ExPolicy&& policy, std::vector<float> const& data1,
 }
 
 template <typename ExPolicy>
-std::int64_t measure_inner_product(int count, ExPolicy&& policy,
+float measure_norm(ExPolicy&& policy, std::vector<float> const& data1,
+    std::vector<float> const&)
+{
+    return pika::transform_reduce(policy, std::begin(data1), std::end(data1),
+        0.0f, ::plus(), [](auto const& v) { return v * v; });
+}
+
+template <typename ExPolicy>
+float measure_sum(ExPolicy&& policy, std::vector<float> const& data1,
+    std::vector<float> const&)
+{
+    return pika::reduce(
+        policy, std::begin(data1), std::end(data1), 0.0f, ::plus());
+}
+
+// keeps the compiler from optimizing away the sequential reductions
+volatile float result = 0.0f;
+
+template <typename ExPolicy, typename F>
+std::int64_t measure(int count, ExPolicy&& policy, F&& f,
     std::vector<float> const& data1, std::vector<float> const& data2)
 {
     std::int64_t start = pika::chrono::high_resolution_clock::now();
 
     for (int i = 0; i != count; ++i)
-        measure_inner_product(policy, data1, data2);
+        result = f(policy, data1, data2);
 
     return (pika::chrono::high_resolution_clock::now() - start) / count;
 }
 
+template <typename F>
+void measure_all(char const* name, int test_count, bool csvoutput, F&& f,
+    std::vector<float> const& data1, std::vector<float> const& data2)
+{
+    using namespace pika::execution;
+
+    // warm up caches
+    f(par, data1, data2);
+
+    // do measurements
+    std::uint64_t time_seq = measure(test_count, seq, f, data1, data2);
+    std::uint64_t time_simd = measure(test_count, simd, f, data1, data2);
+    std::uint64_t time_par = measure(test_count, par, f, data1, data2);
+    std::uint64_t time_par_simd =
+        measure(test_count, par_simd, f, data1, data2);
+
+    if (csvoutput)
+    {
+        std::cout << name << "," << time_seq / 1e9 << "," << time_simd / 1e9
+                  << "," << time_par / 1e9 << "," << time_par_simd / 1e9
+                  << "\n"
+                  << std::flush;
+    }
+    else
+    {
+        std::cout << name << "(execution::seq): " << std::right
+                  << std::setw(15) << time_seq / 1e9 << "\n"
+                  << name << "(execution::simd): " << std::right
+                  << std::setw(15) << time_simd / 1e9 << "\n"
+                  << name << "(execution::par): " << std::right
+                  << std::setw(15) << time_par / 1e9 << "\n"
+                  << name << "(execution::par_simd): " << std::right
+                  << std::setw(15) << time_par_simd / 1e9 << "\n"
+                  << std::flush;
+    }
+}
+
 int pika_main(pika::program_options::variables_map& vm)
 {
     unsigned int seed = (unsigned int) std::random_device{}();
@@ -84,29 +141,21 @@ int pika_main(pika::program_options::variables_map& vm)
     }
     else
     {
-        // warm up caches
-        measure_inner_product(pika::execution::par, data1, data2);
-
-        // do measurements
-        std::uint64_t tr_time_datapar = measure_inner_product(
-            test_count, pika::execution::par_simd, data1, data2);
-        std::uint64_t tr_time_par = measure_inner_product(
-            test_count, pika::execution::par, data1, data2);
-
-        if (csvoutput)
-        {
-            std::cout << "," << tr_time_par / 1e9 << ","
-                      << tr_time_datapar / 1e9 << "\n"
-                      << std::flush;
-        }
-        else
-        {
-            std::cout << "transform_reduce(execution::par): " << std::right
-                      << std::setw(15) << tr_time_par / 1e9 << "\n"
-                      << "transform_reduce(datapar): " << std::right
-                      << std::setw(15) << tr_time_datapar / 1e9 << "\n"
-                      << std::flush;
-        }
+        measure_all("inner_product", test_count, csvoutput,
+            [](auto const& policy, auto const& data1, auto const& data2) {
+                return measure_inner_product(policy, data1, data2);
+            },
+            data1, data2);
+        measure_all("norm", test_count, csvoutput,
+            [](auto const& policy, auto const& data1, auto const& data2) {
+                return measure_norm(policy, data1, data2);
+            },
+            data1, data2);
+        measure_all("sum", test_count, csvoutput,
+            [](auto const& policy, auto const& data1, auto const& data2) {
+                return measure_sum(policy, data1, data2);
+            },
+            data1, data2);
     }
 
     return pika::finalize();